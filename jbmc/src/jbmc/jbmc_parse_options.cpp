@@ -734,6 +734,10 @@ void jbmc_parse_optionst::process_goto_function(
   const abstract_goto_modelt &model,
   const optionst &options)
 {
+  trace_spant span(
+    "process_goto_function " + id2string(function.get_function_id()),
+    "process_goto_program");
+
   journalling_symbol_tablet &symbol_table = function.get_symbol_table();
   namespacet ns(symbol_table);
   goto_functionst::goto_functiont &goto_function = function.get_goto_function();
@@ -881,8 +885,13 @@ bool jbmc_parse_optionst::process_goto_functions(
   if(using_symex_driven_loading)
     return false;
 
+  trace_spant span("process_goto_functions");
+
   // remove catch and throw
-  remove_exceptions(goto_model, *class_hierarchy.get(), ui_message_handler);
+  {
+    trace_spant remove_span("remove_exceptions");
+    remove_exceptions(goto_model, *class_hierarchy.get(), ui_message_handler);
+  }
 
   // instrument library preconditions
   instrument_preconditions(goto_model);
@@ -929,6 +938,7 @@ bool jbmc_parse_optionst::process_goto_functions(
 
     log.status() << "Performing a forwards-backwards reachability slice"
                  << messaget::eom;
+    trace_spant slice_span("reachability_slicer");
     if(cmdline.isset("property"))
       reachability_slicer(goto_model, cmdline.get_values("property"), true);
     else
@@ -938,6 +948,7 @@ bool jbmc_parse_optionst::process_goto_functions(
   if(cmdline.isset("reachability-slice"))
   {
     log.status() << "Performing a reachability slice" << messaget::eom;
+    trace_spant slice_span("reachability_slicer");
     if(cmdline.isset("property"))
       reachability_slicer(goto_model, cmdline.get_values("property"));
     else
@@ -948,6 +959,7 @@ bool jbmc_parse_optionst::process_goto_functions(
   if(cmdline.isset("full-slice"))
   {
     log.status() << "Performing a full slice" << messaget::eom;
+    trace_spant slice_span("full_slicer");
     if(cmdline.isset("property"))
       property_slicer(goto_model, cmdline.get_values("property"));
     else
@@ -957,6 +969,8 @@ bool jbmc_parse_optionst::process_goto_functions(
   // remove any skips introduced
   remove_skip(goto_model);
 
+  memory_report().snapshot("process_goto_functions");
+
   return false;
 }
 
@@ -1097,6 +1111,7 @@ void jbmc_parse_optionst::help()
     HELP_FLUSH
     " --verbosity #                verbosity level\n"
     HELP_TIMESTAMP
+    HELP_RUN_REPORTS
     "\n";
   // clang-format on
 }
@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_JBMC_JBMC_PARSE_OPTIONS_H
 
 #include <util/parse_options.h>
+#include <util/run_reports.h>
 #include <util/timestamper.h>
 #include <util/ui_message.h>
 #include <util/validation_interface.h>
@@ -70,6 +71,7 @@ class optionst;
   "(version)" \
   "(symex-coverage-report):" \
   OPT_TIMESTAMP \
+  OPT_RUN_REPORTS \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)" \
   "(ppc-macos)" \
   "(arrays-uf-always)(arrays-uf-never)" \
@@ -29,7 +29,7 @@ Author: Diffblue Ltd.
 #include <java-testing-utils/load_java_class.h>
 
 void validate_nondet_method_removed(
-  std::list<goto_programt::instructiont> instructions)
+  const goto_programt::instructionst &instructions)
 {
   bool method_removed = true, replacement_nondet_exists = false;
 
@@ -93,7 +93,7 @@ void validate_nondet_method_removed(
 }
 
 void validate_nondets_converted(
-  std::list<goto_programt::instructiont> instructions)
+  const goto_programt::instructionst &instructions)
 {
   bool nondet_exists = false;
   bool allocate_exists = false;
@@ -0,0 +1,15 @@
+int nondet_int();
+
+int main()
+{
+  int a[4];
+  int x = nondet_int();
+  __CPROVER_assume(x >= 0 && x < 4);
+
+  for(int i = 0; i < 4; ++i)
+    a[i] = (x + 1) * (x + 1);
+
+  __CPROVER_assert(a[x] == (x + 1) * (x + 1), "same value");
+  __CPROVER_assert(a[x] != 0, "non-zero");
+  return 0;
+}
@@ -0,0 +1,20 @@
+int a[4];
+
+int get(int i)
+{
+  return a[i];
+}
+
+int divide(int x, int y)
+{
+  return x / y;
+}
+
+int main()
+{
+  int i, y;
+  __CPROVER_assume(i >= 0 && i < 4);
+  int r = get(i);
+  __CPROVER_assert(r == 0, "array is zero-initialized");
+  return divide(r, y);
+}
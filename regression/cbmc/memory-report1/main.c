@@ -0,0 +1,12 @@
+int main()
+{
+  int x;
+  int y = x + 1;
+
+  for(int i = 0; i < 3; ++i)
+    y += i;
+
+  __CPROVER_assert(y == x + 4, "sum");
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+int main()
+{
+  int x, y;
+  int n = 0;
+
+  if(x)
+    n++;
+  if(y)
+    n++;
+  if(x && y)
+    __CPROVER_assert(n != 2, "both incremented");
+
+  return 0;
+}
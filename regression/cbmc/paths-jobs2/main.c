@@ -0,0 +1,23 @@
+int main()
+{
+  int x, y, z;
+  int r = 0;
+
+  if(x > 0)
+    r += 1;
+  if(y > 0)
+    r += 2;
+  if(z > 0)
+    r += 4;
+
+  __CPROVER_assert(r != 7, "all branches taken");
+  __CPROVER_assert(r < 8, "sum is bounded");
+
+  if(r == 3)
+  {
+    __CPROVER_assert(z <= 0, "z is not positive if r is three");
+    __CPROVER_assert(x > y, "x is larger");
+  }
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+void check(int x)
+{
+  __CPROVER_assert(x != 42, "x is not 42");
+}
+
+int main()
+{
+  int a, b, x;
+
+  if(a)
+  {
+    if(b)
+      x = 1;
+    else
+      x = 2;
+  }
+  else
+    check(x);
+
+  return 0;
+}
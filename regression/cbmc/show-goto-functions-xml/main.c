@@ -0,0 +1,7 @@
+int global = 42;
+
+int main()
+{
+  int local = global;
+  return local;
+}
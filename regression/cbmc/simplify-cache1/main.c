@@ -0,0 +1,11 @@
+int main()
+{
+  int x;
+  int sum = 0;
+
+  for(int i = 0; i < 10; ++i)
+    sum += (x + 0) * 1 - x;
+
+  __CPROVER_assert(sum == 0, "sum is zero");
+  return 0;
+}
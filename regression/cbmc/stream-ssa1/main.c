@@ -0,0 +1,25 @@
+#include <assert.h>
+
+int nondet_int();
+
+int square(int x)
+{
+  return x * x;
+}
+
+int main()
+{
+  int x = nondet_int();
+  __CPROVER_assume(x > 0 && x < 100);
+
+  int y = square(x);
+  assert(y > 0);
+  assert(y != 49);
+
+  int z = 0;
+  for(int i = 0; i < 5; i++)
+    z += i;
+  assert(z == 10);
+
+  return 0;
+}
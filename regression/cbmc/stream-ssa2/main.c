@@ -0,0 +1,20 @@
+#include <assert.h>
+#include <pthread.h>
+
+int shared;
+
+void *worker(void *arg)
+{
+  shared = 2;
+  return 0;
+}
+
+int main()
+{
+  pthread_t thread;
+  pthread_create(&thread, 0, worker, 0);
+  shared = 1;
+  pthread_join(thread, 0);
+  assert(shared == 2);
+  return 0;
+}
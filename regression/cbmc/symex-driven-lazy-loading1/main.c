@@ -0,0 +1,22 @@
+#include <assert.h>
+#include <stdlib.h>
+
+int unused(int (*f)(int))
+{
+  // never entered, hence the call through a function pointer is fine
+  return f(1);
+}
+
+int get(int *a, int i)
+{
+  return a[i];
+}
+
+int main()
+{
+  int *a = malloc(sizeof(int) * 4);
+  a[1] = 2;
+  assert(get(a, 1) == 2);
+  assert(get(a, 0) == 0);
+  return 0;
+}
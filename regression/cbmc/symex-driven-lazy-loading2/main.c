@@ -0,0 +1,10 @@
+int f(int x)
+{
+  return x;
+}
+
+int main()
+{
+  int (*p)(int) = f;
+  return p(1);
+}
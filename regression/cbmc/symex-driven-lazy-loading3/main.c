@@ -0,0 +1,9 @@
+int main()
+{
+#ifdef _MSC_VER
+  __asm { mfence }
+#else
+  __asm__("mfence");
+#endif
+  return 0;
+}
@@ -0,0 +1,17 @@
+int f(int x)
+{
+  return x + 1;
+}
+
+int g(int x)
+{
+  return x - 1;
+}
+
+int main(int argc, char *argv[])
+{
+  int (*fp)(int) = argc > 1 ? f : g;
+  int y = fp(argc);
+  __CPROVER_assert(y == argc + 1 || y == argc - 1, "called f or g");
+  return 0;
+}
@@ -0,0 +1,14 @@
+int main()
+{
+  int x = 1;
+  int y = 2;
+  int z;
+
+  for(int i = 0; i < 10; ++i)
+  {
+    z = x + y;
+    __CPROVER_assert(z == 3, "constant sum");
+  }
+
+  return 0;
+}
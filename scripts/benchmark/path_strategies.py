@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+
+"""
+Compare path exploration strategies by the time cbmc takes to find the first
+counterexample with --paths <strategy> --stop-on-fail.
+
+Each test is a directory in the style of regression/cbmc-incr, holding a
+test.desc whose second line names the source file and whose third line gives
+the options. The incremental unwinding options of those tests are mapped to
+their non-incremental counterparts: --unwind-max N becomes --unwind N, and
+options only meaningful for incremental unwinding are dropped.
+
+Results are printed as CSV with one line per test and strategy.
+"""
+
+from __future__ import print_function
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+import time
+
+# options of incremental unwinding that have no meaning otherwise
+DROPPED_OPTIONS = {'--unwind-min': 1, '--stop-when-unsat': 0,
+                   '--incremental': 0, '--incremental-check': 1}
+
+
+def test_options(desc_file):
+    """Return the source file and the translated options of a test.desc"""
+    with open(desc_file) as desc:
+        lines = desc.read().splitlines()
+    source = lines[1].strip()
+    words = lines[2].split() if len(lines) > 2 else []
+
+    options = []
+    i = 0
+    while i < len(words):
+        word = words[i]
+        if word in DROPPED_OPTIONS:
+            i += 1 + DROPPED_OPTIONS[word]
+            continue
+        options.append('--unwind' if word == '--unwind-max' else word)
+        i += 1
+    return source, options
+
+
+def run(cbmc, directory, source, options, strategy, timeout):
+    """Run cbmc once and return the outcome and the wall-clock time taken"""
+    command = [cbmc, source, '--paths', strategy, '--stop-on-fail'] + options
+    start = time.time()
+    try:
+        result = subprocess.run(
+            command, cwd=directory, stdout=subprocess.DEVNULL,
+            stderr=subprocess.DEVNULL, timeout=timeout)
+        outcome = {0: 'SUCCESS', 10: 'FAILURE'}.get(
+            result.returncode, 'ERROR({})'.format(result.returncode))
+    except subprocess.TimeoutExpired:
+        outcome = 'TIMEOUT'
+    return outcome, time.time() - start
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('cbmc', help='path to the cbmc binary')
+    parser.add_argument(
+        'tests', nargs='*',
+        help='test directories, or directories of test directories '
+             '(default: regression/cbmc-incr)')
+    parser.add_argument(
+        '--strategies', default='lifo,fifo,coverage-guided,shortest-distance',
+        help='comma-separated list of strategies to compare')
+    parser.add_argument(
+        '--timeout', type=float, default=60,
+        help='seconds after which a run is aborted')
+    args = parser.parse_args()
+
+    if not args.tests:
+        root = os.path.join(
+            os.path.dirname(os.path.abspath(__file__)), '..', '..',
+            'regression', 'cbmc-incr')
+        args.tests = [root]
+
+    directories = []
+    for test in args.tests:
+        if os.path.isfile(os.path.join(test, 'test.desc')):
+            directories.append(test)
+        else:
+            directories += sorted(
+                os.path.join(test, d) for d in os.listdir(test)
+                if os.path.isfile(os.path.join(test, d, 'test.desc')))
+
+    writer = csv.writer(sys.stdout)
+    writer.writerow(['test', 'strategy', 'result', 'seconds'])
+    for directory in directories:
+        source, options = test_options(os.path.join(directory, 'test.desc'))
+        for strategy in args.strategies.split(','):
+            outcome, seconds = run(
+                args.cbmc, directory, source, options, strategy, args.timeout)
+            writer.writerow([os.path.basename(directory), strategy, outcome,
+                             '{:.3f}'.format(seconds)])
+            sys.stdout.flush()
+
+
+if __name__ == '__main__':
+    main()
@@ -24,6 +24,7 @@ Author: Peter Schrammel
 #include <util/ieee_float.h>
 #include <util/mathematical_types.h>
 #include <util/simplify_expr.h>
+#include <util/simplify_expr_class.h>
 
 #include <langapi/language_util.h>
 
@@ -39,6 +40,7 @@ Author: Peter Schrammel
 /// \param lhs: lhs expression to assign
 /// \param rhs: rhs expression to assign to lhs
 /// \param ns: namespace, used to check for type mismatches
+/// \param simplifier: simplifier used to evaluate expressions
 /// \param cp: owning constant propagator instance, used to filter out symbols
 ///   that the user doesn't want tracked
 /// \param is_assignment: if true, assign_rec may remove entries from
@@ -53,13 +55,14 @@ void constant_propagator_domaint::assign_rec(
   const exprt &lhs,
   const exprt &rhs,
   const namespacet &ns,
+  simplify_exprt &simplifier,
   const constant_propagator_ait *cp,
   bool is_assignment)
 {
   if(lhs.id() == ID_dereference)
   {
     exprt eval_lhs = lhs;
-    if(partial_evaluate(dest_values, eval_lhs, ns))
+    if(partial_evaluate(dest_values, eval_lhs, simplifier))
     {
       if(is_assignment)
       {
@@ -73,13 +76,21 @@ void constant_propagator_domaint::assign_rec(
       // Otherwise disregard this unknown deref in a read-only context.
     }
     else
-      assign_rec(dest_values, eval_lhs, rhs, ns, cp, is_assignment);
+      assign_rec(
+        dest_values, eval_lhs, rhs, ns, simplifier, cp, is_assignment);
   }
   else if(lhs.id() == ID_index)
   {
     const index_exprt &index_expr = to_index_expr(lhs);
     with_exprt new_rhs(index_expr.array(), index_expr.index(), rhs);
-    assign_rec(dest_values, index_expr.array(), new_rhs, ns, cp, is_assignment);
+    assign_rec(
+      dest_values,
+      index_expr.array(),
+      new_rhs,
+      ns,
+      simplifier,
+      cp,
+      is_assignment);
   }
   else if(lhs.id() == ID_member)
   {
@@ -87,7 +98,13 @@ void constant_propagator_domaint::assign_rec(
     with_exprt new_rhs(member_expr.compound(), exprt(ID_member_name), rhs);
     new_rhs.where().set(ID_component_name, member_expr.get_component_name());
     assign_rec(
-      dest_values, member_expr.compound(), new_rhs, ns, cp, is_assignment);
+      dest_values,
+      member_expr.compound(),
+      new_rhs,
+      ns,
+      simplifier,
+      cp,
+      is_assignment);
   }
   else if(lhs.id() == ID_symbol)
   {
@@ -97,7 +114,7 @@ void constant_propagator_domaint::assign_rec(
     const symbol_exprt &s = to_symbol_expr(lhs);
 
     exprt tmp = rhs;
-    partial_evaluate(dest_values, tmp, ns);
+    partial_evaluate(dest_values, tmp, simplifier);
 
     if(dest_values.is_constant(tmp))
     {
@@ -143,10 +160,14 @@ void constant_propagator_domaint::transform(
   // information about dirty variables and config flags are
   // available. Otherwise, the below will be null and we use default
   // values
-  const constant_propagator_ait *cp=
-    dynamic_cast<constant_propagator_ait *>(&ai);
+  constant_propagator_ait *cp = dynamic_cast<constant_propagator_ait *>(&ai);
   bool have_dirty=(cp!=nullptr);
 
+  simplify_exprt default_simplifier(ns);
+  simplify_exprt &simplifier =
+    cp != nullptr ? cp->get_simplifier(default_simplifier, ns)
+                  : default_simplifier;
+
   // Transform on a domain that is bottom is possible
   // if a branch is impossible the target can still wind
   // up on the work list.
@@ -164,11 +185,11 @@ void constant_propagator_domaint::transform(
     const auto &assignment = from->get_assign();
     const exprt &lhs=assignment.lhs();
     const exprt &rhs=assignment.rhs();
-    assign_rec(values, lhs, rhs, ns, cp, true);
+    assign_rec(values, lhs, rhs, ns, simplifier, cp, true);
   }
   else if(from->is_assume())
   {
-    two_way_propagate_rec(from->get_condition(), ns, cp);
+    two_way_propagate_rec(from->get_condition(), ns, simplifier, cp);
   }
   else if(from->is_goto())
   {
@@ -180,11 +201,11 @@ void constant_propagator_domaint::transform(
       g = from->get_condition();
     else
       g = not_exprt(from->get_condition());
-    partial_evaluate(values, g, ns);
+    partial_evaluate(values, g, simplifier);
     if(g.is_false())
      values.set_to_bottom();
     else
-      two_way_propagate_rec(g, ns, cp);
+      two_way_propagate_rec(g, ns, simplifier, cp);
   }
   else if(from->is_dead())
   {
@@ -242,7 +263,7 @@ void constant_propagator_domaint::transform(
             break;
 
           const symbol_exprt parameter_expr(p_it->get_identifier(), arg.type());
-          assign_rec(values, parameter_expr, arg, ns, cp, true);
+          assign_rec(values, parameter_expr, arg, ns, simplifier, cp, true);
 
           ++p_it;
         }
@@ -308,6 +329,7 @@ replace_typecast_of_bool(exprt &lhs, exprt &rhs, const namespacet &ns)
 bool constant_propagator_domaint::two_way_propagate_rec(
   const exprt &expr,
   const namespacet &ns,
+  simplify_exprt &simplifier,
   const constant_propagator_ait *cp)
 {
 #ifdef DEBUG
@@ -326,7 +348,7 @@ bool constant_propagator_domaint::two_way_propagate_rec(
 
       forall_operands(it, expr)
       {
-        change_this_time |= two_way_propagate_rec(*it, ns, cp);
+        change_this_time |= two_way_propagate_rec(*it, ns, simplifier, cp);
         if(change_this_time)
           change = true;
       }
@@ -338,13 +360,13 @@ bool constant_propagator_domaint::two_way_propagate_rec(
     {
       exprt subexpr = expr.op0();
       subexpr.id(subexpr.id() == ID_equal ? ID_notequal : ID_equal);
-      change = two_way_propagate_rec(subexpr, ns, cp);
+      change = two_way_propagate_rec(subexpr, ns, simplifier, cp);
     }
     else if(expr.op0().id() == ID_symbol && expr.type() == bool_typet())
     {
       // Treat `IF !x` like `IF x == FALSE`:
-      change =
-        two_way_propagate_rec(equal_exprt(expr.op0(), false_exprt()), ns, cp);
+      change = two_way_propagate_rec(
+        equal_exprt(expr.op0(), false_exprt()), ns, simplifier, cp);
     }
   }
   else if(expr.id() == ID_symbol)
@@ -352,7 +374,8 @@ bool constant_propagator_domaint::two_way_propagate_rec(
     if(expr.type() == bool_typet())
     {
       // Treat `IF x` like `IF x == TRUE`:
-      change = two_way_propagate_rec(equal_exprt(expr, true_exprt()), ns, cp);
+      change = two_way_propagate_rec(
+        equal_exprt(expr, true_exprt()), ns, simplifier, cp);
     }
   }
   else if(expr.id() == ID_notequal)
@@ -380,7 +403,7 @@ bool constant_propagator_domaint::two_way_propagate_rec(
     else
       rhs = from_integer(0, rhs.type());
 
-    change = two_way_propagate_rec(equal_exprt(lhs, rhs), ns, cp);
+    change = two_way_propagate_rec(equal_exprt(lhs, rhs), ns, simplifier, cp);
   }
   else if(expr.id() == ID_equal)
   {
@@ -391,9 +414,9 @@ bool constant_propagator_domaint::two_way_propagate_rec(
 
     // two-way propagation
     valuest copy_values=values;
-    assign_rec(copy_values, lhs, rhs, ns, cp, false);
+    assign_rec(copy_values, lhs, rhs, ns, simplifier, cp, false);
     if(!values.is_constant(rhs) || values.is_constant(lhs))
-      assign_rec(values, rhs, lhs, ns, cp, false);
+      assign_rec(values, rhs, lhs, ns, simplifier, cp, false);
     change = values.meet(copy_values, ns);
   }
 
@@ -652,27 +675,39 @@ bool constant_propagator_domaint::partial_evaluate(
   const valuest &known_values,
   exprt &expr,
   const namespacet &ns)
+{
+  simplify_exprt simplifier(ns);
+  return partial_evaluate(known_values, expr, simplifier);
+}
+
+bool constant_propagator_domaint::partial_evaluate(
+  const valuest &known_values,
+  exprt &expr,
+  simplify_exprt &simplifier)
 {
   // if the current rounding mode is top we can
   // still get a non-top result by trying all rounding
   // modes and checking if the results are all the same
   if(!known_values.is_constant(ID_cprover_rounding_mode_str))
-    return partial_evaluate_with_all_rounding_modes(known_values, expr, ns);
+  {
+    return partial_evaluate_with_all_rounding_modes(
+      known_values, expr, simplifier);
+  }
 
-  return replace_constants_and_simplify(known_values, expr, ns);
+  return replace_constants_and_simplify(known_values, expr, simplifier);
 }
 
 /// Attempt to evaluate an expression in all rounding modes.
 ///
 /// \param known_values: The constant values under which to evaluate \p expr
 /// \param expr: The expression to evaluate
-/// \param ns: The namespace for symbols in the expression
+/// \param simplifier: The simplifier to use
 /// \return If the result is the same for all rounding modes, change
 ///   expr to that result and return false. Otherwise, return true.
 bool constant_propagator_domaint::partial_evaluate_with_all_rounding_modes(
   const valuest &known_values,
   exprt &expr,
-  const namespacet &ns)
+  simplify_exprt &simplifier)
 { // NOLINTNEXTLINE (whitespace/braces)
   auto rounding_modes = std::array<ieee_floatt::rounding_modet, 4>{
     // NOLINTNEXTLINE (whitespace/braces)
@@ -689,7 +724,7 @@ bool constant_propagator_domaint::partial_evaluate_with_all_rounding_modes(
       symbol_exprt(ID_cprover_rounding_mode_str, integer_typet()),
       from_integer(rounding_modes[i], integer_typet()));
     exprt result = expr;
-    if(replace_constants_and_simplify(tmp_values, result, ns))
+    if(replace_constants_and_simplify(tmp_values, result, simplifier))
     {
       return true;
     }
@@ -709,7 +744,7 @@ bool constant_propagator_domaint::partial_evaluate_with_all_rounding_modes(
 bool constant_propagator_domaint::replace_constants_and_simplify(
   const valuest &known_values,
   exprt &expr,
-  const namespacet &ns)
+  simplify_exprt &simplifier)
 {
   bool did_not_change_anything = true;
 
@@ -722,17 +757,30 @@ bool constant_propagator_domaint::replace_constants_and_simplify(
   while(!known_values.replace_const.replace(expr))
   {
     did_not_change_anything = false;
-    simplify(expr, ns);
+    simplifier.simplify(expr);
   }
 
   // even if we haven't been able to constant-propagate anything, run the
   // simplifier on the expression
   if(did_not_change_anything)
-    did_not_change_anything &= simplify(expr, ns);
+    did_not_change_anything &= simplifier.simplify(expr);
 
   return did_not_change_anything;
 }
 
+simplify_exprt &constant_propagator_ait::get_simplifier(
+  simplify_exprt &default_simplifier,
+  const namespacet &ns)
+{
+  if(!simplifier)
+    return default_simplifier;
+
+  INVARIANT(
+    simplifier_symbol_table == &ns.get_symbol_table(),
+    "the simplifier cache must be enabled with the namespace of the analysis");
+  return *simplifier;
+}
+
 void constant_propagator_ait::replace(
   goto_functionst &goto_functions,
   const namespacet &ns)
@@ -746,6 +794,9 @@ void constant_propagator_ait::replace(
   goto_functionst::goto_functiont &goto_function,
   const namespacet &ns)
 {
+  simplify_exprt default_simplifier(ns);
+  simplify_exprt &simplifier = get_simplifier(default_simplifier, ns);
+
   Forall_goto_program_instructions(it, goto_function.body)
   {
     // Works because this is a location (but not history) sensitive domain
@@ -760,7 +811,8 @@ void constant_propagator_ait::replace(
     {
       exprt c = it->get_condition();
       replace_types_rec(d.values.replace_const, c);
-      if(!constant_propagator_domaint::partial_evaluate(d.values, c, ns))
+      if(!constant_propagator_domaint::partial_evaluate(
+           d.values, c, simplifier))
         it->set_condition(c);
     }
     else if(it->is_assign())
@@ -768,7 +820,8 @@ void constant_propagator_ait::replace(
       auto assign = it->get_assign();
       exprt &rhs = assign.rhs();
 
-      if(!constant_propagator_domaint::partial_evaluate(d.values, rhs, ns))
+      if(!constant_propagator_domaint::partial_evaluate(
+           d.values, rhs, simplifier))
       {
         if(rhs.id() == ID_constant)
           rhs.add_source_location() = assign.lhs().source_location();
@@ -782,14 +835,17 @@ void constant_propagator_ait::replace(
       bool call_changed = false;
 
       if(!constant_propagator_domaint::partial_evaluate(
-           d.values, call.function(), ns))
+           d.values, call.function(), simplifier))
       {
         call_changed = true;
       }
 
       for(auto &arg : call.arguments())
-        if(!constant_propagator_domaint::partial_evaluate(d.values, arg, ns))
+        if(!constant_propagator_domaint::partial_evaluate(
+             d.values, arg, simplifier))
+        {
           call_changed = true;
+        }
 
       if(call_changed)
         it->set_function_call(call);
@@ -800,7 +856,7 @@ void constant_propagator_ait::replace(
       {
         auto c = to_code_expression(it->get_other());
         if(!constant_propagator_domaint::partial_evaluate(
-             d.values, c.expression(), ns))
+             d.values, c.expression(), simplifier))
         {
           it->set_other(c);
         }
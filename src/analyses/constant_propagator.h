@@ -23,7 +23,11 @@ Author: Peter Schrammel
 #define CPROVER_ANALYSES_CONSTANT_PROPAGATOR_H
 
 #include <iosfwd>
+#include <memory>
+
+#include <util/make_unique.h>
 #include <util/replace_symbol.h>
+#include <util/simplify_expr_class.h>
 
 #include "ai.h"
 #include "dirty.h"
@@ -142,29 +146,38 @@ public:
     exprt &expr,
     const namespacet &ns);
 
+  /// Like \ref partial_evaluate, but using \p simplifier, which may memoize
+  /// results
+  static bool partial_evaluate(
+    const valuest &known_values,
+    exprt &expr,
+    simplify_exprt &simplifier);
+
 protected:
   static void assign_rec(
     valuest &dest_values,
     const exprt &lhs,
     const exprt &rhs,
     const namespacet &ns,
+    simplify_exprt &simplifier,
     const constant_propagator_ait *cp,
     bool is_assignment);
 
   bool two_way_propagate_rec(
     const exprt &expr,
     const namespacet &ns,
+    simplify_exprt &simplifier,
     const constant_propagator_ait *cp);
 
   static bool partial_evaluate_with_all_rounding_modes(
     const valuest &known_values,
     exprt &expr,
-    const namespacet &ns);
+    simplify_exprt &simplifier);
 
   static bool replace_constants_and_simplify(
     const valuest &known_values,
     exprt &expr,
-    const namespacet &ns);
+    simplify_exprt &simplifier);
 };
 
 class constant_propagator_ait:public ait<constant_propagator_domaint>
@@ -218,9 +231,42 @@ public:
 
   dirtyt dirty;
 
+  /// Memoize up to \p max_size simplification results while computing and
+  /// replacing constants. \p ns must refer to the symbol table the analysis
+  /// is run on.
+  void enable_simplify_cache(const namespacet &ns, std::size_t max_size)
+  {
+    simplifier = util_make_unique<simplify_exprt>(ns);
+    simplifier->enable_cache(max_size);
+    simplifier_symbol_table = &ns.get_symbol_table();
+  }
+
+  /// Number of simplifications found in the cache enabled by
+  /// \ref enable_simplify_cache (0 when it is not enabled)
+  std::size_t simplify_cache_hits() const
+  {
+    return simplifier ? simplifier->cache_hits() : 0;
+  }
+
+  /// Number of simplifications not found in the cache enabled by
+  /// \ref enable_simplify_cache (0 when it is not enabled)
+  std::size_t simplify_cache_misses() const
+  {
+    return simplifier ? simplifier->cache_misses() : 0;
+  }
+
 protected:
   friend class constant_propagator_domaint;
 
+  std::unique_ptr<simplify_exprt> simplifier;
+  /// The symbol table of the namespace passed to \ref enable_simplify_cache
+  const symbol_table_baset *simplifier_symbol_table = nullptr;
+
+  /// The simplifier set up by \ref enable_simplify_cache, if any, or else
+  /// \p default_simplifier. \p ns is the namespace the analysis is run with.
+  simplify_exprt &
+  get_simplifier(simplify_exprt &default_simplifier, const namespacet &ns);
+
   void replace(
     goto_functionst::goto_functiont &,
     const namespacet &);
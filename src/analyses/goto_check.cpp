@@ -33,6 +33,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/language.h>
 #include <langapi/mode.h>
 
+#include <goto-programs/parallel_function_pass.h>
 #include <goto-programs/remove_skip.h>
 
 #include "guard.h"
@@ -80,6 +81,13 @@ public:
 
   void collect_allocations(const goto_functionst &goto_functions);
 
+  /// Use the allocations collected by \p other instead of collecting them
+  /// again
+  void copy_allocations(const goto_checkt &other)
+  {
+    allocations = other.allocations;
+  }
+
 protected:
   const namespacet &ns;
   std::unique_ptr<local_bitvector_analysist> local_bitvector_analysis;
@@ -1995,22 +2003,43 @@ void goto_check(
 void goto_check(
   const namespacet &ns,
   const optionst &options,
-  goto_functionst &goto_functions)
+  goto_functionst &goto_functions,
+  std::size_t jobs)
 {
   goto_checkt goto_check(ns, options);
 
   goto_check.collect_allocations(goto_functions);
 
-  Forall_goto_functions(it, goto_functions)
+  if(jobs <= 1)
   {
-    goto_check.goto_check(it->first, it->second);
+    Forall_goto_functions(it, goto_functions)
+    {
+      goto_check.goto_check(it->first, it->second);
+    }
+
+    return;
   }
+
+  // goto_checkt::goto_check resets all state that is specific to a
+  // function, hence using a fresh instance per function is equivalent,
+  // except that with BDD_GUARDS the variable order of guards may differ
+  parallel_function_pass(
+    goto_functions,
+    jobs,
+    [&ns, &options, &goto_check](
+      const irep_idt &function_identifier,
+      goto_functionst::goto_functiont &goto_function) {
+      goto_checkt function_check(ns, options);
+      function_check.copy_allocations(goto_check);
+      function_check.goto_check(function_identifier, goto_function);
+    });
 }
 
 void goto_check(
   const optionst &options,
-  goto_modelt &goto_model)
+  goto_modelt &goto_model,
+  std::size_t jobs)
 {
   const namespacet ns(goto_model.symbol_table);
-  goto_check(ns, options, goto_model.goto_functions);
+  goto_check(ns, options, goto_model.goto_functions, jobs);
 }
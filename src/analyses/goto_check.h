@@ -21,7 +21,8 @@ class optionst;
 void goto_check(
   const namespacet &ns,
   const optionst &options,
-  goto_functionst &goto_functions);
+  goto_functionst &goto_functions,
+  std::size_t jobs = 1);
 
 void goto_check(
   const irep_idt &function_identifier,
@@ -31,7 +32,8 @@ void goto_check(
 
 void goto_check(
   const optionst &options,
-  goto_modelt &goto_model);
+  goto_modelt &goto_model,
+  std::size_t jobs = 1);
 
 #define OPT_GOTO_CHECK \
   "(bounds-check)(pointer-check)(memory-leak-check)" \
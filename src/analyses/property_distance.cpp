@@ -0,0 +1,143 @@
+/*******************************************************************\
+
+Module: Distances to Properties
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Static distances to properties in the control-flow graph
+
+#include "property_distance.h"
+
+#include <queue>
+
+constexpr std::size_t property_distancet::infinity;
+
+const property_distancet::distancest &property_distancet::get(
+  const irep_idt &function_id,
+  goto_programt::const_targett target)
+{
+  if(functions.find(function_id) == functions.end())
+    compute(function_id);
+
+  static const distancest unknown{infinity, infinity};
+  const auto entry = distances.find(&*target);
+  return entry == distances.end() ? unknown : entry->second;
+}
+
+property_distancet::distancest
+property_distancet::entry(const irep_idt &function_id)
+{
+  // bodyless functions return at once
+  if(!goto_model.can_produce_function(function_id))
+    return {infinity, 0};
+
+  if(functions.find(function_id) == functions.end())
+    compute(function_id);
+
+  const goto_programt &body = goto_model.get_goto_function(function_id).body;
+  if(body.instructions.empty())
+    return {infinity, 0};
+
+  // a recursive call, whose distances are not known yet
+  const auto entry = distances.find(&body.instructions.front());
+  if(entry == distances.end())
+    return {infinity, 0};
+
+  return entry->second;
+}
+
+void property_distancet::compute(const irep_idt &function_id)
+{
+  functions.insert(function_id);
+
+  if(!goto_model.can_produce_function(function_id))
+    return;
+
+  const goto_programt &body = goto_model.get_goto_function(function_id).body;
+  const std::size_t size = body.instructions.size();
+
+  std::vector<goto_programt::const_targett> targets;
+  targets.reserve(size);
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> index;
+  forall_goto_program_instructions(it, body)
+  {
+    index.emplace(&*it, targets.size());
+    targets.push_back(it);
+  }
+
+  // the cost of executing each instruction, and the distances from each
+  // instruction without considering its successors
+  std::vector<std::size_t> cost(size, 1);
+  std::vector<std::size_t> to_property(size, infinity);
+  std::vector<std::size_t> to_end(size, infinity);
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    const goto_programt::instructiont &instruction = *targets[i];
+
+    if(instruction.is_assert() && !instruction.get_condition().is_true())
+      to_property[i] = 0;
+    else if(instruction.is_end_function())
+      to_end[i] = 0;
+    else if(
+      instruction.is_function_call() &&
+      instruction.get_function_call().function().id() == ID_symbol)
+    {
+      const distancest callee = entry(
+        to_symbol_expr(instruction.get_function_call().function())
+          .get_identifier());
+      to_property[i] = add(callee.to_property, 1);
+      cost[i] = add(callee.to_end, 1);
+    }
+  }
+
+  std::vector<std::vector<std::size_t>> predecessors(size);
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    for(const auto &successor : body.get_successors(targets[i]))
+      predecessors[index.at(&*successor)].push_back(i);
+  }
+
+  // Dijkstra's algorithm on the reversed control-flow graph, starting from
+  // all instructions with a finite distance
+  const auto propagate = [&](std::vector<std::size_t> &distance) {
+    typedef std::pair<std::size_t, std::size_t> queue_entryt;
+    std::priority_queue<
+      queue_entryt,
+      std::vector<queue_entryt>,
+      std::greater<queue_entryt>>
+      queue;
+
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      if(distance[i] != infinity)
+        queue.emplace(distance[i], i);
+    }
+
+    while(!queue.empty())
+    {
+      const queue_entryt top = queue.top();
+      queue.pop();
+      if(top.first > distance[top.second])
+        continue;
+
+      for(const std::size_t predecessor : predecessors[top.second])
+      {
+        const std::size_t via = add(top.first, cost[predecessor]);
+        if(via < distance[predecessor])
+        {
+          distance[predecessor] = via;
+          queue.emplace(via, predecessor);
+        }
+      }
+    }
+  };
+
+  propagate(to_property);
+  propagate(to_end);
+
+  for(std::size_t i = 0; i < size; ++i)
+    distances.emplace(&*targets[i], distancest{to_property[i], to_end[i]});
+}
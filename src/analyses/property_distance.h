@@ -0,0 +1,85 @@
+/*******************************************************************\
+
+Module: Distances to Properties
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Static distances to properties in the control-flow graph
+
+#ifndef CPROVER_ANALYSES_PROPERTY_DISTANCE_H
+#define CPROVER_ANALYSES_PROPERTY_DISTANCE_H
+
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <goto-programs/abstract_goto_model.h>
+
+/// Computes for each instruction the smallest number of instructions that
+/// must be executed from it until reaching an assertion, and until reaching
+/// the end of its function. Calls to functions with a body are followed, at
+/// the cost of executing the callee up to its end if no assertion is reached
+/// in it. Recursive calls are assumed to return immediately. Distances are
+/// computed for a function when first asked for, using the function bodies
+/// provided by a goto model, which may load them lazily.
+class property_distancet
+{
+public:
+  explicit property_distancet(abstract_goto_modelt &goto_model)
+    : goto_model(goto_model)
+  {
+  }
+
+  /// Distance to instructions from which no assertion or end of function
+  /// can be reached
+  static constexpr std::size_t infinity =
+    std::numeric_limits<std::size_t>::max();
+
+  /// \return \p a + \p b, or \ref infinity if either is \ref infinity
+  static std::size_t add(std::size_t a, std::size_t b)
+  {
+    return a >= infinity - b ? infinity : a + b;
+  }
+
+  /// Number of instructions executed from \p target, in function
+  /// \p function_id, until reaching an assertion before returning
+  std::size_t
+  to_property(const irep_idt &function_id, goto_programt::const_targett target)
+  {
+    return get(function_id, target).to_property;
+  }
+
+  /// Number of instructions executed from \p target, in function
+  /// \p function_id, until reaching the end of the function
+  std::size_t
+  to_end(const irep_idt &function_id, goto_programt::const_targett target)
+  {
+    return get(function_id, target).to_end;
+  }
+
+private:
+  struct distancest
+  {
+    std::size_t to_property;
+    std::size_t to_end;
+  };
+
+  abstract_goto_modelt &goto_model;
+  /// Functions whose distances have been or are being computed
+  std::unordered_set<irep_idt> functions;
+  std::unordered_map<const goto_programt::instructiont *, distancest>
+    distances;
+
+  const distancest &
+  get(const irep_idt &function_id, goto_programt::const_targett target);
+
+  /// Distances from the entry of \p function_id
+  distancest entry(const irep_idt &function_id);
+
+  void compute(const irep_idt &function_id);
+};
+
+#endif // CPROVER_ANALYSES_PROPERTY_DISTANCE_H
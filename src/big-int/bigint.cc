@@ -16,6 +16,13 @@
 #include <cstdio>
 #define error(x) fprintf (stderr, "%s\n", x)
 
+// Arithmetic on values that fit into an elementary type is done
+// directly, using the compiler's overflow-checking builtins.
+#if !defined BIGINT_NO_OVERFLOW_BUILTINS \
+    && (defined __clang__ || defined __GNUC__ && __GNUC__ >= 5)
+#define BIGINT_OVERFLOW_BUILTINS
+#endif
+
 
 // Shortcut access to BigInt scoped things.
 typedef BigInt::llong_t  llong_t;
@@ -291,7 +298,7 @@ BigInt::reallocate (unsigned digits)
 {
   if (digits > size)
     {
-      if (size)
+      if (owns_digits())
 	delete[] digit;
       size = adjust_size (digits);
       digit = new onedig_t[size];
@@ -307,13 +314,13 @@ BigInt::resize (unsigned digits)
   if (digits > size)
     {
       onedig_t *old_digit = digit;
-      unsigned old_size = size;
+      bool old_owned = owns_digits();
       size = adjust_size (digits);
       digit = new onedig_t[size];
       if (old_digit)
 	{
 	  memcpy (digit, old_digit, length * sizeof (onedig_t));
-	  if (old_size)
+	  if (old_owned)
 	    delete[] old_digit;
 	}
     }
@@ -378,7 +385,7 @@ BigInt::assign (llong_t l)
     }
   else
     {
-      digit_set (ullong_t (-l), digit, length);
+      digit_set (ullong_t (0) - ullong_t (l), digit, length);
       positive = false;
     }
 }
@@ -386,7 +393,7 @@ BigInt::assign (llong_t l)
 
 BigInt::~BigInt()
 {
-  if (size > 0)
+  if (owns_digits())
     {
       memset (digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
       delete[] digit;
@@ -401,64 +408,65 @@ BigInt::BigInt (onedig_t *dig, unsigned len, bool pos)
 {}
 
 BigInt::BigInt()
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {}
 
 BigInt::BigInt (signed long int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned long int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (n));
 }
 
 BigInt::BigInt (int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned u)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (u));
 }
 
 BigInt::BigInt (llong_t l)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (l);
 }
 
 BigInt::BigInt (ullong_t ul)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ul);
 }
 
 BigInt::BigInt (BigInt const &y)
-  : size (adjust_size (y.length)),
+  : size (y.length <= inline_size ? unsigned (inline_size)
+				   : adjust_size (y.length)),
     length (y.length),
-    digit (new onedig_t[size]),
+    digit (y.length <= inline_size ? inline_digit : new onedig_t[size]),
     positive (y.positive)
 {
   memcpy (digit, y.digit, length * sizeof (onedig_t));
@@ -471,9 +479,9 @@ BigInt::BigInt (BigInt &&y)
 }
 
 BigInt::BigInt (char const *s, onedig_t b)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {
   scan (s, b);
@@ -719,6 +727,18 @@ BigInt::ucompare (BigInt const &b) const
     return digit_cmp (digit, b.digit, length);
 }
 
+// Auxiliary method for the fast paths: fetch the value of this if it
+// fits into an llong_t.
+
+inline bool
+BigInt::small_value (llong_t &value) const
+{
+  if (length > small || !is_long())
+    return false;
+  value = to_long();
+  return true;
+}
+
 // Comparision primitives.
 
 int
@@ -873,7 +893,7 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
   else
     {
       // Get a new string of digits for the result.
-      unsigned old_size = size;
+      bool old_owned = owns_digits();
       size = adjust_size (length + len);
       onedig_t *r = new onedig_t[size];
 
@@ -885,7 +905,7 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
 	digit_mul (dig, len, digit, length, r);
 
       // Replace digit string of this with result.
-      if (old_size)
+      if (old_owned)
 	delete[] digit;
       digit = r;
       length += len;
@@ -903,6 +923,14 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
 BigInt &
 BigInt::operator+= (llong_t y)
 {
+#ifdef BIGINT_OVERFLOW_BUILTINS
+  llong_t x, r;
+  if (small_value (x) && !__builtin_add_overflow (x, y, &r))
+    {
+      assign (r);
+      return *this;
+    }
+#endif
   bool pos = y > 0;
   ullong_t uy = pos ? y : -y;
   onedig_t yb[small];
@@ -915,6 +943,14 @@ BigInt::operator+= (llong_t y)
 BigInt &
 BigInt::operator-= (llong_t y)
 {
+#ifdef BIGINT_OVERFLOW_BUILTINS
+  llong_t x, r;
+  if (small_value (x) && !__builtin_sub_overflow (x, y, &r))
+    {
+      assign (r);
+      return *this;
+    }
+#endif
   bool pos = y > 0;
   ullong_t uy = pos ? y : -y;
   onedig_t yb[small];
@@ -927,6 +963,14 @@ BigInt::operator-= (llong_t y)
 BigInt &
 BigInt::operator*= (llong_t y)
 {
+#ifdef BIGINT_OVERFLOW_BUILTINS
+  llong_t x, r;
+  if (small_value (x) && !__builtin_mul_overflow (x, y, &r))
+    {
+      assign (r);
+      return *this;
+    }
+#endif
   bool pos = y > 0;
   ullong_t uy = pos ? y : -y;
   onedig_t yb[small];
@@ -1011,6 +1055,15 @@ BigInt::operator%= (ullong_t uy)
 BigInt &
 BigInt::operator+= (BigInt const &y)
 {
+#ifdef BIGINT_OVERFLOW_BUILTINS
+  llong_t x, z, r;
+  if (small_value (x) && y.small_value (z)
+      && !__builtin_add_overflow (x, z, &r))
+    {
+      assign (r);
+      return *this;
+    }
+#endif
   add (y.digit, y.length, y.positive);
   return *this;
 }
@@ -1018,6 +1071,15 @@ BigInt::operator+= (BigInt const &y)
 BigInt &
 BigInt::operator-= (BigInt const &y)
 {
+#ifdef BIGINT_OVERFLOW_BUILTINS
+  llong_t x, z, r;
+  if (small_value (x) && y.small_value (z)
+      && !__builtin_sub_overflow (x, z, &r))
+    {
+      assign (r);
+      return *this;
+    }
+#endif
   add (y.digit, y.length, !y.positive);
   return *this;
 }
@@ -1025,6 +1087,15 @@ BigInt::operator-= (BigInt const &y)
 BigInt &
 BigInt::operator*= (BigInt const &y)
 {
+#ifdef BIGINT_OVERFLOW_BUILTINS
+  llong_t x, z, r;
+  if (small_value (x) && y.small_value (z)
+      && !__builtin_mul_overflow (x, z, &r))
+    {
+      assign (r);
+      return *this;
+    }
+#endif
   mul (y.digit, y.length, y.positive);
   return *this;
 }
@@ -129,10 +129,21 @@ public:
   enum { small = sizeof (ullong_t) / sizeof (onedig_t) };
 
 private:
+  // Number of digits stored within the object itself. Values that fit
+  // into an elementary type (plus a carry digit) never touch the heap.
+  enum { inline_size = small + 1 };
+
   unsigned size;			// Length of digit vector.
   unsigned length;			// Used places in digit vector.
   onedig_t *digit;			// Least significant first.
   bool positive;			// Signed magnitude representation.
+  onedig_t inline_digit[inline_size];	// Digit vector for small values.
+
+  // True iff the digit vector was allocated on the heap by this.
+  bool owns_digits() const
+  {
+    return size != 0 && digit != inline_digit;
+  }
 
   // Create or resize this.
   inline void allocate (unsigned digits);
@@ -148,6 +159,7 @@ private:
 
   // Aux methods, only for internal use.
   inline int ucompare (BigInt const &) const;
+  inline bool small_value (llong_t &) const;
   void add (onedig_t const *, unsigned, bool) _fast;
   void mul (onedig_t const *, unsigned, bool) _fast;
 
@@ -287,6 +299,12 @@ public:
     std::swap(other.length, length);
     std::swap(other.digit, digit);
     std::swap(other.positive, positive);
+    std::swap(other.inline_digit, inline_digit);
+    // Digits stored inline moved along with the buffers.
+    if (digit == other.inline_digit)
+      digit = inline_digit;
+    if (other.digit == inline_digit)
+      other.digit = other.inline_digit;
   }
 };
 
@@ -29,6 +29,8 @@ Author: Daniel Kroening, kroening@kroening.com
 extern unsigned long long irep_hash_cnt;
 extern unsigned long long irep_cmp_cnt;
 extern unsigned long long irep_cmp_ne_cnt;
+extern unsigned long long irep_hash_cache_hit_cnt;
+extern unsigned long long irep_cmp_hash_ne_cnt;
 #endif
 
 #ifdef _MSC_VER
@@ -49,6 +51,8 @@ int main(int argc, const char **argv)
   std::cout << "IREP_HASH_CNT=" << irep_hash_cnt << '\n';
   std::cout << "IREP_CMP_CNT=" << irep_cmp_cnt << '\n';
   std::cout << "IREP_CMP_NE_CNT=" << irep_cmp_ne_cnt << '\n';
+  std::cout << "IREP_HASH_CACHE_HIT_CNT=" << irep_hash_cache_hit_cnt << '\n';
+  std::cout << "IREP_CMP_HASH_NE_CNT=" << irep_cmp_hash_ne_cnt << '\n';
   #endif
 
   return res;
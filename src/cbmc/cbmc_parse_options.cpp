@@ -40,6 +40,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-checker/cover_goals_verifier_with_trace_storage.h>
 #include <goto-checker/multi_path_symex_checker.h>
 #include <goto-checker/multi_path_symex_only_checker.h>
+#include <goto-checker/parallel_path_symex_checker.h>
 #include <goto-checker/properties.h>
 #include <goto-checker/single_path_symex_checker.h>
 #include <goto-checker/single_path_symex_only_checker.h>
@@ -49,6 +50,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/adjust_float_expressions.h>
 #include <goto-programs/initialize_goto_model.h>
 #include <goto-programs/instrument_preconditions.h>
+#include <goto-programs/lazy_goto_model.h>
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
 #include <goto-programs/mm_io.h>
@@ -161,6 +163,38 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     exit(CPROVER_EXIT_USAGE_ERROR);
   }
 
+  if(cmdline.isset("symex-driven-lazy-loading"))
+  {
+    // these need to see the whole program before symbolic execution starts
+    for(const char *opt :
+        {"nondet-static",
+         "string-abstraction",
+         "drop-unused-functions",
+         "cover",
+         "full-slice",
+         "reachability-slice",
+         "reachability-slice-fb",
+         "property",
+         "claim",
+         "show-properties",
+         "show-claims",
+         "show-symbol-table",
+         "show-goto-functions",
+         "list-goto-functions",
+         "show-loops"})
+    {
+      if(cmdline.isset(opt))
+      {
+        log.error() << "--" << opt
+                    << " must not be given together with "
+                    << "--symex-driven-lazy-loading" << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+    }
+
+    options.set_option("symex-driven-lazy-loading", true);
+  }
+
   if(cmdline.isset("full-slice"))
     options.set_option("full-slice", true);
 
@@ -296,6 +330,31 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("slice-formula"))
     options.set_option("slice-formula", true);
 
+  // share expressions across all equations
+  if(cmdline.isset("hash-cons-ireps"))
+    options.set_option("hash-cons-ireps", true);
+
+  // convert the equation while running symex
+  if(cmdline.isset("stream-ssa"))
+  {
+    // steps that have been converted cannot be sliced away any more
+    for(const char *opt : {"slice-formula", "validate-ssa-equation"})
+    {
+      if(cmdline.isset(opt))
+      {
+        log.error() << "--" << opt << " must not be given together with "
+                    << "--stream-ssa" << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+    }
+
+    options.set_option("stream-ssa", true);
+    options.set_option("simple-slice", false);
+  }
+
+  if(cmdline.isset("simplify-cache"))
+    options.set_option("simplify-cache", cmdline.get_value("simplify-cache"));
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -441,6 +500,43 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("validate-goto-model", true);
   }
 
+  if(cmdline.isset("validate-each-pass"))
+    options.set_option("validate-each-pass", true);
+
+  if(cmdline.isset("jobs"))
+    options.set_option("jobs", cmdline.get_value("jobs"));
+
+  if(
+    options.get_bool_option("paths") &&
+    options.get_unsigned_int_option("jobs") > 1)
+  {
+#ifdef BDD_GUARDS
+    log.error() << "--paths cannot be used with --jobs in a build with BDD "
+                << "guards" << messaget::eom;
+    exit(CPROVER_EXIT_USAGE_ERROR);
+#endif
+
+    // the threads only keep their paths in a deque
+    const std::string strategy = options.get_option("exploration-strategy");
+    if(strategy != "lifo" && strategy != "fifo")
+    {
+      log.error() << "--paths " << strategy << " cannot be used with --jobs; "
+                  << "use lifo or fifo" << messaget::eom;
+      exit(CPROVER_EXIT_USAGE_ERROR);
+    }
+
+    // these use state that is shared by all paths
+    for(const char *opt : {"symex-driven-lazy-loading", "hash-cons-ireps"})
+    {
+      if(cmdline.isset(opt))
+      {
+        log.error() << "--" << opt << " must not be given together with "
+                    << "--paths and --jobs" << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+    }
+  }
+
   PARSE_OPTIONS_GOTO_TRACE(cmdline, options);
 }
 
@@ -546,21 +642,38 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
-  int get_goto_program_ret =
-    get_goto_program(goto_model, options, cmdline, ui_message_handler);
+  std::unique_ptr<lazy_goto_modelt> lazy_goto_model;
 
-  if(get_goto_program_ret!=-1)
-    return get_goto_program_ret;
+  if(options.get_bool_option("symex-driven-lazy-loading"))
+  {
+    int get_goto_program_ret = get_lazy_goto_program(lazy_goto_model, options);
 
-  if(cmdline.isset("show-claims") || // will go away
-     cmdline.isset("show-properties")) // use this one
+    if(get_goto_program_ret != -1)
+      return get_goto_program_ret;
+  }
+  else
   {
-    show_properties(goto_model, ui_message_handler);
-    return CPROVER_EXIT_SUCCESS;
+    int get_goto_program_ret =
+      get_goto_program(goto_model, options, cmdline, ui_message_handler);
+
+    if(get_goto_program_ret!=-1)
+      return get_goto_program_ret;
+
+    if(cmdline.isset("show-claims") || // will go away
+       cmdline.isset("show-properties")) // use this one
+    {
+      show_properties(goto_model, ui_message_handler);
+      return CPROVER_EXIT_SUCCESS;
+    }
+
+    if(set_properties())
+      return CPROVER_EXIT_SET_PROPERTIES_FAILED;
   }
 
-  if(set_properties())
-    return CPROVER_EXIT_SET_PROPERTIES_FAILED;
+  // the model that symbolic execution runs on
+  abstract_goto_modelt &model_to_check =
+    lazy_goto_model ? static_cast<abstract_goto_modelt &>(*lazy_goto_model)
+                    : goto_model;
 
   if(
     options.get_bool_option("program-only") ||
@@ -569,13 +682,13 @@ int cbmc_parse_optionst::doit()
     if(options.get_bool_option("paths"))
     {
       all_properties_verifiert<single_path_symex_only_checkert> verifier(
-        options, ui_message_handler, goto_model);
+        options, ui_message_handler, model_to_check);
       (void)verifier();
     }
     else
     {
       all_properties_verifiert<multi_path_symex_only_checkert> verifier(
-        options, ui_message_handler, goto_model);
+        options, ui_message_handler, model_to_check);
       (void)verifier();
     }
 
@@ -588,13 +701,13 @@ int cbmc_parse_optionst::doit()
     if(options.get_bool_option("paths"))
     {
       stop_on_fail_verifiert<single_path_symex_checkert> verifier(
-        options, ui_message_handler, goto_model);
+        options, ui_message_handler, model_to_check);
       (void)verifier();
     }
     else
     {
       stop_on_fail_verifiert<multi_path_symex_checkert> verifier(
-        options, ui_message_handler, goto_model);
+        options, ui_message_handler, model_to_check);
       (void)verifier();
     }
 
@@ -604,7 +717,7 @@ int cbmc_parse_optionst::doit()
   if(options.is_set("cover"))
   {
     cover_goals_verifier_with_trace_storaget<multi_path_symex_checkert>
-      verifier(options, ui_message_handler, goto_model);
+      verifier(options, ui_message_handler, model_to_check);
     (void)verifier();
     verifier.report();
 
@@ -616,12 +729,24 @@ int cbmc_parse_optionst::doit()
 
   std::unique_ptr<goto_verifiert> verifier = nullptr;
 
+  const bool parallel_paths = options.get_bool_option("paths") &&
+                              options.get_unsigned_int_option("jobs") > 1;
+
   if(
     options.get_bool_option("stop-on-fail") && options.get_bool_option("paths"))
   {
-    verifier =
-      util_make_unique<stop_on_fail_verifiert<single_path_symex_checkert>>(
-        options, ui_message_handler, goto_model);
+    if(parallel_paths)
+    {
+      verifier = util_make_unique<
+        stop_on_fail_verifiert<parallel_path_symex_checkert>>(
+        options, ui_message_handler, model_to_check);
+    }
+    else
+    {
+      verifier =
+        util_make_unique<stop_on_fail_verifiert<single_path_symex_checkert>>(
+          options, ui_message_handler, model_to_check);
+    }
   }
   else if(
     options.get_bool_option("stop-on-fail") &&
@@ -631,22 +756,32 @@ int cbmc_parse_optionst::doit()
     {
       verifier =
         util_make_unique<stop_on_fail_verifier_with_fault_localizationt<
-          multi_path_symex_checkert>>(options, ui_message_handler, goto_model);
+          multi_path_symex_checkert>>(
+          options, ui_message_handler, model_to_check);
     }
     else
     {
       verifier =
         util_make_unique<stop_on_fail_verifiert<multi_path_symex_checkert>>(
-          options, ui_message_handler, goto_model);
+          options, ui_message_handler, model_to_check);
     }
   }
   else if(
     !options.get_bool_option("stop-on-fail") &&
     options.get_bool_option("paths"))
   {
-    verifier = util_make_unique<
-      all_properties_verifier_with_trace_storaget<single_path_symex_checkert>>(
-      options, ui_message_handler, goto_model);
+    if(parallel_paths)
+    {
+      verifier = util_make_unique<all_properties_verifier_with_trace_storaget<
+        parallel_path_symex_checkert>>(
+        options, ui_message_handler, model_to_check);
+    }
+    else
+    {
+      verifier = util_make_unique<all_properties_verifier_with_trace_storaget<
+        single_path_symex_checkert>>(
+        options, ui_message_handler, model_to_check);
+    }
   }
   else if(
     !options.get_bool_option("stop-on-fail") &&
@@ -656,13 +791,14 @@ int cbmc_parse_optionst::doit()
     {
       verifier =
         util_make_unique<all_properties_verifier_with_fault_localizationt<
-          multi_path_symex_checkert>>(options, ui_message_handler, goto_model);
+          multi_path_symex_checkert>>(
+          options, ui_message_handler, model_to_check);
     }
     else
     {
       verifier = util_make_unique<
         all_properties_verifier_with_trace_storaget<multi_path_symex_checkert>>(
-        options, ui_message_handler, goto_model);
+        options, ui_message_handler, model_to_check);
     }
   }
   else
@@ -715,7 +851,9 @@ int cbmc_parse_optionst::get_goto_program(
 
     if(cmdline.isset("validate-goto-model"))
     {
-      goto_model.validate();
+      goto_model_validation_optionst validation_options;
+      validation_options.jobs = options.get_unsigned_int_option("jobs");
+      goto_model.validate(validation_modet::INVARIANT, validation_options);
     }
 
     // show it?
@@ -743,6 +881,103 @@ int cbmc_parse_optionst::get_goto_program(
   return -1; // no error, continue
 }
 
+/// Add the C and C++ library functions that are declared but have no body in
+/// \p lazy_goto_model. Their bodies are only converted to goto programs once
+/// symbolic execution first calls them.
+static void add_cprover_library(
+  lazy_goto_modelt &lazy_goto_model,
+  message_handlert &message_handler)
+{
+  symbol_tablet &symbol_table = lazy_goto_model.symbol_table;
+  const goto_functionst::function_mapt &function_map =
+    lazy_goto_model.get_goto_functions().function_map;
+
+  // this needs a fixedpoint, as library functions
+  // may depend on other library functions
+  std::set<irep_idt> added_functions;
+
+  while(true)
+  {
+    std::set<irep_idt> missing_functions;
+
+    for(const auto &named_symbol : symbol_table.symbols)
+    {
+      const symbolt &symbol = named_symbol.second;
+
+      if(
+        !symbol.is_function() || symbol.value.is_not_nil() ||
+        added_functions.find(symbol.name) != added_functions.end() ||
+        lazy_goto_model.can_produce_function(symbol.name))
+      {
+        continue;
+      }
+
+      const auto f_it = function_map.find(symbol.name);
+      if(f_it == function_map.end() || !f_it->second.body_available())
+        missing_functions.insert(symbol.name);
+    }
+
+    // done?
+    if(missing_functions.empty())
+      break;
+
+    cprover_cpp_library_factory(
+      missing_functions, symbol_table, message_handler);
+    cprover_c_library_factory(missing_functions, symbol_table, message_handler);
+
+    added_functions.insert(missing_functions.begin(), missing_functions.end());
+  }
+}
+
+int cbmc_parse_optionst::get_lazy_goto_program(
+  std::unique_ptr<lazy_goto_modelt> &lazy_goto_model,
+  const optionst &options)
+{
+  if(cmdline.args.empty())
+  {
+    log.error() << "Please provide a program to verify" << messaget::eom;
+    return CPROVER_EXIT_INCORRECT_TASK;
+  }
+
+  lazy_goto_model = util_make_unique<lazy_goto_modelt>(
+    lazy_goto_modelt::from_handler_object(*this, options, ui_message_handler));
+  lazy_goto_model->initialize(cmdline.args, options);
+
+  // The precise wording of this error matches goto-symex's complaint when no
+  // __CPROVER_start exists (if we just go ahead and run it anyway it will
+  // trip an invariant when it tries to load it)
+  if(!lazy_goto_model->symbol_table.has_symbol(goto_functionst::entry_point()))
+  {
+    log.error() << "the program has no entry point" << messaget::eom;
+    return CPROVER_EXIT_INCORRECT_TASK;
+  }
+
+  log.status() << "Adding CPROVER library (" << config.ansi_c.arch << ")"
+               << messaget::eom;
+  {
+    trace_spant link_span("link_to_library");
+    add_cprover_library(*lazy_goto_model, ui_message_handler);
+  }
+
+  // Lower the types of all symbols loaded so far; symbols that are added
+  // while loading a function are lowered in process_goto_function.
+  remove_vector(lazy_goto_model->symbol_table);
+  remove_complex(lazy_goto_model->symbol_table);
+
+  // Add failed symbols for any symbol created prior to loading any
+  // particular function:
+  add_failed_symbols(lazy_goto_model->symbol_table);
+
+  if(cmdline.isset("validate-goto-model"))
+  {
+    lazy_goto_model->validate();
+  }
+
+  log.status() << config.object_bits_info() << messaget::eom;
+
+  return -1; // no error, continue
+}
+
 void cbmc_parse_optionst::preprocessing(const optionst &options)
 {
   {
@@ -784,6 +1019,28 @@ bool cbmc_parse_optionst::process_goto_program(
   const optionst &options,
   messaget &log)
 {
+  trace_spant span("process_goto_program");
+
+  // number of threads for passes that work on each function separately
+  const std::size_t jobs = options.get_unsigned_int_option("jobs");
+
+  // With --validate-each-pass, check the goto model after each stage, only
+  // re-checking the functions that the stage has changed. The checks that
+  // require function pointers or returns to be removed are enabled once the
+  // stage removing them has run.
+  incremental_goto_model_validatort validate_incrementally;
+  goto_model_validation_optionst validation_options{
+    goto_model_validation_optionst::set_optionst::all_false};
+  validation_options.jobs = jobs;
+  auto validate_stage = [&](const char *stage) {
+    if(!options.get_bool_option("validate-each-pass"))
+      return;
+    log.debug() << "Validating the goto program after " << stage
+                << messaget::eom;
+    validate_incrementally(
+      goto_model, validation_modet::INVARIANT, validation_options);
+  };
+
   {
     // Remove inline assembler; this needs to happen before
     // adding the library.
@@ -792,10 +1049,13 @@ bool cbmc_parse_optionst::process_goto_program(
     // add the library
     log.status() << "Adding CPROVER library (" << config.ansi_c.arch << ")"
                  << messaget::eom;
-    link_to_library(
-      goto_model, log.get_message_handler(), cprover_cpp_library_factory);
-    link_to_library(
-      goto_model, log.get_message_handler(), cprover_c_library_factory);
+    {
+      trace_spant link_span("link_to_library");
+      link_to_library(
+        goto_model, log.get_message_handler(), cprover_cpp_library_factory);
+      link_to_library(
+        goto_model, log.get_message_handler(), cprover_c_library_factory);
+    }
 
     if(options.get_bool_option("string-abstraction"))
       string_instrumentation(goto_model, log.get_message_handler());
@@ -803,10 +1063,16 @@ bool cbmc_parse_optionst::process_goto_program(
     // remove function pointers
     log.status() << "Removal of function pointers and virtual functions"
                  << messaget::eom;
-    remove_function_pointers(
-      log.get_message_handler(),
-      goto_model,
-      options.get_bool_option("pointer-check"));
+    {
+      trace_spant remove_span("remove_function_pointers");
+      remove_function_pointers(
+        log.get_message_handler(),
+        goto_model,
+        options.get_bool_option("pointer-check"));
+    }
+
+    validation_options.function_pointer_calls_removed = true;
+    validate_stage("removing function pointers");
 
     mm_io(goto_model);
 
@@ -814,17 +1080,27 @@ bool cbmc_parse_optionst::process_goto_program(
     instrument_preconditions(goto_model);
 
     // remove returns, gcc vectors, complex
-    remove_returns(goto_model);
-    remove_vector(goto_model);
-    remove_complex(goto_model);
-    rewrite_union(goto_model);
+    {
+      trace_spant lowering_span("lowering");
+      remove_returns(goto_model, jobs);
+      remove_vector(goto_model, jobs);
+      remove_complex(goto_model, jobs);
+      rewrite_union(goto_model, jobs);
+    }
+
+    validation_options.check_returns_removed = true;
+    validate_stage("lowering");
 
     // add generic checks
     log.status() << "Generic Property Instrumentation" << messaget::eom;
-    goto_check(options, goto_model);
+    {
+      trace_spant check_span("goto_check");
+      goto_check(options, goto_model, jobs);
+    }
 
     // checks don't know about adjusted float expressions
-    adjust_float_expressions(goto_model);
+    adjust_float_expressions(goto_model, jobs);
+    validate_stage("property instrumentation");
 
     // ignore default/user-specified initialization
     // of variables with static lifetime
@@ -851,21 +1127,24 @@ bool cbmc_parse_optionst::process_goto_program(
 
     // add loop ids
     goto_model.goto_functions.compute_loop_numbers();
+    validate_stage("adding failed symbols");
 
     if(options.get_bool_option("drop-unused-functions"))
     {
       // Entry point will have been set before and function pointers removed
       log.status() << "Removing unused functions" << messaget::eom;
+      trace_spant remove_span("remove_unused_functions");
       remove_unused_functions(goto_model, log.get_message_handler());
     }
 
     // remove skips such that trivial GOTOs are deleted and not considered
     // for coverage annotation:
-    remove_skip(goto_model);
+    remove_skip(goto_model, jobs);
 
     // instrument cover goals
     if(options.is_set("cover"))
     {
+      trace_spant cover_span("instrument_cover_goals");
       const auto cover_config = get_cover_config(
         options, goto_model.symbol_table, log.get_message_handler());
       if(instrument_cover_goals(
@@ -873,6 +1152,8 @@ bool cbmc_parse_optionst::process_goto_program(
         return true;
     }
 
+    validate_stage("coverage instrumentation and removing skips");
+
     // label the assertions
     // This must be done after adding assertions and
     // before using the argument of the "property" option.
@@ -885,6 +1166,7 @@ bool cbmc_parse_optionst::process_goto_program(
     {
       log.status() << "Performing a forwards-backwards reachability slice"
                    << messaget::eom;
+      trace_spant slice_span("reachability_slicer");
       if(options.is_set("property"))
         reachability_slicer(
           goto_model, options.get_list_option("property"), true);
@@ -895,6 +1177,7 @@ bool cbmc_parse_optionst::process_goto_program(
     if(options.get_bool_option("reachability-slice"))
     {
       log.status() << "Performing a reachability slice" << messaget::eom;
+      trace_spant slice_span("reachability_slicer");
       if(options.is_set("property"))
         reachability_slicer(goto_model, options.get_list_option("property"));
       else
@@ -905,6 +1188,7 @@ bool cbmc_parse_optionst::process_goto_program(
     if(options.get_bool_option("full-slice"))
     {
       log.status() << "Performing a full slice" << messaget::eom;
+      trace_spant slice_span("full_slicer");
       if(options.is_set("property"))
         property_slicer(goto_model, options.get_list_option("property"));
       else
@@ -915,6 +1199,114 @@ bool cbmc_parse_optionst::process_goto_program(
     remove_skip(goto_model);
   }
 
+  memory_report().snapshot("process_goto_program");
+
+  return false;
+}
+
+void cbmc_parse_optionst::process_goto_function(
+  goto_model_functiont &function,
+  const abstract_goto_modelt &model,
+  const optionst &options)
+{
+  trace_spant span(
+    "process_goto_function " + id2string(function.get_function_id()),
+    "process_goto_program");
+
+  journalling_symbol_tablet &symbol_table = function.get_symbol_table();
+  const namespacet ns(symbol_table);
+  goto_functionst::goto_functiont &goto_function = function.get_goto_function();
+
+  // Removing function pointers requires knowing all functions whose address
+  // is taken, which we don't know before symbolic execution has finished.
+  // Inline assembler is replaced by calls to library functions, which have
+  // to be added before symbolic execution starts.
+  for(const auto &instruction : goto_function.body.instructions)
+  {
+    if(
+      instruction.is_function_call() &&
+      instruction.get_function_call().function().id() != ID_symbol)
+    {
+      throw incorrect_goto_program_exceptiont(
+        "function pointer calls are not supported with "
+        "--symex-driven-lazy-loading, remove them first using "
+        "goto-instrument --remove-function-pointers",
+        instruction.source_location);
+    }
+    else if(
+      instruction.is_other() &&
+      instruction.get_other().get_statement() == ID_asm)
+    {
+      throw incorrect_goto_program_exceptiont(
+        "inline assembler is not supported with "
+        "--symex-driven-lazy-loading, remove it first using "
+        "goto-instrument --remove-function-pointers",
+        instruction.source_location);
+    }
+  }
+
+  mm_io(function);
+
+  const goto_functionst::function_mapt &function_map =
+    model.get_goto_functions().function_map;
+  auto function_is_stub = [&symbol_table, &model, &function_map](
+                            const irep_idt &id) {
+    const auto f_it = function_map.find(id);
+    return symbol_table.lookup_ref(id).value.is_nil() &&
+           !model.can_produce_function(id) &&
+           (f_it == function_map.end() || !f_it->second.body_available());
+  };
+
+  // remove returns, gcc vectors, complex
+  remove_returns(function, function_is_stub);
+  remove_vector(function);
+  remove_complex(function);
+  rewrite_union(goto_function);
+
+  // add generic checks
+  goto_check(function.get_function_id(), goto_function, ns, options);
+
+  // checks don't know about adjusted float expressions
+  adjust_float_expressions(goto_function, ns);
+
+  // add failed symbols for anything created relating to this particular
+  // function (note this means subsequent passes mustn't create more!):
+  for(const irep_idt &new_symbol_name : symbol_table.get_inserted())
+  {
+    add_failed_symbol_if_needed(
+      symbol_table.lookup_ref(new_symbol_name), symbol_table);
+  }
+
+  remove_skip(goto_function.body);
+
+  // label the assertions now so that symex sees its targets
+  label_properties(goto_function.body);
+
+  goto_function.body.update();
+  function.compute_location_numbers();
+  goto_function.body.compute_loop_numbers();
+}
+
+bool cbmc_parse_optionst::process_goto_functions(
+  goto_modelt &,
+  const optionst &)
+{
+  // With symex-driven lazy loading all processing is done by
+  // process_goto_function.
+  return false;
+}
+
+bool cbmc_parse_optionst::can_generate_function_body(const irep_idt &)
+{
+  return false;
+}
+
+bool cbmc_parse_optionst::generate_function_body(
+  const irep_idt &,
+  symbol_table_baset &,
+  goto_functiont &,
+  bool)
+{
   return false;
 }
 
@@ -1006,6 +1398,10 @@ void cbmc_parse_optionst::help()
     "\n"
     "BMC options:\n"
     HELP_BMC
+    " --symex-driven-lazy-loading  only convert and instrument functions when\n"
+    "                              first entered by symbolic execution; calls\n"
+    "                              through function pointers and inline\n"
+    "                              assembler must have been removed beforehand\n"
     "\n"
     "Backend options:\n"
     " --object-bits n              number of bits used for object addresses\n"
@@ -1032,10 +1428,16 @@ void cbmc_parse_optionst::help()
     " --json-ui                    use JSON-formatted output\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     HELP_VALIDATE
+    " --validate-each-pass         check the goto program after each stage of\n"
+    "                              instrumentation, re-checking only the\n"
+    "                              functions the stage has changed\n"
     HELP_GOTO_TRACE
     HELP_FLUSH
+    HELP_JOBS
+    "                              with --paths, explore paths with N threads\n"
     " --verbosity #                verbosity level\n"
     HELP_TIMESTAMP
+    HELP_RUN_REPORTS
     "\n";
   // clang-format on
 }
@@ -12,10 +12,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_CBMC_CBMC_PARSE_OPTIONS_H
 #define CPROVER_CBMC_CBMC_PARSE_OPTIONS_H
 
+#include <memory>
+
 #include <ansi-c/ansi_c_language.h>
 #include <ansi-c/c_object_factory_parameters.h>
 
 #include <util/parse_options.h>
+#include <util/parallel_for.h>
+#include <util/run_reports.h>
 #include <util/timestamper.h>
 #include <util/ui_message.h>
 #include <util/validation_interface.h>
@@ -34,6 +38,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "xml_interface.h"
 
 class goto_functionst;
+class lazy_goto_modelt;
 class optionst;
 
 // clang-format off
@@ -69,15 +74,19 @@ class optionst;
   "(cover):(symex-coverage-report):" \
   "(mm):" \
   OPT_TIMESTAMP \
+  OPT_RUN_REPORTS \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)(gcc)" \
   "(ppc-macos)(unsigned-char)" \
   "(arrays-uf-always)(arrays-uf-never)" \
   "(string-abstraction)(no-arch)(arch):" \
   "(round-to-nearest)(round-to-plus-inf)(round-to-minus-inf)(round-to-zero)" \
   OPT_FLUSH \
+  OPT_JOBS \
   "(localize-faults)" \
+  "(symex-driven-lazy-loading)" \
   OPT_GOTO_TRACE \
   OPT_VALIDATE \
+  "(validate-each-pass)" \
   OPT_ANSI_C_LANGUAGE \
   "(claim):(show-claims)(floatbv)(all-claims)(all-properties)" // legacy, and will eventually disappear // NOLINT(whitespace/line_length)
 // clang-format on
@@ -108,9 +117,27 @@ public:
     const cmdlinet &,
     ui_message_handlert &);
 
+  void process_goto_function(
+    goto_model_functiont &,
+    const abstract_goto_modelt &,
+    const optionst &);
+  bool process_goto_functions(goto_modelt &, const optionst &);
+
+  bool can_generate_function_body(const irep_idt &name);
+
+  bool generate_function_body(
+    const irep_idt &function_name,
+    symbol_table_baset &symbol_table,
+    goto_functiont &function,
+    bool body_available);
+
 protected:
   goto_modelt goto_model;
 
+  int get_lazy_goto_program(
+    std::unique_ptr<lazy_goto_modelt> &,
+    const optionst &);
+
   void register_languages();
   void get_command_line_options(optionst &);
   void preprocessing(const optionst &);
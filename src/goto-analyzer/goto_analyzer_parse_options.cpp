@@ -311,6 +311,12 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
   {
     options.set_option("validate-goto-model", true);
   }
+
+  if(cmdline.isset("jobs"))
+    options.set_option("jobs", cmdline.get_value("jobs"));
+
+  if(cmdline.isset("simplify-cache"))
+    options.set_option("simplify-cache", cmdline.get_value("simplify-cache"));
 }
 
 /// For the task, build the appropriate kind of analyzer
@@ -327,7 +333,14 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     if(options.get_bool_option("constants"))
     {
       // constant_propagator_ait derives from ait<constant_propagator_domaint>
-      domain=new constant_propagator_ait(goto_model.goto_functions);
+      auto constant_propagator =
+        new constant_propagator_ait(goto_model.goto_functions);
+      if(options.is_set("simplify-cache"))
+      {
+        constant_propagator->enable_simplify_cache(
+          ns, options.get_unsigned_int_option("simplify-cache"));
+      }
+      domain = constant_propagator;
     }
     else if(options.get_bool_option("dependence-graph"))
     {
@@ -593,6 +606,17 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
     log.status() << "Computing abstract states" << messaget::eom;
     (*analyzer)(goto_model);
 
+    const auto constant_propagator =
+      dynamic_cast<const constant_propagator_ait *>(analyzer.get());
+    if(constant_propagator != nullptr && options.is_set("simplify-cache"))
+    {
+      log.statistics() << "Simplifier cache: "
+                       << constant_propagator->simplify_cache_hits()
+                       << " hits, "
+                       << constant_propagator->simplify_cache_misses()
+                       << " misses" << messaget::eom;
+    }
+
     // Perform the task
     log.status() << "Performing task" << messaget::eom;
 
@@ -686,9 +710,10 @@ bool goto_analyzer_parse_optionst::process_goto_program(
     goto_partial_inline(goto_model, ui_message_handler);
 
     // remove returns, gcc vectors, complex
-    remove_returns(goto_model);
-    remove_vector(goto_model);
-    remove_complex(goto_model);
+    const std::size_t jobs = options.get_unsigned_int_option("jobs");
+    remove_returns(goto_model, jobs);
+    remove_vector(goto_model, jobs);
+    remove_complex(goto_model, jobs);
 
 #if 0
     // add generic checks
@@ -745,6 +770,8 @@ void goto_analyzer_parse_optionst::help()
     " --intervals                  interval domain\n"
     " --non-null                   non-null domain\n"
     " --dependence-graph           data and control dependencies between instructions\n" // NOLINT(*)
+    " --simplify-cache n           memoize up to n simplification results of\n"
+    "                              the constant domain\n"
     "\n"
     "Output options:\n"
     " --text file_name             output results in plain text to given file\n"
@@ -802,7 +829,9 @@ void goto_analyzer_parse_optionst::help()
     HELP_VALIDATE
     " --version                    show version and exit\n"
     HELP_FLUSH
+    HELP_JOBS
     HELP_TIMESTAMP
+    HELP_RUN_REPORTS
     "\n";
   // clang-format on
 }
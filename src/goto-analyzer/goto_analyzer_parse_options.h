@@ -102,6 +102,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_GOTO_ANALYZER_GOTO_ANALYZER_PARSE_OPTIONS_H
 
 #include <util/parse_options.h>
+#include <util/parallel_for.h>
+#include <util/run_reports.h>
 #include <util/timestamper.h>
 #include <util/ui_message.h>
 #include <util/validation_interface.h>
@@ -139,7 +141,9 @@ class optionst;
   "(json):(xml):" \
   "(text):(dot):" \
   OPT_FLUSH \
+  OPT_JOBS \
   OPT_TIMESTAMP \
+  OPT_RUN_REPORTS \
   "(unreachable-instructions)(unreachable-functions)" \
   "(reachable-functions)" \
   "(intervals)(show-intervals)" \
@@ -150,6 +154,7 @@ class optionst;
   "(show-on-source)" \
   "(location-sensitive)(concurrent)" \
   "(no-simplify-slicing)" \
+  "(simplify-cache):" \
   OPT_VALIDATE \
 // clang-format on
 
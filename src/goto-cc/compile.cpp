@@ -34,6 +34,7 @@ Date: June 2006
 
 #include <goto-programs/goto_convert.h>
 #include <goto-programs/goto_convert_functions.h>
+#include <goto-programs/indexed_goto_binary.h>
 #include <goto-programs/name_mangler.h>
 #include <goto-programs/read_goto_binary.h>
 #include <goto-programs/validate_goto_model.h>
@@ -311,10 +312,13 @@ bool compilet::link()
   convert_symbols(goto_model.goto_functions);
 
   // parse object files
-  for(const auto &file_name : object_files)
+  if(read_objects_and_link(
+       std::vector<std::string>(object_files.begin(), object_files.end()),
+       goto_model,
+       get_message_handler(),
+       jobs))
   {
-    if(read_object_and_link(file_name, goto_model, get_message_handler()))
-      return true;
+    return true;
   }
 
   // produce entry point?
@@ -575,7 +579,18 @@ bool compilet::write_bin_object_file(
     return true;
   }
 
-  if(write_goto_binary(outfile, src_goto_model))
+  if(compress_goto_binary)
+  {
+    if(write_indexed_goto_binary(
+         outfile,
+         src_goto_model.symbol_table,
+         src_goto_model.goto_functions,
+         true))
+    {
+      return true;
+    }
+  }
+  else if(write_goto_binary(outfile, src_goto_model))
     return true;
 
   const auto cnt = function_body_count(src_goto_model.goto_functions);
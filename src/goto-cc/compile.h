@@ -35,6 +35,8 @@ public:
   std::string working_directory;
   std::string override_language;
   bool validate_goto_model = false;
+  bool compress_goto_binary = false;
+  std::size_t jobs = 1;
 
   enum { PREPROCESS_ONLY, // gcc -E
          COMPILE_ONLY, // gcc -c
@@ -40,6 +40,7 @@ Author: CM Wintersteiger, 2006
 #include <util/prefix.h>
 #include <util/replace_symbol.h>
 #include <util/run.h>
+#include <util/string2int.h>
 #include <util/suffix.h>
 #include <util/tempdir.h>
 #include <util/tempfile.h>
@@ -426,6 +427,11 @@ int gcc_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  compiler.compress_goto_binary = cmdline.isset("compress-goto-binary");
+
+  if(cmdline.isset("jobs"))
+    compiler.jobs = unsafe_string2size_t(cmdline.get_value("jobs"));
+
   // determine actions to be undertaken
   if(cmdline.isset('S'))
     compiler.mode=compilet::ASSEMBLE_ONLY;
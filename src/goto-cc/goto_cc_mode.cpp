@@ -66,6 +66,9 @@ void goto_cc_modet::help()
   " --native-assembler cmd      command to invoke as assembler (goto-as only)\n"
   " --print-rejected-preprocessed-source file\n"
   "                             copy failing (preprocessed) source to file\n"
+  " --compress-goto-binary      write goto binaries with compressed sections\n"
+  " --jobs N                    use up to N threads to read and link object\n"
+  "                             files (default: 1)\n"
   "\n";
   // clang-format on
 }
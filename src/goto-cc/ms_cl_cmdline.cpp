@@ -47,7 +47,9 @@ const char *non_ms_cl_options[]=
   "--function",
   "--validate-goto-model",
   "--export-function-local-symbols",
+  "--compress-goto-binary",
   "--mangle-suffix",
+  "--jobs",
   nullptr
 };
 // clang-format on
@@ -61,7 +63,9 @@ bool ms_cl_cmdlinet::parse(const std::vector<std::string> &arguments)
     {
       process_non_cl_option(arguments[i]);
 
-      if(arguments[i] == "--verbosity" || arguments[i] == "--function")
+      if(
+        arguments[i] == "--verbosity" || arguments[i] == "--function" ||
+        arguments[i] == "--jobs")
       {
         if(i < arguments.size() - 1)
         {
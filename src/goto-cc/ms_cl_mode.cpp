@@ -26,6 +26,7 @@ Author: CM Wintersteiger, 2006
 #include <util/get_base_name.h>
 #include <util/message.h>
 #include <util/prefix.h>
+#include <util/string2int.h>
 
 #include "compile.h"
 #include "ms_cl_version.h"
@@ -68,6 +69,11 @@ int ms_cl_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  compiler.compress_goto_binary = cmdline.isset("compress-goto-binary");
+
+  if(cmdline.isset("jobs"))
+    compiler.jobs = unsafe_string2size_t(cmdline.get_value("jobs"));
+
   // get configuration
   config.set(cmdline);
 
@@ -28,6 +28,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include <solvers/prop/prop_conv.h>
 
 #include <util/make_unique.h>
+#include <util/merge_irep.h>
 #include <util/ui_message.h>
 
 #include "goto_symex_property_decider.h"
@@ -78,12 +79,12 @@ void output_error_trace(
     break;
 
   case ui_message_handlert::uit::XML_UI:
-  {
-    xmlt xml;
-    convert(ns, goto_trace, xml);
-    msg.status() << xml;
-  }
-  break;
+    convert(
+      ns,
+      goto_trace,
+      ui_message_handler.new_xml_stream(messaget::M_STATUS, "goto_trace"));
+    ui_message_handler.close_xml_stream();
+    break;
 
   case ui_message_handlert::uit::JSON_UI:
   {
@@ -193,6 +194,9 @@ void setup_symex(
 
   symex.unwindset.parse_unwind(options.get_option("unwind"));
   symex.unwindset.parse_unwindset(options.get_option("unwindset"));
+
+  if(options.get_bool_option("hash-cons-ireps"))
+    get_hash_consing_irep().enable();
 }
 
 void slice(
@@ -253,7 +257,8 @@ void update_properties_status_from_symex_target_equation(
     const auto status = step.cond_expr.is_true() ? property_statust::PASS
                                                  : property_statust::UNKNOWN;
     auto emplace_result = properties.emplace(
-      property_id, property_infot{step.source.pc, step.comment, status});
+      property_id,
+      property_infot{step.source.pc, id2string(step.comment), status});
 
     if(emplace_result.second)
     {
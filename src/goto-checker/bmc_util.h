@@ -176,6 +176,9 @@ void run_property_decider(
   "(show-loops)" \
   "(show-vcc)" \
   "(slice-formula)" \
+  "(hash-cons-ireps)" \
+  "(stream-ssa)" \
+  "(simplify-cache):" \
   "(unwinding-assertions)" \
   "(no-unwinding-assertions)" \
   "(no-pretty-names)" \
@@ -200,6 +203,11 @@ void run_property_decider(
   "                              (use --show-loops to get the loop IDs)\n" \
   " --show-vcc                   show the verification conditions\n" \
   " --slice-formula              remove assignments unrelated to property\n" \
+  " --hash-cons-ireps            share structurally equal expressions across\n" \
+  "                              all equations in a global unique table\n" \
+  " --stream-ssa                 convert the equation to the solver while\n" \
+  "                              running symex, releasing converted steps\n" \
+  " --simplify-cache n           memoize up to n simplification results\n" \
   " --unwinding-assertions       generate unwinding assertions (cannot be\n" \
   "                              used with --cover or --partial-loops)\n" \
   " --partial-loops              permit paths with partial loops\n" \
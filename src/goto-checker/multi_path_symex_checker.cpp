@@ -13,6 +13,8 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <chrono>
 
+#include <util/memory_report.h>
+
 #include "bmc_util.h"
 #include "counterexample_beautification.h"
 #include "goto_symex_fault_localizer.h"
@@ -25,6 +27,15 @@ multi_path_symex_checkert::multi_path_symex_checkert(
     equation_generated(false),
     property_decider(options, ui_message_handler, equation, ns)
 {
+  if(options.get_bool_option("stream-ssa"))
+  {
+    // A correctness witness is built from the right-hand sides of the steps,
+    // hence these must be kept.
+    const bool release_steps = options.get_option("graphml-witness").empty();
+    symex.add_step_handler([this, release_steps]() {
+      equation.convert_new_steps(property_decider.get_solver(), release_steps);
+    });
+  }
 }
 
 incremental_goto_checkert::resultt multi_path_symex_checkert::
@@ -39,9 +50,18 @@ operator()(propertiest &properties)
 
   std::chrono::duration<double> solver_runtime(0);
 
+  const bool first_run = !equation_generated;
+
   // we haven't got an equation yet
-  if(!equation_generated)
+  if(first_run)
   {
+    if(options.get_bool_option("stream-ssa"))
+    {
+      log.status() << "Passing problem to "
+                   << property_decider.get_solver().decision_procedure_text()
+                   << " while running symex" << messaget::eom;
+    }
+
     generate_equation();
 
     output_coverage_report(
@@ -63,16 +83,37 @@ operator()(propertiest &properties)
 
   run_property_decider(result, properties, solver_runtime);
 
+  // later runs only decide the remaining properties of the same equation
+  if(first_run)
+    memory_report().snapshot("dec_solve");
+
   return result;
 }
 
 std::chrono::duration<double>
 multi_path_symex_checkert::prepare_property_decider(propertiest &properties)
 {
-  std::chrono::duration<double> solver_runtime = ::prepare_property_decider(
-    properties, equation, property_decider, ui_message_handler);
+  if(!options.get_bool_option("stream-ssa"))
+  {
+    std::chrono::duration<double> solver_runtime = ::prepare_property_decider(
+      properties, equation, property_decider, ui_message_handler);
+    memory_report().snapshot("convert_SSA");
+
+    return solver_runtime;
+  }
+
+  // the steps have mostly been converted while running symex
+  auto solver_start = std::chrono::steady_clock::now();
+
+  equation.finish_conversion(property_decider.get_solver());
+  property_decider.update_properties_goals_from_symex_target_equation(
+    properties);
+  property_decider.convert_goals();
+  property_decider.freeze_goal_variables();
+  memory_report().snapshot("convert_SSA");
 
-  return solver_runtime;
+  auto solver_stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(solver_stop - solver_start);
 }
 
 void multi_path_symex_checkert::run_property_decider(
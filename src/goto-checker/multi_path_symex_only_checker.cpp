@@ -12,6 +12,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include "multi_path_symex_only_checker.h"
 
 #include <util/invariant.h>
+#include <util/memory_report.h>
 
 #include <goto-symex/memory_model.h>
 #include <goto-symex/show_program.h>
@@ -68,6 +69,7 @@ void multi_path_symex_only_checkert::generate_equation()
 {
   symex.symex_from_entry_point_of(
     goto_symext::get_goto_function(goto_model), symex_symbol_table);
+  memory_report().snapshot("symex");
   postprocess_equation(symex, equation, options, ns, ui_message_handler);
 }
 
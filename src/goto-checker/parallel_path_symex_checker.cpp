@@ -0,0 +1,367 @@
+/*******************************************************************\
+
+Module: Goto Checker using Parallel Path Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Parallel Path Symbolic Execution
+
+#include "parallel_path_symex_checker.h"
+
+#include <algorithm>
+
+#include <util/make_unique.h>
+#include <util/parallel_for.h>
+
+#include <goto-symex/show_program.h>
+#include <goto-symex/show_vcc.h>
+
+#include "bmc_util.h"
+#include "counterexample_beautification.h"
+#include "goto_symex_property_decider.h"
+#include "symex_bmc.h"
+
+/// The state of one thread: the symbols generated by symbolic execution of
+/// its current path, its messages and its path storage
+struct parallel_path_symex_checkert::workert
+{
+  workert(parallel_path_symex_checkert &checker, std::size_t index)
+    : ns(checker.goto_model.get_symbol_table(), symbol_table),
+      ui_message_handler(checker.synchronized_message_handler),
+      path_storage(checker.pool, index)
+  {
+    ui_message_handler.set_verbosity(
+      checker.ui_message_handler.get_verbosity());
+  }
+
+  symbol_tablet symbol_table;
+  namespacet ns;
+  guard_managert guard_manager;
+  ui_message_handlert ui_message_handler;
+  path_work_stealingt path_storage;
+};
+
+parallel_path_symex_checkert::parallel_path_symex_checkert(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  abstract_goto_modelt &goto_model)
+  : incremental_goto_checkert(options, ui_message_handler),
+    goto_model(goto_model),
+    ns(goto_model.get_symbol_table(), symex_symbol_table),
+    number_of_workers(std::max(options.get_unsigned_int_option("jobs"), 1u)),
+    synchronized_message_handler(ui_message_handler),
+    pool(
+      number_of_workers,
+      options.get_option("exploration-strategy") == "lifo")
+{
+  for(std::size_t i = 0; i < number_of_workers; ++i)
+  {
+    workers.push_back(util_make_unique<workert>(*this, i));
+    if(i > 0)
+      workers[i]->path_storage.share_fresh_names_with(workers[0]->path_storage);
+  }
+}
+
+parallel_path_symex_checkert::~parallel_path_symex_checkert() = default;
+
+incremental_goto_checkert::resultt parallel_path_symex_checkert::
+operator()(propertiest &properties)
+{
+  resultt result(resultt::progresst::DONE);
+
+  // All paths are explored by the first call.
+  if(explored)
+    return result;
+  explored = true;
+
+  // Put the initial state into the deque of the first thread; the others
+  // will steal it or the paths it leads to.
+  {
+    workert &first = *workers.front();
+    symex_target_equationt equation(first.ui_message_handler);
+    symex_bmct symex(
+      first.ui_message_handler,
+      goto_model.get_symbol_table(),
+      equation,
+      options,
+      first.path_storage,
+      first.guard_manager);
+    setup_symex(symex, first);
+
+    symex.initialize_path_storage_from_entry_point_of(
+      goto_symext::get_goto_function(goto_model), first.symbol_table);
+  }
+
+  parallel_for(
+    number_of_workers,
+    number_of_workers,
+    [this, &properties, &result](std::size_t index) {
+      try
+      {
+        explore(*workers[index], properties, result.updated_properties);
+      }
+      catch(...)
+      {
+        // don't leave the other threads waiting for paths
+        pool.stop();
+        throw;
+      }
+    });
+
+  if(!stopped_on_failure)
+  {
+    // For now, we assume that NOT_CHECKED and UNKNOWN properties are PASS.
+    update_status_of_not_checked_properties(
+      properties, result.updated_properties);
+    update_status_of_unknown_properties(properties, result.updated_properties);
+  }
+
+  if(first_trace)
+    result.progress = resultt::progresst::FOUND_FAIL;
+
+  return result;
+}
+
+void parallel_path_symex_checkert::explore(
+  workert &worker,
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  while(worker.path_storage.take_next())
+  {
+    path_storaget::patht &path = worker.path_storage.peek();
+
+    symex_bmct symex(
+      worker.ui_message_handler,
+      goto_model.get_symbol_table(),
+      path.equation,
+      options,
+      worker.path_storage,
+      worker.guard_manager);
+    setup_symex(symex, worker);
+
+    symex.resume_symex_from_saved_state(
+      goto_symext::get_goto_function(goto_model),
+      path.state,
+      &path.equation,
+      worker.symbol_table);
+    postprocess_equation(
+      symex,
+      path.equation,
+      options,
+      worker.ns,
+      worker.ui_message_handler);
+
+    equation_output(worker, symex, path.equation);
+
+    if(symex.get_remaining_vccs() > 0)
+      decide(worker, path, properties, updated_properties);
+
+    worker.path_storage.pop();
+
+    if(!options.get_bool_option("paths-symex-explore-all"))
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if(!has_properties_to_check(properties))
+        pool.stop();
+    }
+  }
+}
+
+void parallel_path_symex_checkert::decide(
+  workert &worker,
+  path_storaget::patht &path,
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  // Decide on a copy of the properties, such that the solver runs without
+  // holding the lock; only the results are merged.
+  propertiest local_properties;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    update_properties_status_from_symex_target_equation(
+      properties, updated_properties, path.equation);
+    local_properties = properties;
+  }
+
+  goto_symex_property_decidert property_decider(
+    options, worker.ui_message_handler, path.equation, worker.ns);
+
+  std::chrono::duration<double> solver_runtime = ::prepare_property_decider(
+    local_properties,
+    path.equation,
+    property_decider,
+    worker.ui_message_handler);
+
+  const bool stop_on_fail = options.get_bool_option("stop-on-fail");
+
+  while(true)
+  {
+    resultt local_result(resultt::progresst::DONE);
+    ::run_property_decider(
+      local_result,
+      local_properties,
+      property_decider,
+      worker.ui_message_handler,
+      solver_runtime,
+      false);
+    solver_runtime = std::chrono::duration<double>(0);
+
+    std::vector<irep_idt> new_failures;
+    bool need_first_trace;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for(const auto &property_id : local_result.updated_properties)
+      {
+        property_statust &status = properties.at(property_id).status;
+        if(!is_property_to_check(status))
+          continue;
+
+        status |= local_properties.at(property_id).status;
+        updated_properties.insert(property_id);
+        if(status == property_statust::FAIL)
+          new_failures.push_back(property_id);
+      }
+      need_first_trace = !first_trace && !new_failures.empty();
+    }
+
+    if(local_result.progress != resultt::progresst::FOUND_FAIL)
+      break;
+
+    if(new_failures.empty())
+      continue;
+
+    // Traces refer to the solver of this thread, build them before solving
+    // again and without holding the lock.
+    std::map<irep_idt, goto_tracet> new_traces;
+    if(options.get_bool_option("trace"))
+    {
+      for(const auto &property_id : new_failures)
+      {
+        build_goto_trace(
+          path.equation,
+          ssa_step_matches_failing_property(property_id),
+          property_decider.get_solver(),
+          worker.ns,
+          new_traces[property_id]);
+      }
+    }
+
+    std::unique_ptr<goto_tracet> new_first_trace;
+    if(need_first_trace)
+    {
+      // beautification adds constraints, only do this if we won't solve
+      // again
+      if(stop_on_fail && options.get_bool_option("beautify"))
+      {
+        // NOLINTNEXTLINE(whitespace/braces)
+        counterexample_beautificationt{worker.ui_message_handler}(
+          dynamic_cast<boolbvt &>(property_decider.get_solver()),
+          path.equation);
+      }
+
+      new_first_trace = util_make_unique<goto_tracet>();
+      build_goto_trace(
+        path.equation,
+        property_decider.get_solver(),
+        worker.ns,
+        *new_first_trace);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for(auto &trace_pair : new_traces)
+        traces.emplace(trace_pair.first, std::move(trace_pair.second));
+      if(new_first_trace && !first_trace)
+        first_trace = std::move(new_first_trace);
+
+      // the traces may refer to symbols generated for this path
+      for(const auto &named_symbol : worker.symbol_table.symbols)
+        symex_symbol_table.insert(named_symbol.second);
+
+      if(stop_on_fail)
+      {
+        stopped_on_failure = true;
+        pool.stop();
+        return;
+      }
+    }
+  }
+
+  if(!options.get_option("graphml-witness").empty())
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    last_equation = util_make_unique<symex_target_equationt>(path.equation);
+  }
+}
+
+void parallel_path_symex_checkert::setup_symex(
+  symex_bmct &symex,
+  workert &worker)
+{
+  ::setup_symex(symex, worker.ns, options, worker.ui_message_handler);
+}
+
+void parallel_path_symex_checkert::equation_output(
+  workert &worker,
+  const symex_bmct &symex,
+  const symex_target_equationt &equation)
+{
+  if(options.get_bool_option("validate-ssa-equation"))
+    symex.validate(validation_modet::INVARIANT);
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  output_coverage_report(
+    options.get_option("symex-coverage-report"),
+    goto_model,
+    symex,
+    ui_message_handler);
+
+  if(options.get_bool_option("show-vcc"))
+    show_vcc(options, ui_message_handler, equation);
+
+  if(options.get_bool_option("program-only"))
+    show_program(worker.ns, equation);
+}
+
+goto_tracet parallel_path_symex_checkert::build_full_trace() const
+{
+  PRECONDITION(first_trace);
+  return *first_trace;
+}
+
+goto_tracet parallel_path_symex_checkert::build_shortest_trace() const
+{
+  PRECONDITION(first_trace);
+  return *first_trace;
+}
+
+goto_tracet
+parallel_path_symex_checkert::build_trace(const irep_idt &property_id) const
+{
+  const auto trace_it = traces.find(property_id);
+  PRECONDITION(trace_it != traces.end());
+  return trace_it->second;
+}
+
+const namespacet &parallel_path_symex_checkert::get_namespace() const
+{
+  return ns;
+}
+
+void parallel_path_symex_checkert::output_error_witness(
+  const goto_tracet &goto_trace)
+{
+  output_graphml(goto_trace, ns, options);
+}
+
+void parallel_path_symex_checkert::output_proof()
+{
+  // This is incorrect, but the best we can do at the moment.
+  if(last_equation)
+    output_graphml(*last_equation, ns, options);
+}
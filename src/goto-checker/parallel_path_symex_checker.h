@@ -0,0 +1,110 @@
+/*******************************************************************\
+
+Module: Goto Checker using Parallel Path Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Parallel Path Symbolic Execution
+
+#ifndef CPROVER_GOTO_CHECKER_PARALLEL_PATH_SYMEX_CHECKER_H
+#define CPROVER_GOTO_CHECKER_PARALLEL_PATH_SYMEX_CHECKER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <goto-programs/goto_trace.h>
+
+#include <goto-symex/path_work_stealing.h>
+
+#include "goto_trace_provider.h"
+#include "incremental_goto_checker.h"
+#include "witness_provider.h"
+
+class symex_bmct;
+
+/// Uses goto-symex to symbolically execute each path in the goto model and
+/// calls a solver to find property violations, like
+/// \ref single_path_symex_checkert, but explores paths with several threads
+/// (option `jobs`). Each thread has its own symbolic execution engine and
+/// solver. Threads take the paths to resume from a \ref path_work_poolt: each
+/// follows its own paths in the order given by the exploration strategy and
+/// steals paths from other threads when it runs out of work. The results of
+/// all threads are collected into the properties passed to the first call of
+/// \ref operator(), which explores all paths; a second call returns DONE.
+class parallel_path_symex_checkert : public incremental_goto_checkert,
+                                     public witness_providert,
+                                     public goto_trace_providert
+{
+public:
+  parallel_path_symex_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model);
+
+  resultt operator()(propertiest &) override;
+
+  /// Returns the trace of the first failure found
+  goto_tracet build_full_trace() const override;
+  /// Returns the trace of the first failure found
+  goto_tracet build_shortest_trace() const override;
+  goto_tracet build_trace(const irep_idt &) const override;
+  const namespacet &get_namespace() const override;
+
+  void output_error_witness(const goto_tracet &) override;
+  void output_proof() override;
+
+  virtual ~parallel_path_symex_checkert();
+
+protected:
+  struct workert;
+
+  abstract_goto_modelt &goto_model;
+  /// Symbols generated by the threads for the stored traces
+  symbol_tablet symex_symbol_table;
+  namespacet ns;
+  const std::size_t number_of_workers;
+  bool explored = false;
+
+  /// Serializes all messages of the threads
+  synchronized_message_handlert synchronized_message_handler;
+  path_work_poolt pool;
+  std::vector<std::unique_ptr<workert>> workers;
+
+  /// Guards all members below as well as the properties and
+  /// \ref symex_symbol_table while the threads run
+  std::mutex mutex;
+  bool stopped_on_failure = false;
+  std::unique_ptr<goto_tracet> first_trace;
+  std::map<irep_idt, goto_tracet> traces;
+  /// The last equation that has been checked, for \ref output_proof
+  std::unique_ptr<symex_target_equationt> last_equation;
+
+  virtual void setup_symex(symex_bmct &symex, workert &worker);
+
+  /// Resume paths taken from \ref pool with the engine and solver of
+  /// \p worker until there are no more paths to explore, updating
+  /// \p properties and \p updated_properties
+  void explore(
+    workert &worker,
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties);
+
+  /// Checks the properties in \p path against the solver of \p worker
+  /// and updates \p properties with the results
+  void decide(
+    workert &worker,
+    path_storaget::patht &path,
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties);
+
+  void equation_output(
+    workert &worker,
+    const symex_bmct &symex,
+    const symex_target_equationt &equation);
+};
+
+#endif // CPROVER_GOTO_CHECKER_PARALLEL_PATH_SYMEX_CHECKER_H
@@ -328,15 +328,17 @@ void output_properties_with_traces(
   {
     for(const auto &property_pair : properties)
     {
-      xmlt xml_result = xml(property_pair.first, property_pair.second);
+      const xmlt xml_property = xml(property_pair.first, property_pair.second);
+      xml_streamt &xml_result = ui_message_handler.new_xml_stream(
+        messaget::M_RESULT, xml_property.name, xml_property.attributes);
       if(property_pair.second.status == property_statust::FAIL)
       {
         convert(
           traces.get_namespace(),
           traces[property_pair.first],
-          xml_result.new_element());
+          xml_result.push_back_stream("goto_trace"));
       }
-      log.result() << xml_result;
+      ui_message_handler.close_xml_stream();
     }
     break;
   }
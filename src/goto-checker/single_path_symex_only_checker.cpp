@@ -28,7 +28,8 @@ single_path_symex_only_checkert::single_path_symex_only_checkert(
   : incremental_goto_checkert(options, ui_message_handler),
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
-    worklist(get_path_strategy(options.get_option("exploration-strategy")))
+    worklist(
+      get_path_strategy(options.get_option("exploration-strategy"), goto_model))
 {
 }
 
@@ -91,6 +91,9 @@ void symex_bmct::symex_step(
     else if(!state.guard.is_false())
       symex_coverage.covered(cur_pc, state.source.pc);
   }
+
+  for(const auto &handler : step_handlers)
+    handler();
 }
 
 void symex_bmct::merge_goto(
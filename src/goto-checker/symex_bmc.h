@@ -73,6 +73,18 @@ public:
     recursion_unwind_handlers.push_back(handler);
   }
 
+  /// Callbacks that are called after each step of symbolic execution, for
+  /// example to process the steps added to the equation in the meantime
+  typedef std::function<void()> step_handlert;
+
+  /// Add a callback function that will be called after each step of symbolic
+  /// execution.
+  /// \param handler: new callback
+  void add_step_handler(step_handlert handler)
+  {
+    step_handlers.push_back(handler);
+  }
+
   bool output_coverage_report(
     const goto_functionst &goto_functions,
     const std::string &path) const
@@ -92,6 +104,9 @@ protected:
   /// recursive call
   std::vector<recursion_unwind_handlert> recursion_unwind_handlers;
 
+  /// Callbacks to be called after each step of symbolic execution
+  std::vector<step_handlert> step_handlers;
+
   void symex_step(const get_goto_functiont &get_goto_function, statet &state)
     override;
 
@@ -26,6 +26,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/class_hierarchy.h>
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/goto_inline.h>
+#include <goto-programs/indexed_goto_binary.h>
 #include <goto-programs/interpreter.h>
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
@@ -820,7 +821,15 @@ int goto_instrument_parse_optionst::doit()
       log.status() << "Writing GOTO program to `" << cmdline.args[1] << "'"
                    << messaget::eom;
 
-      if(write_goto_binary(cmdline.args[1], goto_model, ui_message_handler))
+      const bool compress = cmdline.isset("compress-goto-binary");
+
+      const bool error =
+        cmdline.isset("indexed-goto-binary") || compress
+          ? write_indexed_goto_binary(
+              cmdline.args[1], goto_model, ui_message_handler, compress)
+          : write_goto_binary(cmdline.args[1], goto_model, ui_message_handler);
+
+      if(error)
         return CPROVER_EXIT_CONVERSION_FAILED;
       else
         return CPROVER_EXIT_SUCCESS;
@@ -1674,6 +1683,11 @@ void goto_instrument_parse_optionst::help()
     " --no-system-headers          with --dump-c/--dump-cpp: generate C source expanding libc includes\n" // NOLINT(*)
     " --use-all-headers            with --dump-c/--dump-cpp: generate C source with all includes\n" // NOLINT(*)
     " --harness                    with --dump-c/--dump-cpp: include input generator in output\n" // NOLINT(*)
+    // NOLINTNEXTLINE(whitespace/line_length)
+    " --indexed-goto-binary        write the output in the indexed goto binary format,\n"
+    "                              whose function bodies can be loaded on demand\n"
+    " --compress-goto-binary       write the output in the indexed goto binary format\n"
+    "                              with compressed sections\n"
     " --version                    show version and exit\n"
     HELP_FLUSH
     " --xml-ui                     use XML-formatted output\n"
@@ -66,6 +66,7 @@ Author: Daniel Kroening, kroening@kroening.com
   OPT_SHOW_GOTO_FUNCTIONS \
   OPT_SHOW_PROPERTIES \
   "(drop-unused-functions)" \
+  "(indexed-goto-binary)(compress-goto-binary)" \
   "(show-value-sets)" \
   "(show-global-may-alias)" \
   "(show-local-bitvector-analysis)(show-custom-bitvector-analysis)" \
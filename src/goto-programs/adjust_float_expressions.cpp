@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/arith_tools.h>
 
 #include "goto_model.h"
+#include "parallel_function_pass.h"
 
 /// Iterate over an expression and check it or any of its subexpressions are
 /// floating point operations that haven't been adjusted with a rounding mode
@@ -211,14 +212,19 @@ void adjust_float_expressions(
 
 void adjust_float_expressions(
   goto_functionst &goto_functions,
-  const namespacet &ns)
+  const namespacet &ns,
+  std::size_t jobs)
 {
-  Forall_goto_functions(it, goto_functions)
-    adjust_float_expressions(it->second, ns);
+  parallel_function_pass(
+    goto_functions,
+    jobs,
+    [&ns](const irep_idt &, goto_functionst::goto_functiont &goto_function) {
+      adjust_float_expressions(goto_function, ns);
+    });
 }
 
-void adjust_float_expressions(goto_modelt &goto_model)
+void adjust_float_expressions(goto_modelt &goto_model, std::size_t jobs)
 {
   namespacet ns(goto_model.symbol_table);
-  adjust_float_expressions(goto_model.goto_functions, ns);
+  adjust_float_expressions(goto_model.goto_functions, ns, jobs);
 }
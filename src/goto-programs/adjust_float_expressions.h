@@ -45,15 +45,18 @@ void adjust_float_expressions(
   goto_functionst::goto_functiont &goto_function,
   const namespacet &ns);
 
-/// Adjust float expressions in all goto function bodies.
+/// Adjust float expressions in all goto function bodies, using up to \p jobs
+/// threads.
 /// \see adjust_float_expressions(
 ///   goto_functionst::goto_functiont &, const namespacet &)
 void adjust_float_expressions(
   goto_functionst &goto_functions,
-  const namespacet &ns);
+  const namespacet &ns,
+  std::size_t jobs = 1);
 
-/// Adjust float expressions in a given goto_model.
+/// Adjust float expressions in a given goto_model, using up to \p jobs
+/// threads.
 /// \see adjust_float_expressions(goto_functionst &, const namespacet &)
-void adjust_float_expressions(goto_modelt &goto_model);
+void adjust_float_expressions(goto_modelt &goto_model, std::size_t jobs = 1);
 
 #endif // CPROVER_GOTO_PROGRAMS_ADJUST_FLOAT_EXPRESSIONS_H
@@ -1528,7 +1528,8 @@ void goto_convertt::do_function_call_symbol(
     code_function_callt function_call(lhs, new_function, new_arguments);
     function_call.add_source_location()=function.source_location();
 
-    if(!symbol_table.has_symbol(name))
+    const symbolt *existing_symbol;
+    if(ns.lookup(name, existing_symbol))
     {
       symbolt new_symbol;
       new_symbol.base_name=name;
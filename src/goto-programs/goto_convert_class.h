@@ -41,6 +41,19 @@ public:
   {
   }
 
+  /// Look up symbols in \p _ns, but add new symbols to \p _symbol_table,
+  /// which must be one of the symbol tables of \p _ns
+  goto_convertt(
+    symbol_table_baset &_symbol_table,
+    const namespacet &_ns,
+    message_handlert &_message_handler)
+    : messaget(_message_handler),
+      symbol_table(_symbol_table),
+      ns(_ns),
+      tmp_symbol_prefix("goto_convertt")
+  {
+  }
+
   virtual ~goto_convertt()
   {
   }
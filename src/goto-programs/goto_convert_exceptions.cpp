@@ -236,10 +236,8 @@ symbol_exprt goto_convertt::exception_flag(const irep_idt &mode)
 {
   irep_idt id="$exception_flag";
 
-  symbol_tablet::symbolst::const_iterator s_it=
-    symbol_table.symbols.find(id);
-
-  if(s_it==symbol_table.symbols.end())
+  const symbolt *existing_symbol;
+  if(ns.lookup(id, existing_symbol))
   {
     symbolt new_symbol;
     new_symbol.base_name="$exception_flag";
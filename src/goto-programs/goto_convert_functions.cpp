@@ -11,10 +11,17 @@ Date: June 2003
 #include "goto_convert_functions.h"
 
 #include <util/fresh_symbol.h>
+#include <util/memory_report.h>
+#include <util/optional.h>
+#include <util/parallel_for.h>
 #include <util/prefix.h>
+#include <util/rename.h>
+#include <util/rename_symbol.h>
 #include <util/std_code.h>
+#include <util/string_container.h>
 #include <util/symbol_table.h>
 #include <util/symbol_table_builder.h>
+#include <util/trace_timeline.h>
 
 #include <linking/static_lifetime_init.h>
 
@@ -31,11 +38,23 @@ goto_convert_functionst::~goto_convert_functionst()
 {
 }
 
-void goto_convert_functionst::goto_convert(goto_functionst &functions)
+goto_convert_functionst::goto_convert_functionst(
+  symbol_table_baset &_symbol_table,
+  const namespacet &_ns,
+  message_handlert &_message_handler)
+  : goto_convertt(_symbol_table, _ns, _message_handler)
+{
+}
+
+void goto_convert_functionst::goto_convert(
+  goto_functionst &functions,
+  std::size_t jobs)
 {
+  trace_spant span("goto_convert");
+
   // warning! hash-table iterators are not stable
 
-  typedef std::list<irep_idt> symbol_listt;
+  typedef std::vector<irep_idt> symbol_listt;
   symbol_listt symbol_list;
 
   for(const auto &symbol_pair : symbol_table.symbols)
@@ -50,13 +69,22 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
     }
   }
 
-  for(const auto &id : symbol_list)
+  if(jobs > 1)
+    convert_functions(symbol_list, functions, jobs);
+  else
   {
-    convert_function(id, functions.function_map[id]);
+    for(const auto &id : symbol_list)
+    {
+      convert_function(id, functions.function_map[id]);
+    }
   }
 
   functions.compute_location_numbers();
 
+  memory_report().snapshot("goto_convert");
+  memory_report().record_size(
+    "symbol_table.symbols", symbol_table.symbols.size());
+
   // this removes the parse tree of the bodies from memory
   #if 0
   for(const auto &symbol_pair, symbol_table.symbols)
@@ -71,6 +99,325 @@ void goto_convert_functionst::goto_convert(goto_functionst &functions)
   #endif
 }
 
+namespace
+{
+/// Symbol table that only holds the symbols added while converting a single
+/// function, and remembers the order in which they were added
+class added_symbolst : public symbol_table_baset
+{
+public:
+  added_symbolst(symbol_tablet &_table, std::vector<irep_idt> &_order)
+    : symbol_table_baset(
+        _table.symbols,
+        _table.symbol_base_map,
+        _table.symbol_module_map),
+      table(_table),
+      order(_order)
+  {
+  }
+
+  const symbol_tablet &get_symbol_table() const override
+  {
+    return table;
+  }
+
+  symbolt *get_writeable(const irep_idt &name) override
+  {
+    return table.get_writeable(name);
+  }
+
+  std::pair<symbolt &, bool> insert(symbolt symbol) override
+  {
+    auto result = table.insert(std::move(symbol));
+    if(result.second)
+      order.push_back(result.first.name);
+    return result;
+  }
+
+  bool move(symbolt &symbol, symbolt *&new_symbol) override
+  {
+    bool result = table.move(symbol, new_symbol);
+    if(!result)
+      order.push_back(new_symbol->name);
+    return result;
+  }
+
+  void erase(const symbolst::const_iterator &entry) override
+  {
+    order.erase(std::find(order.begin(), order.end(), entry->first));
+    table.erase(entry);
+  }
+
+  void clear() override
+  {
+    order.clear();
+    table.clear();
+  }
+
+  iteratort begin() override
+  {
+    return table.begin();
+  }
+
+  iteratort end() override
+  {
+    return table.end();
+  }
+
+private:
+  symbol_tablet &table;
+  std::vector<irep_idt> &order;
+};
+
+/// Replaces the provisional numbers of the strings that a thread has
+/// interned, see \ref deferred_interningt, by their numbers in the string
+/// table
+class real_namest
+{
+public:
+  explicit real_namest(std::unordered_map<unsigned, unsigned> _numbers)
+    : numbers(std::move(_numbers))
+  {
+  }
+
+  irep_idt operator()(const irep_idt &name) const
+  {
+    if(!string_containert::is_provisional(name.get_no()))
+      return name;
+
+    return irep_idt::make_from_table_index(numbers.at(name.get_no()));
+  }
+
+  void operator()(irept &irep) const
+  {
+    auto renamed = rename(irep);
+    if(renamed)
+      irep = std::move(*renamed);
+  }
+
+private:
+  std::unordered_map<unsigned, unsigned> numbers;
+
+  /// \return the copy of \p src with real names, or an empty optional if
+  ///   \p src has no provisional names, which leaves shared subtrees shared
+  optionalt<irept> rename(const irept &src) const
+  {
+    optionalt<irept> result;
+    auto get_result = [&]() -> irept & {
+      if(!result)
+        result = src;
+      return *result;
+    };
+
+    if(string_containert::is_provisional(src.id().get_no()))
+      get_result().id((*this)(src.id()));
+
+    const irept::subt &sub = src.get_sub();
+    for(std::size_t i = 0; i < sub.size(); ++i)
+    {
+      auto renamed = rename(sub[i]);
+      if(renamed)
+        get_result().get_sub()[i] = std::move(*renamed);
+    }
+
+    for(const auto &named_sub : src.get_named_sub())
+    {
+      auto renamed = rename(named_sub.second);
+      if(string_containert::is_provisional(named_sub.first.get_no()))
+      {
+        get_result().remove(named_sub.first);
+        get_result().add(
+          (*this)(named_sub.first),
+          renamed ? std::move(*renamed) : named_sub.second);
+      }
+      else if(renamed)
+        get_result().add(named_sub.first, std::move(*renamed));
+    }
+
+    return result;
+  }
+};
+} // namespace
+
+/// Convert the functions \p identifiers using up to \p jobs threads. Each
+/// function is converted by its own converter, which looks up symbols in the
+/// symbol table of this converter, but adds symbols to a table of its own,
+/// and buffers its messages. Once all functions have been converted, the
+/// messages are passed on and the added symbols are merged into the symbol
+/// table, function by function in the order of \p identifiers, which yields
+/// the same messages and symbol table as converting the functions one by
+/// one. Symbols that are not specific to a function, such as
+/// `$exception_flag`, are added by the first function that needs them, as
+/// for a sequential conversion. Should two functions add auxiliary symbols
+/// of the same name, the symbol of the later function is renamed, so the
+/// result does not depend on the order in which the threads ran. Nor do the
+/// numbers of the strings, such as the names of temporaries, that the
+/// threads intern: these are interned provisionally, and only when merging,
+/// function by function, get the numbers that a sequential conversion would
+/// have given them. Containers that are hashed or ordered by these numbers,
+/// such as the symbol table, thus iterate in the same order, too.
+void goto_convert_functionst::convert_functions(
+  const std::vector<irep_idt> &identifiers,
+  goto_functionst &functions,
+  std::size_t jobs)
+{
+  struct conversiont
+  {
+    explicit conversiont(message_handlert &message_handler)
+      : messages(message_handler)
+    {
+    }
+
+    goto_functionst::goto_functiont *function;
+    symbol_tablet added_symbols;
+    std::vector<irep_idt> added_symbols_order;
+    deferred_stringst interned_strings;
+    buffered_message_handlert messages;
+    std::exception_ptr exception;
+  };
+
+  std::vector<conversiont> conversions;
+  conversions.reserve(identifiers.size());
+
+  // create the entries of the function map up front, as the threads must
+  // not modify it
+  for(const auto &id : identifiers)
+  {
+    conversions.emplace_back(get_message_handler());
+    conversions.back().function = &functions.function_map[id];
+  }
+
+  parallel_for(identifiers.size(), jobs, [&](std::size_t i) {
+    conversiont &conversion = conversions[i];
+    const deferred_interningt deferred_interning(&conversion.interned_strings);
+    added_symbolst added_symbols(
+      conversion.added_symbols, conversion.added_symbols_order);
+    goto_convert_functionst converter(
+      added_symbols,
+      namespacet(conversion.added_symbols, symbol_table),
+      conversion.messages);
+
+    try
+    {
+      converter.convert_function(identifiers[i], *conversion.function);
+    }
+    catch(...)
+    {
+      conversion.exception = std::current_exception();
+    }
+  });
+
+  for(std::size_t i = 0; i < identifiers.size(); ++i)
+  {
+    conversiont &conversion = conversions[i];
+
+    conversion.messages.replay(get_message_handler());
+
+    if(conversion.exception)
+      std::rethrow_exception(conversion.exception);
+
+    // intern the strings that converting the function has added in the
+    // order in which a sequential conversion would have interned them
+    if(!conversion.interned_strings.numbers.empty())
+    {
+      const real_namest real_names(
+        get_string_container().intern(conversion.interned_strings));
+
+      for(auto &instruction : conversion.function->body.instructions)
+      {
+        real_names(instruction.code);
+        real_names(instruction.guard);
+        real_names(instruction.source_location);
+        for(auto &label : instruction.labels)
+          label = real_names(label);
+      }
+
+      real_names(conversion.function->type);
+      for(auto &identifier : conversion.function->parameter_identifiers)
+        identifier = real_names(identifier);
+
+      symbol_tablet added_symbols;
+      for(auto &name : conversion.added_symbols_order)
+      {
+        symbolt &symbol = conversion.added_symbols.get_writeable_ref(name);
+        real_names(symbol.type);
+        real_names(symbol.value);
+        real_names(symbol.location);
+        symbol.name = real_names(symbol.name);
+        symbol.module = real_names(symbol.module);
+        symbol.base_name = real_names(symbol.base_name);
+        symbol.mode = real_names(symbol.mode);
+        symbol.pretty_name = real_names(symbol.pretty_name);
+
+        name = symbol.name;
+        added_symbols.insert(std::move(symbol));
+      }
+      conversion.added_symbols.swap(added_symbols);
+    }
+
+    // fresh names are only unique among the symbols the converting thread
+    // could see, so rename the auxiliary symbols that an earlier function
+    // has added in the meantime
+    rename_symbolt rename_symbol;
+    const namespacet names_in_use(symbol_table, conversion.added_symbols);
+    for(const auto &name : conversion.added_symbols_order)
+    {
+      if(
+        symbol_table.has_symbol(name) &&
+        conversion.added_symbols.lookup_ref(name).is_auxiliary)
+      {
+        irep_idt new_name = name;
+        get_new_name(new_name, names_in_use, '$');
+        rename_symbol.insert_expr(name, new_name);
+      }
+    }
+
+    if(!rename_symbol.expr_map.empty())
+    {
+      for(auto &instruction : conversion.function->body.instructions)
+      {
+        rename_symbol(instruction.code);
+        rename_symbol(instruction.guard);
+      }
+
+      for(const auto &name : conversion.added_symbols_order)
+      {
+        symbolt &added_symbol =
+          conversion.added_symbols.get_writeable_ref(name);
+        rename_symbol(added_symbol.type);
+        rename_symbol(added_symbol.value);
+      }
+    }
+
+    for(const auto &name : conversion.added_symbols_order)
+    {
+      symbolt &added_symbol = conversion.added_symbols.get_writeable_ref(name);
+
+      const auto renamed = rename_symbol.expr_map.find(name);
+      if(renamed != rename_symbol.expr_map.end())
+      {
+        added_symbol.base_name = id2string(added_symbol.base_name) +
+                                 id2string(renamed->second).substr(
+                                   id2string(name).size());
+        added_symbol.name = renamed->second;
+      }
+      else if(symbol_table.has_symbol(name))
+      {
+        // a symbol that is not specific to a function, such as
+        // `$exception_flag`, which an earlier function has added already
+        continue;
+      }
+
+      const bool inserted = symbol_table.insert(std::move(added_symbol)).second;
+      INVARIANT(
+        inserted, "symbols added by converting a function must not exist");
+    }
+
+    if(conversion.function->is_hidden())
+      symbol_table.get_writeable_ref(identifiers[i]).set_hidden();
+  }
+}
+
 bool goto_convert_functionst::hide(const goto_programt &goto_program)
 {
   forall_goto_program_instructions(i_it, goto_program)
@@ -163,8 +510,9 @@ void goto_convert_functionst::convert_function(
   for(const auto &p : f.parameter_identifiers)
   {
     DATA_INVARIANT(!p.empty(), "parameter identifier should not be empty");
+    const symbolt *parameter_symbol;
     DATA_INVARIANT(
-      symbol_table.has_symbol(p),
+      !ns.lookup(p, parameter_symbol),
       "parameter identifier must be a known symbol");
   }
 
@@ -226,7 +574,11 @@ void goto_convert_functionst::convert_function(
   if(hide(f.body))
   {
     f.make_hidden();
-    symbol_table.get_writeable_ref(identifier).set_hidden();
+    // when converting in parallel, the function symbol is not in the symbol
+    // table we write to, and is hidden when merging the results
+    symbolt *function_symbol = symbol_table.get_writeable(identifier);
+    if(function_symbol != nullptr)
+      function_symbol->set_hidden();
   }
 
   lifetime = parent_lifetime;
@@ -234,19 +586,21 @@ void goto_convert_functionst::convert_function(
 
 void goto_convert(
   goto_modelt &goto_model,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  std::size_t jobs)
 {
   symbol_table_buildert symbol_table_builder =
     symbol_table_buildert::wrap(goto_model.symbol_table);
 
   goto_convert(
-    symbol_table_builder, goto_model.goto_functions, message_handler);
+    symbol_table_builder, goto_model.goto_functions, message_handler, jobs);
 }
 
 void goto_convert(
   symbol_table_baset &symbol_table,
   goto_functionst &functions,
-  message_handlert &message_handler)
+  message_handlert &message_handler,
+  std::size_t jobs)
 {
   symbol_table_buildert symbol_table_builder =
     symbol_table_buildert::wrap(symbol_table);
@@ -254,7 +608,7 @@ void goto_convert(
   goto_convert_functionst goto_convert_functions(
     symbol_table_builder, message_handler);
 
-  goto_convert_functions.goto_convert(functions);
+  goto_convert_functions.goto_convert(functions, jobs);
 }
 
 void goto_convert(
@@ -18,16 +18,18 @@ Date: June 2003
 #include "goto_convert_class.h"
 #include "goto_functions.h"
 
-// convert it all!
+// convert it all, using up to `jobs` threads
 void goto_convert(
   symbol_table_baset &symbol_table,
   goto_functionst &functions,
-  message_handlert &);
+  message_handlert &,
+  std::size_t jobs = 1);
 
-// convert it all!
+// convert it all, using up to `jobs` threads
 void goto_convert(
   goto_modelt &,
-  message_handlert &);
+  message_handlert &,
+  std::size_t jobs = 1);
 
 // just convert a specific function
 void goto_convert(
@@ -39,7 +41,7 @@ void goto_convert(
 class goto_convert_functionst:public goto_convertt
 {
 public:
-  void goto_convert(goto_functionst &functions);
+  void goto_convert(goto_functionst &functions, std::size_t jobs = 1);
   void convert_function(
     const irep_idt &identifier,
     goto_functionst::goto_functiont &result);
@@ -48,11 +50,21 @@ public:
     symbol_table_baset &_symbol_table,
     message_handlert &_message_handler);
 
+  goto_convert_functionst(
+    symbol_table_baset &_symbol_table,
+    const namespacet &_ns,
+    message_handlert &_message_handler);
+
   virtual ~goto_convert_functionst();
 
 protected:
   static bool hide(const goto_programt &);
 
+  void convert_functions(
+    const std::vector<irep_idt> &identifiers,
+    goto_functionst &functions,
+    std::size_t jobs);
+
   //
   // function calls
   //
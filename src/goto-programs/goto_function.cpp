@@ -13,6 +13,8 @@ Date: May 2018
 
 #include "goto_function.h"
 
+#include <util/irep_hash.h>
+
 /// Return in \p dest the identifiers of the local variables declared in the \p
 /// goto_function and the identifiers of the paramters of the \p goto_function.
 void get_local_identifiers(
@@ -70,3 +72,25 @@ void goto_functiont::validate(const namespacet &ns, const validation_modet vm)
 
   validate_full_type(type, ns, vm);
 }
+
+std::size_t goto_functiont::hash() const
+{
+  std::size_t result = type.hash();
+
+  for(const auto &identifier : parameter_identifiers)
+    result = hash_combine(result, identifier.hash());
+
+  for(const auto &instruction : body.instructions)
+  {
+    result =
+      hash_combine(result, static_cast<std::size_t>(instruction.type));
+    result = hash_combine(result, instruction.code.hash());
+    result = hash_combine(result, instruction.guard.hash());
+    result = hash_combine(result, instruction.target_number);
+
+    for(const auto &target : instruction.targets)
+      result = hash_combine(result, target->target_number);
+  }
+
+  return result;
+}
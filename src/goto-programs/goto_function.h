@@ -120,6 +120,11 @@ public:
   /// The validation mode indicates whether well-formedness check failures are
   /// reported via DATA_INVARIANT violations or exceptions.
   void validate(const namespacet &ns, const validation_modet vm) const;
+
+  /// Hash of the type, the parameter identifiers and the instructions, which
+  /// changes whenever a transformation changes the function (up to
+  /// collisions). Source locations are not taken into account.
+  std::size_t hash() const;
 };
 
 void get_local_identifiers(const goto_functiont &, std::set<irep_idt> &dest);
@@ -15,6 +15,9 @@ Date: June 2003
 
 #include <algorithm>
 
+#include <util/irep_hash.h>
+#include <util/parallel_for.h>
+
 void goto_functionst::compute_location_numbers()
 {
   unused_location_number = 0;
@@ -98,44 +101,82 @@ std::vector<goto_functionst::function_mapt::iterator> goto_functionst::sorted()
   return result;
 }
 
-void goto_functionst::validate(const namespacet &ns, const validation_modet vm)
-  const
+/// Check \p goto_function against the symbol of \p function_name
+static void validate_function(
+  const namespacet &ns,
+  const validation_modet vm,
+  const irep_idt &function_name,
+  const goto_functiont &goto_function)
 {
-  for(const auto &entry : function_map)
+  const symbolt &function_symbol = ns.lookup(function_name);
+  const code_typet::parameterst &parameters =
+    to_code_type(function_symbol.type).parameters();
+
+  DATA_CHECK(
+    vm,
+    goto_function.type == ns.lookup(function_name).type,
+    id2string(function_name) + " type inconsistency\ngoto program type: " +
+      goto_function.type.id_string() +
+      "\nsymbol table type: " + ns.lookup(function_name).type.id_string());
+
+  DATA_CHECK(
+    vm,
+    goto_function.parameter_identifiers.size() == parameters.size(),
+    id2string(function_name) + " parameter count inconsistency\n" +
+      "goto program: " +
+      std::to_string(goto_function.parameter_identifiers.size()) +
+      "\nsymbol table: " + std::to_string(parameters.size()));
+
+  auto it = goto_function.parameter_identifiers.begin();
+  for(const auto &parameter : parameters)
   {
-    const goto_functiont &goto_function = entry.second;
-    const auto &function_name = entry.first;
-    const symbolt &function_symbol = ns.lookup(function_name);
-    const code_typet::parameterst &parameters =
-      to_code_type(function_symbol.type).parameters();
-
     DATA_CHECK(
       vm,
-      goto_function.type == ns.lookup(function_name).type,
-      id2string(function_name) + " type inconsistency\ngoto program type: " +
-        goto_function.type.id_string() +
-        "\nsymbol table type: " + ns.lookup(function_name).type.id_string());
+      it->empty() || ns.lookup(*it).type == parameter.type(),
+      id2string(function_name) + " parameter type inconsistency\n" +
+        "goto program: " + ns.lookup(*it).type.id_string() +
+        "\nsymbol table: " + parameter.type().id_string());
+    ++it;
+  }
 
-    DATA_CHECK(
-      vm,
-      goto_function.parameter_identifiers.size() == parameters.size(),
-      id2string(function_name) + " parameter count inconsistency\n" +
-        "goto program: " +
-        std::to_string(goto_function.parameter_identifiers.size()) +
-        "\nsymbol table: " + std::to_string(parameters.size()));
-
-    auto it = goto_function.parameter_identifiers.begin();
-    for(const auto &parameter : parameters)
+  goto_function.validate(ns, vm);
+}
+
+void goto_functionst::validate(
+  const namespacet &ns,
+  const validation_modet vm,
+  std::size_t jobs,
+  validated_functionst *validated) const
+{
+  std::vector<function_mapt::const_iterator> to_check;
+  validated_functionst hashes;
+
+  for(auto it = function_map.begin(); it != function_map.end(); ++it)
+  {
+    if(validated == nullptr)
     {
-      DATA_CHECK(
-        vm,
-        it->empty() || ns.lookup(*it).type == parameter.type(),
-        id2string(function_name) + " parameter type inconsistency\n" +
-          "goto program: " + ns.lookup(*it).type.id_string() +
-          "\nsymbol table: " + parameter.type().id_string());
-      ++it;
+      to_check.push_back(it);
+      continue;
     }
 
-    goto_function.validate(ns, vm);
+    // the hashes are computed before any threads are started, so that the
+    // hash codes cached in the ireps can be reused by later validations
+    const symbolt *symbol;
+    const std::size_t hash = ns.lookup(it->first, symbol)
+                               ? it->second.hash()
+                               : hash_combine(
+                                   it->second.hash(), symbol->type.hash());
+    hashes.emplace(it->first, hash);
+
+    const auto entry = validated->find(it->first);
+    if(entry == validated->end() || entry->second != hash)
+      to_check.push_back(it);
   }
+
+  parallel_for(to_check.size(), jobs, [&](std::size_t i) {
+    validate_function(ns, vm, to_check[i]->first, to_check[i]->second);
+  });
+
+  if(validated != nullptr)
+    validated->swap(hashes);
 }
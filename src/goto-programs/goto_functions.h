@@ -18,6 +18,8 @@ Date: June 2003
 
 #include <util/cprover_prefix.h>
 
+#include <unordered_map>
+
 /// A collection of goto functions
 class goto_functionst
 {
@@ -107,11 +109,23 @@ public:
   std::vector<function_mapt::const_iterator> sorted() const;
   std::vector<function_mapt::iterator> sorted();
 
+  /// Hashes of goto functions that passed validation, combining
+  /// \ref goto_functiont::hash and the hash of the type of their symbol
+  typedef std::unordered_map<irep_idt, std::size_t> validated_functionst;
+
   /// Check that the goto functions are well-formed
   ///
   /// The validation mode indicates whether well-formedness check failures are
   /// reported via DATA_INVARIANT violations or exceptions.
-  void validate(const namespacet &, validation_modet) const;
+  /// \param jobs: maximum number of threads checking functions
+  /// \param validated: if not null, the functions recorded in it are only
+  ///   checked if they or the type of their symbol have changed since they
+  ///   were recorded. Once all checks pass, it records all functions.
+  void validate(
+    const namespacet &,
+    validation_modet,
+    std::size_t jobs = 1,
+    validated_functionst *validated = nullptr) const;
 };
 
 #define Forall_goto_functions(it, functions) \
@@ -108,7 +108,7 @@ public:
     validate_goto_model(goto_functions, vm, goto_model_validation_options);
 
     const namespacet ns(symbol_table);
-    goto_functions.validate(ns, vm);
+    goto_functions.validate(ns, vm, goto_model_validation_options.jobs);
   }
 };
 
@@ -164,7 +164,7 @@ public:
     validate_goto_model(goto_functions, vm, goto_model_validation_options);
 
     const namespacet ns(symbol_table);
-    goto_functions.validate(ns, vm);
+    goto_functions.validate(ns, vm, goto_model_validation_options.jobs);
   }
 
 private:
@@ -15,11 +15,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <set>
 #include <limits>
+#include <list>
 #include <sstream>
 #include <string>
 
 #include <util/invariant.h>
 #include <util/namespace.h>
+#include <util/pool_allocator.h>
 #include <util/source_location.h>
 #include <util/std_code.h>
 #include <util/std_expr.h>
@@ -93,6 +95,15 @@ public:
     return *this;
   }
 
+  class instructiont;
+
+  // Never try to change this to vector-we mutate the list while iterating.
+  // The nodes are taken from a pool shared by all goto programs, which keeps
+  // the instructions of a program close together in memory, mostly in
+  // program order, and makes inserting and removing instructions cheap.
+  typedef std::list<instructiont, pool_container_allocatort<instructiont>>
+    instructionst;
+
   /// This class represents an instruction in the GOTO intermediate
   /// representation.  Three fields are key:
   ///
@@ -297,8 +308,8 @@ public:
 
     // The below will eventually become a single target only.
     /// The target for gotos and for start_thread nodes
-    typedef std::list<instructiont>::iterator targett;
-    typedef std::list<instructiont>::const_iterator const_targett;
+    typedef instructionst::iterator targett;
+    typedef instructionst::const_iterator const_targett;
     typedef std::list<targett> targetst;
     typedef std::list<const_targett> const_targetst;
 
@@ -573,9 +584,6 @@ public:
     void apply(std::function<void(const exprt &)>) const;
   };
 
-  // Never try to change this to vector-we mutate the list while iterating
-  typedef std::list<instructiont> instructionst;
-
   typedef instructionst::iterator targett;
   typedef instructionst::const_iterator const_targett;
   typedef std::list<targett> targetst;
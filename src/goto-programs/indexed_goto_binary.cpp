@@ -0,0 +1,389 @@
+/*******************************************************************\
+
+Module: Indexed goto binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Indexed goto binaries, which permit loading function bodies on demand
+
+#include "indexed_goto_binary.h"
+
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <streambuf>
+
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/symbol_table.h>
+#include <util/unicode.h>
+
+#include "goto_model.h"
+#include "read_bin_goto_object.h"
+#include "write_goto_binary.h"
+
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include <miniz/miniz.h>
+
+/// Stream buffer reading from a range of characters in memory without
+/// copying them
+class memory_streambuft : public std::streambuf
+{
+public:
+  memory_streambuft(const char *begin, std::size_t size)
+  {
+    char *p = const_cast<char *>(begin);
+    setg(p, p, p + size);
+  }
+
+  /// \return number of characters read so far
+  std::size_t position() const
+  {
+    return static_cast<std::size_t>(gptr() - eback());
+  }
+};
+
+void indexed_goto_binaryt::open(const std::string &filename)
+{
+  file = mapped_filet(filename);
+  buffer.clear();
+
+  data = file.data();
+  size = file.size();
+
+  read_index();
+}
+
+void indexed_goto_binaryt::load(std::vector<char> contents)
+{
+  file = mapped_filet();
+  buffer = std::move(contents);
+
+  data = buffer.data();
+  size = buffer.size();
+
+  read_index();
+}
+
+void indexed_goto_binaryt::read_index()
+{
+  function_blocks.clear();
+
+  if(size < 4 || !is_indexed_goto_binary_header(data))
+    throw deserialization_exceptiont("not an indexed goto binary");
+
+  memory_streambuft streambuf(data + 4, size - 4);
+  std::istream in(&streambuf);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  const std::size_t version = irepconverter.read_gb_word(in);
+
+  if(version != GOTO_BINARY_VERSION)
+  {
+    throw deserialization_exceptiont(
+      "unsupported goto binary version " + std::to_string(version));
+  }
+
+  const std::size_t flags = irepconverter.read_gb_word(in);
+
+  if((flags & ~compressed_flag) != 0)
+    throw deserialization_exceptiont("unsupported indexed goto binary flags");
+
+  compressed = (flags & compressed_flag) != 0;
+
+  auto read_block = [this, &in](blockt &block) {
+    block.offset = irep_serializationt::read_gb_word(in);
+    block.size = irep_serializationt::read_gb_word(in);
+    block.uncompressed_size =
+      compressed ? irep_serializationt::read_gb_word(in) : block.size;
+  };
+
+  read_block(symbol_table_block);
+
+  const std::size_t count = irepconverter.read_gb_word(in); // # of functions
+
+  for(std::size_t i = 0; i < count; i++)
+  {
+    const irep_idt name = irepconverter.read_gb_string(in);
+    read_block(function_blocks[name]);
+  }
+
+  const std::size_t blocks_begin = 4 + streambuf.position();
+  const std::size_t blocks_size = size - blocks_begin;
+
+  // deflate cannot expand its input by more than a factor of 1032
+  const std::size_t max_compression_ratio = 1032;
+
+  auto check_block = [this, blocks_size](const blockt &block) {
+    if(block.offset > blocks_size || block.size > blocks_size - block.offset)
+      throw deserialization_exceptiont("block outside of goto binary");
+
+    // the uncompressed size is trusted when allocating the decompression
+    // buffer, and is passed to miniz as mz_ulong, which may be 32 bits wide
+    if(
+      compressed &&
+      (block.uncompressed_size / max_compression_ratio > block.size ||
+       block.uncompressed_size > std::numeric_limits<mz_ulong>::max()))
+    {
+      throw deserialization_exceptiont("invalid size of goto binary block");
+    }
+  };
+
+  // make the offsets relative to the beginning of the file
+  check_block(symbol_table_block);
+  symbol_table_block.offset += blocks_begin;
+
+  for(auto &function_block : function_blocks)
+  {
+    check_block(function_block.second);
+    function_block.second.offset += blocks_begin;
+  }
+}
+
+const char *indexed_goto_binaryt::block_contents(
+  const blockt &block,
+  std::vector<char> &storage) const
+{
+  if(!compressed)
+    return data + block.offset;
+
+  // read_index has checked that the size is in the range of mz_ulong
+  storage.resize(block.uncompressed_size);
+  mz_ulong size = static_cast<mz_ulong>(block.uncompressed_size);
+
+  const int result = mz_uncompress(
+    reinterpret_cast<unsigned char *>(storage.data()),
+    &size,
+    reinterpret_cast<const unsigned char *>(data + block.offset),
+    block.size);
+
+  if(result != MZ_OK || size != block.uncompressed_size)
+    throw deserialization_exceptiont("failed to decompress goto binary block");
+
+  return storage.data();
+}
+
+void indexed_goto_binaryt::read_symbol_table(symbol_tablet &symbol_table) const
+{
+  PRECONDITION(is_open());
+
+  std::vector<char> storage;
+  memory_streambuft streambuf(
+    block_contents(symbol_table_block, storage),
+    symbol_table_block.uncompressed_size);
+  std::istream in(&streambuf);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  const std::size_t count = irepconverter.read_gb_word(in); // # of symbols
+
+  for(std::size_t i = 0; i < count; i++)
+    symbol_table.add(read_bin_goto_symbol(in, irepconverter));
+}
+
+void indexed_goto_binaryt::read_function(
+  const irep_idt &function_name,
+  symbol_table_baset &symbol_table,
+  goto_functiont &function) const
+{
+  const auto entry = function_blocks.find(function_name);
+  if(entry == function_blocks.end())
+  {
+    throw deserialization_exceptiont(
+      "no body for function " + id2string(function_name) + " in goto binary");
+  }
+
+  const symbolt *symbol = symbol_table.lookup(function_name);
+  if(symbol == nullptr || symbol->type.id() != ID_code)
+  {
+    throw deserialization_exceptiont(
+      "no function symbol for " + id2string(function_name) + " in goto binary");
+  }
+
+  const blockt &block = entry->second;
+
+  std::vector<char> storage;
+  memory_streambuft streambuf(
+    block_contents(block, storage), block.uncompressed_size);
+  std::istream in(&streambuf);
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  const code_typet &code_type = to_code_type(symbol->type);
+  function.type = code_type;
+  function.set_parameter_identifiers(code_type);
+
+  if(read_bin_goto_function_body(in, irepconverter, function.body))
+    read_bin_goto_make_hidden(function_name, function, symbol_table);
+}
+
+void indexed_goto_binaryt::read(
+  symbol_tablet &symbol_table,
+  goto_functionst &functions) const
+{
+  read_symbol_table(symbol_table);
+
+  // makes sure there is an empty function for every function symbol
+  for(const auto &symbol_pair : symbol_table.symbols)
+  {
+    const symbolt &symbol = symbol_pair.second;
+
+    if(!symbol.is_type && symbol.type.id() == ID_code)
+    {
+      goto_functiont &function = functions.function_map[symbol.name];
+      const code_typet &code_type = to_code_type(symbol.type);
+      function.type = code_type;
+      function.set_parameter_identifiers(code_type);
+    }
+  }
+
+  for(const auto &function_block : function_blocks)
+  {
+    read_function(
+      function_block.first,
+      symbol_table,
+      functions.function_map[function_block.first]);
+  }
+
+  functions.compute_location_numbers();
+}
+
+bool indexed_goto_binaryt::is_indexed_goto_binary(const std::string &filename)
+{
+#ifdef _MSC_VER
+  std::ifstream in(widen(filename), std::ios::binary);
+#else
+  std::ifstream in(filename, std::ios::binary);
+#endif
+
+  char hdr[4];
+
+  return in.read(hdr, sizeof(hdr)) && is_indexed_goto_binary_header(hdr);
+}
+
+/// Writes a goto program in the indexed goto binary format, see
+/// \ref indexed_goto_binaryt
+/// \param out: output stream
+/// \param symbol_table: symbol table to write
+/// \param goto_functions: goto functions to write
+/// \param compressed: whether to compress the blocks
+/// \return true on error, false otherwise
+bool write_indexed_goto_binary(
+  std::ostream &out,
+  const symbol_tablet &symbol_table,
+  const goto_functionst &goto_functions,
+  bool compressed)
+{
+  irep_serializationt::ireps_containert irepc;
+  irep_serializationt irepconverter(irepc);
+
+  // the blocks are collected first as the index precedes them
+  std::string blocks;
+  std::ostringstream index;
+
+  // append a block and write its position to the index
+  auto add_block = [&blocks, &index, compressed](const std::string &block) {
+    write_gb_word(index, blocks.size());
+
+    if(compressed)
+    {
+      mz_ulong size = mz_compressBound(block.size());
+      std::vector<unsigned char> buffer(size);
+
+      const int result = mz_compress(
+        buffer.data(),
+        &size,
+        reinterpret_cast<const unsigned char *>(block.data()),
+        block.size());
+      INVARIANT(result == MZ_OK, "compression into bounded buffer succeeds");
+
+      blocks.append(reinterpret_cast<const char *>(buffer.data()), size);
+      write_gb_word(index, size);
+      write_gb_word(index, block.size());
+    }
+    else
+    {
+      blocks += block;
+      write_gb_word(index, block.size());
+    }
+  };
+
+  {
+    std::ostringstream block;
+
+    write_gb_word(block, symbol_table.symbols.size());
+
+    for(const auto &symbol_pair : symbol_table.symbols)
+      write_goto_binary_symbol(block, symbol_pair.second, irepconverter);
+
+    add_block(block.str());
+  }
+
+  std::size_t count = 0;
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(fct.second.body_available())
+      count++;
+  }
+
+  write_gb_word(index, count);
+
+  for(const auto &fct : goto_functions.function_map)
+  {
+    if(!fct.second.body_available())
+      continue;
+
+    irepconverter.clear();
+
+    std::ostringstream block;
+    write_goto_binary_function_body(block, fct.second.body, irepconverter);
+
+    write_gb_string(index, id2string(fct.first));
+    add_block(block.str());
+  }
+
+  std::size_t flags = 0;
+  if(compressed)
+    flags |= indexed_goto_binaryt::compressed_flag;
+
+  // header
+  out << char(0x7f) << "GBI";
+  write_gb_word(out, GOTO_BINARY_VERSION);
+  write_gb_word(out, flags);
+
+  out << index.str() << blocks;
+
+  return !out;
+}
+
+/// Writes a goto program to disc, using the indexed goto binary format
+bool write_indexed_goto_binary(
+  const std::string &filename,
+  const goto_modelt &goto_model,
+  message_handlert &message_handler,
+  bool compressed)
+{
+#ifdef _MSC_VER
+  std::ofstream out(widen(filename), std::ios::binary);
+#else
+  std::ofstream out(filename, std::ios::binary);
+#endif
+
+  if(!out)
+  {
+    messaget message(message_handler);
+    message.error() << "Failed to open `" << filename << "'" << messaget::eom;
+    return true;
+  }
+
+  return write_indexed_goto_binary(
+    out, goto_model.symbol_table, goto_model.goto_functions, compressed);
+}
@@ -0,0 +1,163 @@
+/*******************************************************************\
+
+Module: Indexed goto binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Indexed goto binaries, which permit loading function bodies on demand
+
+#ifndef CPROVER_GOTO_PROGRAMS_INDEXED_GOTO_BINARY_H
+#define CPROVER_GOTO_PROGRAMS_INDEXED_GOTO_BINARY_H
+
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <util/irep.h>
+#include <util/mapped_file.h>
+
+class goto_functionst;
+class goto_functiont;
+class goto_modelt;
+class message_handlert;
+class symbol_table_baset;
+class symbol_tablet;
+
+/// A goto binary in the indexed format, which is laid out as follows:
+///
+///     0x7f 'G' 'B' 'I'
+///     version
+///     flags
+///     index:
+///       position of the symbol table block
+///       number of function blocks
+///       name and position of each function block
+///     blocks
+///
+/// The symbol table block holds all symbols and each function block holds the
+/// instructions of one function with a body, in the same encoding as in the
+/// sequential goto binary format. Each block is serialized with a fresh
+/// \ref irep_serializationt, so blocks do not refer to each other and can be
+/// read independently and in any order.
+///
+/// The position of a block is given by its offset relative to the first block
+/// and its size. If the flag \ref compressed_flag is set, each block is
+/// compressed individually with zlib (via miniz), and its position is followed
+/// by its uncompressed size.
+///
+/// A file in this format is mapped into memory rather than read, and the
+/// function bodies are only deserialized (and decompressed) when they are
+/// requested.
+class indexed_goto_binaryt
+{
+public:
+  indexed_goto_binaryt() = default;
+
+  indexed_goto_binaryt(const indexed_goto_binaryt &) = delete;
+  indexed_goto_binaryt(indexed_goto_binaryt &&) = default;
+  indexed_goto_binaryt &operator=(indexed_goto_binaryt &&) = default;
+
+  /// Map the goto binary \p filename into memory and read its index. Throws a
+  /// `system_exceptiont` if the file cannot be read and a
+  /// `deserialization_exceptiont` if it is not a well-formed indexed goto
+  /// binary.
+  void open(const std::string &filename);
+
+  /// Read the index of an indexed goto binary held in memory. Throws a
+  /// `deserialization_exceptiont` if \p contents is not a well-formed indexed
+  /// goto binary.
+  void load(std::vector<char> contents);
+
+  bool is_open() const
+  {
+    return data != nullptr;
+  }
+
+  /// Add all symbols of the goto binary to \p symbol_table
+  void read_symbol_table(symbol_tablet &symbol_table) const;
+
+  /// \return true if the goto binary contains a body for the function
+  bool has_function(const irep_idt &function_name) const
+  {
+    return function_blocks.find(function_name) != function_blocks.end();
+  }
+
+  /// Read a function body from the goto binary.
+  /// \param function_name: name of a function for which \ref has_function
+  ///   holds
+  /// \param symbol_table: symbol table holding the symbols of the goto
+  ///   binary, in which the function is marked as hidden if necessary
+  /// \param [out] function: function to read the type and body into
+  /// \throws deserialization_exceptiont if the goto binary has no body or the
+  ///   symbol table has no function symbol for \p function_name
+  void read_function(
+    const irep_idt &function_name,
+    symbol_table_baset &symbol_table,
+    goto_functiont &function) const;
+
+  /// Read the whole goto binary, as `read_bin_goto_object` does for goto
+  /// binaries in the sequential format.
+  void read(symbol_tablet &symbol_table, goto_functionst &functions) const;
+
+  /// flag indicating that the blocks are compressed
+  static const std::size_t compressed_flag = 1;
+
+  /// \return true if \p hdr (of at least four characters) is the header of an
+  ///   indexed goto binary
+  static bool is_indexed_goto_binary_header(const char *hdr)
+  {
+    return hdr[0] == 0x7f && hdr[1] == 'G' && hdr[2] == 'B' && hdr[3] == 'I';
+  }
+
+  /// \return true if the file \p filename starts with the header of an indexed
+  ///   goto binary
+  static bool is_indexed_goto_binary(const std::string &filename);
+
+protected:
+  /// storage of the contents if the goto binary has been mapped into memory
+  mapped_filet file;
+
+  /// storage of the contents if the goto binary has been loaded from a stream
+  std::vector<char> buffer;
+
+  const char *data = nullptr;
+  std::size_t size = 0;
+
+  /// whether the blocks are compressed
+  bool compressed = false;
+
+  struct blockt
+  {
+    std::size_t offset = 0;
+    std::size_t size = 0;
+    std::size_t uncompressed_size = 0;
+  };
+
+  blockt symbol_table_block;
+  std::unordered_map<irep_idt, blockt> function_blocks;
+
+  void read_index();
+
+  /// \return pointer to the uncompressed contents of \p block, which are
+  ///   either part of the goto binary or decompressed into \p storage
+  const char *
+  block_contents(const blockt &block, std::vector<char> &storage) const;
+};
+
+bool write_indexed_goto_binary(
+  std::ostream &out,
+  const symbol_tablet &,
+  const goto_functionst &,
+  bool compressed = false);
+
+bool write_indexed_goto_binary(
+  const std::string &filename,
+  const goto_modelt &,
+  message_handlert &,
+  bool compressed = false);
+
+#endif // CPROVER_GOTO_PROGRAMS_INDEXED_GOTO_BINARY_H
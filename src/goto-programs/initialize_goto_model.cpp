@@ -133,14 +133,23 @@ goto_modelt initialize_goto_model(
     }
   }
 
-  for(const auto &file : binaries)
+  if(!binaries.empty())
   {
-    msg.status() << "Reading GOTO program from file" << messaget::eom;
+    msg.status() << "Reading GOTO programs from files" << messaget::eom;
 
-    if(read_object_and_link(file, goto_model, message_handler))
+    if(read_objects_and_link(
+         binaries,
+         goto_model,
+         message_handler,
+         options.get_unsigned_int_option("jobs")))
     {
+      std::string files;
+      for(const auto &file : binaries)
+        files += (files.empty() ? "`" : ", `") + file + '\'';
+
       throw invalid_source_file_exceptiont(
-        "failed to read object or link in file `" + file + '\'');
+        "failed to read object or link in file" +
+        std::string(binaries.size() == 1 ? " " : "s ") + files);
     }
   }
 
@@ -190,7 +199,8 @@ goto_modelt initialize_goto_model(
   goto_convert(
     goto_model.symbol_table,
     goto_model.goto_functions,
-    message_handler);
+    message_handler,
+    options.get_unsigned_int_option("jobs"));
 
   if(options.is_set("validate-goto-model"))
   {
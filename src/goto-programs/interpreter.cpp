@@ -155,8 +155,6 @@ void interpretert::command()
   }
   else if(ch=='j')
   {
-    json_arrayt json_steps;
-    convert<json_arrayt>(ns, steps, json_steps);
     ch=tolower(command[1]);
     if(ch==' ')
     {
@@ -164,12 +162,15 @@ void interpretert::command()
       file.open(command+2);
       if(file.is_open())
       {
-        json_steps.output(file);
+        json_stream_arrayt json_steps(file);
+        convert<json_stream_arrayt>(ns, steps, json_steps);
+        json_steps.close();
         file.close();
         return;
       }
     }
-    json_steps.output(result());
+    json_stream_arrayt json_steps(result());
+    convert<json_stream_arrayt>(ns, steps, json_steps);
   }
   else if(ch=='m')
   {
@@ -368,7 +369,7 @@ void interpretert::step()
 /// executes a goto instruction
 void interpretert::execute_goto()
 {
-  if(evaluate_boolean(pc->get_condition()))
+  if(evaluate_condition())
   {
     if(pc->targets.empty())
       throw "taken goto without target";
@@ -660,7 +661,11 @@ void interpretert::execute_assign()
     to_code_assign(pc->code);
 
   mp_vectort rhs;
-  evaluate(code_assign.rhs(), rhs);
+  const auto &compiled_rhs=compiled_instruction().rhs;
+  if(compiled_rhs)
+    rhs.push_back(execute(*compiled_rhs));
+  else
+    evaluate(code_assign.rhs(), rhs);
 
   if(!rhs.empty())
   {
@@ -700,6 +705,70 @@ void interpretert::execute_assign()
   }
 }
 
+/// Compiles the conditions and right-hand sides of assignments in \p body
+/// to bytecode, where possible
+void interpretert::compile_function(const goto_programt &body)
+{
+  for(const auto &instruction : body.instructions)
+  {
+    compiled_instructiont &compiled=compiled_instructions[&instruction];
+
+    if(instruction.is_goto() ||
+       instruction.is_assume() ||
+       instruction.is_assert())
+    {
+      compiled.condition=
+        compile_interpreter_bytecode(instruction.get_condition());
+    }
+    else if(instruction.is_assign())
+    {
+      compiled.rhs=
+        compile_interpreter_bytecode(instruction.get_assign().rhs());
+    }
+  }
+}
+
+/// \return the bytecode for the current instruction, compiling the current
+///   function if it has not been compiled yet
+const interpretert::compiled_instructiont &
+interpretert::compiled_instruction()
+{
+  auto it=compiled_instructions.find(&*pc);
+  if(it==compiled_instructions.end())
+  {
+    compile_function(function->second.body);
+    it=compiled_instructions.find(&*pc);
+    CHECK_RETURN(it!=compiled_instructions.end());
+  }
+  return it->second;
+}
+
+/// Executes \p bytecode, reading symbols from memory like \ref evaluate
+mp_integer interpretert::execute(const interpreter_bytecodet &bytecode)
+{
+  return bytecode.execute(registers, [this](const symbol_exprt &symbol) {
+    const mp_integer address=evaluate_address(symbol);
+    if(address>=memory.size())
+      return mp_integer(0);
+
+    const memory_cellt &cell=memory[numeric_cast_v<std::size_t>(address)];
+    if(cell.initialized==memory_cellt::initializedt::UNKNOWN)
+      cell.initialized=memory_cellt::initializedt::READ_BEFORE_WRITTEN;
+    return cell.value;
+  });
+}
+
+/// Evaluates the condition of the current instruction, using its bytecode
+/// if it could be compiled
+bool interpretert::evaluate_condition()
+{
+  const auto &compiled_condition=compiled_instruction().condition;
+  if(compiled_condition)
+    return execute(*compiled_condition)!=0;
+  else
+    return evaluate_boolean(pc->get_condition());
+}
+
 /// sets the memory at address with the given rhs value (up to sizeof(rhs))
 void interpretert::assign(
   const mp_integer &address,
@@ -728,13 +797,13 @@ void interpretert::assign(
 
 void interpretert::execute_assume()
 {
-  if(!evaluate_boolean(pc->get_condition()))
+  if(!evaluate_condition())
     throw "assumption failed";
 }
 
 void interpretert::execute_assert()
 {
-  if(!evaluate_boolean(pc->get_condition()))
+  if(!evaluate_condition())
   {
     if((target_assert==pc) || stop_on_assertion)
       throw "program assertion reached";
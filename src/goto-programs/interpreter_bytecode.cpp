@@ -0,0 +1,471 @@
+/*******************************************************************\
+
+Module: Bytecode for the Interpreter of GOTO Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Bytecode for the Interpreter of GOTO Programs
+
+#include "interpreter_bytecode.h"
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_types.h>
+
+/// The representation of a scalar type in registers
+struct scalar_typet
+{
+  bool is_signed;
+  std::size_t width;
+};
+
+static optionalt<scalar_typet> scalar_type(const typet &type)
+{
+  if(type.id() == ID_bool)
+    return scalar_typet{false, 1};
+
+  if(
+    type.id() == ID_signedbv || type.id() == ID_unsignedbv ||
+    type.id() == ID_c_bool)
+  {
+    const std::size_t width = to_bitvector_type(type).get_width();
+    if(width == 0 || width > 64)
+      return {};
+    return scalar_typet{type.id() == ID_signedbv, width};
+  }
+
+  return {};
+}
+
+class interpreter_bytecode_compilert
+{
+public:
+  explicit interpreter_bytecode_compilert(interpreter_bytecodet &_bytecode)
+    : bytecode(_bytecode)
+  {
+  }
+
+  /// Emit the instructions computing \p expr
+  /// \return the register holding the value of \p expr, or an empty optional
+  ///   if \p expr is not supported
+  optionalt<interpreter_bytecodet::registert> compile(const exprt &expr);
+
+protected:
+  typedef interpreter_bytecodet::opcodet opcodet;
+  typedef interpreter_bytecodet::registert registert;
+  typedef interpreter_bytecodet::valuet valuet;
+
+  interpreter_bytecodet &bytecode;
+
+  registert new_register()
+  {
+    return static_cast<registert>(bytecode.number_of_registers++);
+  }
+
+  std::size_t emit(
+    opcodet opcode,
+    registert dest,
+    registert op0 = 0,
+    registert op1 = 0,
+    valuet immediate = 0)
+  {
+    bytecode.instructions.push_back({opcode, dest, op0, op1, immediate});
+    return bytecode.instructions.size() - 1;
+  }
+
+  /// Make the jump emitted at \p jump continue after the last instruction
+  /// emitted so far
+  void set_jump_target(std::size_t jump)
+  {
+    bytecode.instructions[jump].immediate = bytecode.instructions.size();
+  }
+
+  /// Bring \p reg into the normal form for \p type
+  void wrap(registert reg, const scalar_typet &type)
+  {
+    if(type.width < 64)
+    {
+      emit(
+        type.is_signed ? opcodet::WRAP_SIGNED : opcodet::WRAP_UNSIGNED,
+        reg,
+        reg,
+        0,
+        type.width);
+    }
+  }
+
+  optionalt<registert> compile_constant(const constant_exprt &expr);
+  optionalt<registert> compile_binary(const exprt &expr, opcodet opcode);
+  optionalt<registert> compile_multi_ary(const exprt &expr, opcodet opcode);
+  optionalt<registert> compile_shift(const exprt &expr, opcodet opcode);
+  optionalt<registert> compile_relation(const exprt &expr);
+  optionalt<registert> compile_and_or(const exprt &expr);
+  optionalt<registert> compile_if(const if_exprt &expr);
+  optionalt<registert> compile_typecast(const typecast_exprt &expr);
+};
+
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_constant(const constant_exprt &expr)
+{
+  const auto type = scalar_type(expr.type());
+  if(!type)
+    return {};
+
+  mp_integer value;
+  if(expr.type().id() == ID_bool)
+    value = expr.is_true() ? 1 : 0;
+  else if(expr.type().id() == ID_c_bool)
+    value = bvrep2integer(expr.get_value(), type->width, false);
+  else if(const auto i = numeric_cast<mp_integer>(expr))
+    value = *i;
+  else
+    return {};
+
+  const registert dest = new_register();
+  emit(
+    opcodet::CONSTANT,
+    dest,
+    0,
+    0,
+    type->is_signed
+      ? interpreter_bytecodet::wrap_signed(
+          interpreter_bytecodet::from_integer(value), type->width)
+      : interpreter_bytecodet::wrap_unsigned(
+          interpreter_bytecodet::from_integer(value), type->width));
+  return dest;
+}
+
+/// Compile an expression with two operands of the same type as the result
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_binary(
+  const exprt &expr,
+  opcodet opcode)
+{
+  const auto type = scalar_type(expr.type());
+  if(
+    !type || expr.operands().size() != 2 ||
+    expr.op0().type() != expr.type() || expr.op1().type() != expr.type())
+  {
+    return {};
+  }
+
+  const auto op0 = compile(expr.op0());
+  if(!op0)
+    return {};
+  const auto op1 = compile(expr.op1());
+  if(!op1)
+    return {};
+
+  const registert dest = new_register();
+  emit(opcode, dest, *op0, *op1);
+  wrap(dest, *type);
+  return dest;
+}
+
+/// Compile an expression with at least one operand, all of the same type as
+/// the result, by applying \p opcode from left to right
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_multi_ary(
+  const exprt &expr,
+  opcodet opcode)
+{
+  const auto type = scalar_type(expr.type());
+  if(!type || expr.operands().empty())
+    return {};
+
+  optionalt<registert> result;
+  for(const auto &operand : expr.operands())
+  {
+    if(operand.type() != expr.type())
+      return {};
+
+    const auto op = compile(operand);
+    if(!op)
+      return {};
+
+    if(!result)
+    {
+      result = op;
+    }
+    else
+    {
+      const registert dest = new_register();
+      emit(opcode, dest, *result, *op);
+      result = dest;
+    }
+  }
+
+  wrap(*result, *type);
+  return result;
+}
+
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_shift(const exprt &expr, opcodet opcode)
+{
+  const auto type = scalar_type(expr.type());
+  if(
+    !type || expr.operands().size() != 2 ||
+    expr.op0().type() != expr.type() || !scalar_type(expr.op1().type()))
+  {
+    return {};
+  }
+
+  const auto op0 = compile(expr.op0());
+  if(!op0)
+    return {};
+  const auto op1 = compile(expr.op1());
+  if(!op1)
+    return {};
+
+  const registert dest = new_register();
+  emit(opcode, dest, *op0, *op1, type->width);
+  wrap(dest, *type);
+  return dest;
+}
+
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_relation(const exprt &expr)
+{
+  if(expr.operands().size() != 2 || expr.op0().type() != expr.op1().type())
+    return {};
+
+  const auto type = scalar_type(expr.op0().type());
+  if(!type)
+    return {};
+
+  const auto op0 = compile(expr.op0());
+  if(!op0)
+    return {};
+  const auto op1 = compile(expr.op1());
+  if(!op1)
+    return {};
+
+  const opcodet lt =
+    type->is_signed ? opcodet::LT_SIGNED : opcodet::LT_UNSIGNED;
+  const opcodet le =
+    type->is_signed ? opcodet::LE_SIGNED : opcodet::LE_UNSIGNED;
+
+  const registert dest = new_register();
+  if(expr.id() == ID_equal)
+    emit(opcodet::EQUAL, dest, *op0, *op1);
+  else if(expr.id() == ID_notequal)
+    emit(opcodet::NOTEQUAL, dest, *op0, *op1);
+  else if(expr.id() == ID_lt)
+    emit(lt, dest, *op0, *op1);
+  else if(expr.id() == ID_le)
+    emit(le, dest, *op0, *op1);
+  else if(expr.id() == ID_gt)
+    emit(lt, dest, *op1, *op0);
+  else if(expr.id() == ID_ge)
+    emit(le, dest, *op1, *op0);
+  else
+    UNREACHABLE;
+  return dest;
+}
+
+/// Compile a conjunction or disjunction, skipping the remaining operands once
+/// the value is known
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_and_or(const exprt &expr)
+{
+  if(!scalar_type(expr.type()) || expr.operands().empty())
+    return {};
+
+  const opcodet skip =
+    expr.id() == ID_and ? opcodet::JUMP_IF_ZERO : opcodet::JUMP_IF_NOT_ZERO;
+
+  const registert dest = new_register();
+  std::vector<std::size_t> jumps;
+
+  for(const auto &operand : expr.operands())
+  {
+    if(!scalar_type(operand.type()))
+      return {};
+
+    const auto op = compile(operand);
+    if(!op)
+      return {};
+
+    emit(opcodet::BOOL, dest, *op);
+    jumps.push_back(emit(skip, 0, dest));
+  }
+
+  for(const auto jump : jumps)
+    set_jump_target(jump);
+
+  return dest;
+}
+
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_if(const if_exprt &expr)
+{
+  if(
+    !scalar_type(expr.type()) || !scalar_type(expr.cond().type()) ||
+    expr.true_case().type() != expr.type() ||
+    expr.false_case().type() != expr.type())
+  {
+    return {};
+  }
+
+  const auto cond = compile(expr.cond());
+  if(!cond)
+    return {};
+
+  const registert dest = new_register();
+
+  const std::size_t jump_to_false_case = emit(opcodet::JUMP_IF_ZERO, 0, *cond);
+  const auto true_case = compile(expr.true_case());
+  if(!true_case)
+    return {};
+  emit(opcodet::MOVE, dest, *true_case);
+  const std::size_t jump_to_end = emit(opcodet::JUMP, 0);
+
+  set_jump_target(jump_to_false_case);
+  const auto false_case = compile(expr.false_case());
+  if(!false_case)
+    return {};
+  emit(opcodet::MOVE, dest, *false_case);
+
+  set_jump_target(jump_to_end);
+  return dest;
+}
+
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile_typecast(const typecast_exprt &expr)
+{
+  const auto type = scalar_type(expr.type());
+  if(!type || !scalar_type(expr.op().type()))
+    return {};
+
+  const auto op = compile(expr.op());
+  if(!op)
+    return {};
+
+  const registert dest = new_register();
+  if(expr.type().id() == ID_bool || expr.type().id() == ID_c_bool)
+  {
+    emit(opcodet::BOOL, dest, *op);
+  }
+  else
+  {
+    emit(opcodet::MOVE, dest, *op);
+    wrap(dest, *type);
+  }
+  return dest;
+}
+
+optionalt<interpreter_bytecodet::registert>
+interpreter_bytecode_compilert::compile(const exprt &expr)
+{
+  const irep_idt &id = expr.id();
+
+  if(id == ID_constant)
+    return compile_constant(to_constant_expr(expr));
+  else if(id == ID_symbol)
+  {
+    const auto type = scalar_type(expr.type());
+    if(!type)
+      return {};
+
+    const registert dest = new_register();
+    emit(opcodet::LOAD, dest, 0, 0, bytecode.symbols.size());
+    bytecode.symbols.push_back(to_symbol_expr(expr));
+    // memory may hold values that the tree-walking evaluator did not
+    // truncate
+    wrap(dest, *type);
+    return dest;
+  }
+  else if(id == ID_plus)
+    return compile_multi_ary(expr, opcodet::PLUS);
+  else if(id == ID_mult)
+    return compile_multi_ary(expr, opcodet::MULT);
+  else if(id == ID_bitand)
+    return compile_multi_ary(expr, opcodet::BITAND);
+  else if(id == ID_bitor)
+    return compile_multi_ary(expr, opcodet::BITOR);
+  else if(id == ID_bitxor)
+    return compile_multi_ary(expr, opcodet::BITXOR);
+  else if(id == ID_minus)
+    return compile_binary(expr, opcodet::MINUS);
+  else if(id == ID_div)
+  {
+    const auto type = scalar_type(expr.type());
+    if(!type)
+      return {};
+    return compile_binary(
+      expr, type->is_signed ? opcodet::DIV_SIGNED : opcodet::DIV_UNSIGNED);
+  }
+  else if(id == ID_unary_minus || id == ID_bitnot)
+  {
+    const auto type = scalar_type(expr.type());
+    if(!type || expr.operands().size() != 1 || expr.op0().type() != expr.type())
+      return {};
+
+    const auto op = compile(expr.op0());
+    if(!op)
+      return {};
+
+    const registert dest = new_register();
+    emit(
+      id == ID_unary_minus ? opcodet::UNARY_MINUS : opcodet::BITNOT,
+      dest,
+      *op);
+    wrap(dest, *type);
+    return dest;
+  }
+  else if(id == ID_shl)
+    return compile_shift(expr, opcodet::SHL);
+  else if(id == ID_lshr)
+    return compile_shift(expr, opcodet::LSHR);
+  else if(id == ID_ashr)
+    return compile_shift(expr, opcodet::ASHR);
+  else if(
+    id == ID_equal || id == ID_notequal || id == ID_lt || id == ID_le ||
+    id == ID_gt || id == ID_ge)
+  {
+    return compile_relation(expr);
+  }
+  else if(id == ID_and || id == ID_or)
+    return compile_and_or(expr);
+  else if(id == ID_not)
+  {
+    if(expr.operands().size() != 1 || !scalar_type(expr.op0().type()))
+      return {};
+
+    const auto op = compile(expr.op0());
+    if(!op)
+      return {};
+
+    const registert dest = new_register();
+    emit(opcodet::NOT, dest, *op);
+    return dest;
+  }
+  else if(id == ID_if)
+    return compile_if(to_if_expr(expr));
+  else if(id == ID_typecast)
+    return compile_typecast(to_typecast_expr(expr));
+
+  return {};
+}
+
+optionalt<interpreter_bytecodet>
+compile_interpreter_bytecode(const exprt &expr)
+{
+  const auto type = scalar_type(expr.type());
+  if(!type)
+    return {};
+
+  interpreter_bytecodet bytecode;
+  interpreter_bytecode_compilert compiler(bytecode);
+
+  const auto result = compiler.compile(expr);
+  if(!result)
+    return {};
+
+  bytecode.result = *result;
+  bytecode.result_is_signed = type->is_signed;
+  return std::move(bytecode);
+}
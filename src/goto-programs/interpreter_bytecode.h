@@ -0,0 +1,272 @@
+/*******************************************************************\
+
+Module: Bytecode for the Interpreter of GOTO Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Bytecode for the Interpreter of GOTO Programs
+
+#ifndef CPROVER_GOTO_PROGRAMS_INTERPRETER_BYTECODE_H
+#define CPROVER_GOTO_PROGRAMS_INTERPRETER_BYTECODE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <util/mp_arith.h>
+#include <util/optional.h>
+#include <util/std_expr.h>
+
+/// A register-based program computing the value of a scalar expression, that
+/// is, one of Boolean, `c_bool` or bit-vector integer type of width at most
+/// 64, whose operands are constants and symbols of such types.
+///
+/// Registers are native 64-bit integers holding the two's complement
+/// representation of a value, sign-extended for signed types and
+/// zero-extended otherwise. Unlike \ref interpretert::evaluate, which
+/// computes with unbounded integers and only truncates on type casts,
+/// arithmetic wraps around at the width of the type of the expression, as
+/// the semantics of goto programs require. Operators that might not be
+/// evaluated, such as the operands of `&&` or the branches of `?:`, are only
+/// evaluated when needed, so that they cannot fail when they are not.
+class interpreter_bytecodet
+{
+public:
+  typedef std::uint64_t valuet;
+  typedef std::uint32_t registert;
+
+  enum class opcodet : std::uint8_t
+  {
+    CONSTANT,         // dest := immediate
+    LOAD,             // dest := value of symbols[immediate]
+    MOVE,             // dest := op0
+    PLUS,             // dest := op0 + op1
+    MINUS,            // dest := op0 - op1
+    MULT,             // dest := op0 * op1
+    DIV_SIGNED,       // dest := op0 / op1, throws if op1 is zero
+    DIV_UNSIGNED,     // dest := op0 / op1, throws if op1 is zero
+    UNARY_MINUS,      // dest := -op0
+    BITAND,           // dest := op0 & op1
+    BITOR,            // dest := op0 | op1
+    BITXOR,           // dest := op0 ^ op1
+    BITNOT,           // dest := ~op0
+    SHL,              // dest := op0 << op1
+    LSHR,             // dest := op0 >> op1, op0 of width immediate
+    ASHR,             // dest := op0 >> op1, op0 of width immediate
+    EQUAL,            // dest := op0 == op1
+    NOTEQUAL,         // dest := op0 != op1
+    LT_SIGNED,        // dest := op0 < op1
+    LE_SIGNED,        // dest := op0 <= op1
+    LT_UNSIGNED,      // dest := op0 < op1
+    LE_UNSIGNED,      // dest := op0 <= op1
+    NOT,              // dest := op0 == 0
+    BOOL,             // dest := op0 != 0
+    WRAP_SIGNED,      // dest := op0 sign-extended from width immediate
+    WRAP_UNSIGNED,    // dest := op0 zero-extended from width immediate
+    JUMP,             // continue at instruction immediate
+    JUMP_IF_ZERO,     // continue at instruction immediate if op0 is zero
+    JUMP_IF_NOT_ZERO, // continue at instruction immediate unless op0 is zero
+  };
+
+  struct instructiont
+  {
+    opcodet opcode;
+    registert dest;
+    registert op0;
+    registert op1;
+    valuet immediate;
+  };
+
+  std::vector<instructiont> instructions;
+
+  /// The symbols read by `LOAD` instructions
+  std::vector<symbol_exprt> symbols;
+
+  std::size_t number_of_registers = 0;
+
+  /// The register holding the value of the expression after execution
+  registert result = 0;
+
+  /// Is the type of the expression signed?
+  bool result_is_signed = false;
+
+  /// Run the program
+  /// \param registers: scratch space, which is resized as needed and may be
+  ///   reused across calls to avoid allocations
+  /// \param load: function returning the `mp_integer` value of the
+  ///   `symbol_exprt` it is given
+  /// \return the value of the expression
+  template <typename loadt>
+  mp_integer execute(std::vector<valuet> &registers, loadt load) const;
+
+  static valuet from_integer(const mp_integer &value)
+  {
+    return value.is_long() ? static_cast<valuet>(value.to_long())
+                           : static_cast<valuet>(value.to_ulong());
+  }
+
+  static valuet wrap_signed(valuet value, std::size_t width)
+  {
+    if(width >= 64)
+      return value;
+    const std::size_t shift = 64 - width;
+    return static_cast<valuet>(
+      static_cast<std::int64_t>(value << shift) >> shift);
+  }
+
+  static valuet wrap_unsigned(valuet value, std::size_t width)
+  {
+    if(width >= 64)
+      return value;
+    return value & ((valuet(1) << width) - 1);
+  }
+};
+
+/// Compile \p expr to bytecode
+/// \param expr: the expression to compile
+/// \return the bytecode, or an empty optional if \p expr uses an operator or
+///   a type that the bytecode does not support, in which case it has to be
+///   evaluated by \ref interpretert::evaluate
+optionalt<interpreter_bytecodet>
+compile_interpreter_bytecode(const exprt &expr);
+
+template <typename loadt>
+mp_integer interpreter_bytecodet::execute(
+  std::vector<valuet> &registers,
+  loadt load) const
+{
+  registers.resize(number_of_registers);
+
+  const std::size_t end = instructions.size();
+  for(std::size_t pc = 0; pc < end; ++pc)
+  {
+    const instructiont &instruction = instructions[pc];
+    const valuet op0 = registers[instruction.op0];
+    const valuet op1 = registers[instruction.op1];
+    valuet &dest = registers[instruction.dest];
+
+    switch(instruction.opcode)
+    {
+    case opcodet::CONSTANT:
+      dest = instruction.immediate;
+      break;
+    case opcodet::LOAD:
+      dest = from_integer(
+        load(symbols[static_cast<std::size_t>(instruction.immediate)]));
+      break;
+    case opcodet::MOVE:
+      dest = op0;
+      break;
+    case opcodet::PLUS:
+      dest = op0 + op1;
+      break;
+    case opcodet::MINUS:
+      dest = op0 - op1;
+      break;
+    case opcodet::MULT:
+      dest = op0 * op1;
+      break;
+    case opcodet::DIV_SIGNED:
+      if(op1 == 0)
+        throw "division by zero";
+      // avoid the overflow of the minimum value divided by -1
+      dest = static_cast<std::int64_t>(op1) == -1
+               ? valuet(0) - op0
+               : static_cast<valuet>(
+                   static_cast<std::int64_t>(op0) /
+                   static_cast<std::int64_t>(op1));
+      break;
+    case opcodet::DIV_UNSIGNED:
+      if(op1 == 0)
+        throw "division by zero";
+      dest = op0 / op1;
+      break;
+    case opcodet::UNARY_MINUS:
+      dest = valuet(0) - op0;
+      break;
+    case opcodet::BITAND:
+      dest = op0 & op1;
+      break;
+    case opcodet::BITOR:
+      dest = op0 | op1;
+      break;
+    case opcodet::BITXOR:
+      dest = op0 ^ op1;
+      break;
+    case opcodet::BITNOT:
+      dest = ~op0;
+      break;
+    case opcodet::SHL:
+      dest = op1 >= 64 ? 0 : op0 << op1;
+      break;
+    case opcodet::LSHR:
+    {
+      const valuet value = wrap_unsigned(
+        op0, static_cast<std::size_t>(instruction.immediate));
+      dest = op1 >= 64 ? 0 : value >> op1;
+      break;
+    }
+    case opcodet::ASHR:
+    {
+      const std::int64_t value = static_cast<std::int64_t>(
+        wrap_signed(op0, static_cast<std::size_t>(instruction.immediate)));
+      dest = static_cast<valuet>(op1 >= 64 ? value >> 63 : value >> op1);
+      break;
+    }
+    case opcodet::EQUAL:
+      dest = op0 == op1;
+      break;
+    case opcodet::NOTEQUAL:
+      dest = op0 != op1;
+      break;
+    case opcodet::LT_SIGNED:
+      dest = static_cast<std::int64_t>(op0) < static_cast<std::int64_t>(op1);
+      break;
+    case opcodet::LE_SIGNED:
+      dest = static_cast<std::int64_t>(op0) <= static_cast<std::int64_t>(op1);
+      break;
+    case opcodet::LT_UNSIGNED:
+      dest = op0 < op1;
+      break;
+    case opcodet::LE_UNSIGNED:
+      dest = op0 <= op1;
+      break;
+    case opcodet::NOT:
+      dest = op0 == 0;
+      break;
+    case opcodet::BOOL:
+      dest = op0 != 0;
+      break;
+    case opcodet::WRAP_SIGNED:
+      dest =
+        wrap_signed(op0, static_cast<std::size_t>(instruction.immediate));
+      break;
+    case opcodet::WRAP_UNSIGNED:
+      dest =
+        wrap_unsigned(op0, static_cast<std::size_t>(instruction.immediate));
+      break;
+    case opcodet::JUMP:
+      // the loop increments pc
+      pc = static_cast<std::size_t>(instruction.immediate) - 1;
+      break;
+    case opcodet::JUMP_IF_ZERO:
+      if(op0 == 0)
+        pc = static_cast<std::size_t>(instruction.immediate) - 1;
+      break;
+    case opcodet::JUMP_IF_NOT_ZERO:
+      if(op0 != 0)
+        pc = static_cast<std::size_t>(instruction.immediate) - 1;
+      break;
+    }
+  }
+
+  const valuet value = registers[result];
+  if(result_is_signed)
+    return mp_integer(static_cast<BigInt::llong_t>(value));
+  else
+    return mp_integer(static_cast<BigInt::ullong_t>(value));
+}
+
+#endif // CPROVER_GOTO_PROGRAMS_INTERPRETER_BYTECODE_H
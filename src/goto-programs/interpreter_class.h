@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_GOTO_PROGRAMS_INTERPRETER_CLASS_H
 
 #include <stack>
+#include <unordered_map>
 
 #include <util/arith_tools.h>
 #include <util/invariant.h>
@@ -22,6 +23,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "goto_functions.h"
 #include "goto_trace.h"
+#include "interpreter_bytecode.h"
 #include "json_goto_trace.h"
 
 class interpretert:public messaget
@@ -284,6 +286,31 @@ protected:
     return v.front()!=0;
   }
 
+  /// Bytecode for the condition of a GOTO, ASSUME or ASSERT instruction and
+  /// for the right-hand side of an assignment, where these can be compiled
+  struct compiled_instructiont
+  {
+    optionalt<interpreter_bytecodet> condition;
+    optionalt<interpreter_bytecodet> rhs;
+  };
+
+  typedef std::unordered_map<
+    const goto_programt::instructiont *,
+    compiled_instructiont>
+    compiled_instructionst;
+
+  /// The instructions of all functions that have been entered so far; each
+  /// function is compiled as a whole the first time it is executed
+  compiled_instructionst compiled_instructions;
+
+  /// Scratch registers for executing bytecode
+  std::vector<interpreter_bytecodet::valuet> registers;
+
+  void compile_function(const goto_programt &body);
+  const compiled_instructiont &compiled_instruction();
+  mp_integer execute(const interpreter_bytecodet &bytecode);
+  bool evaluate_condition();
+
   bool count_type_leaves(
     const typet &source_type,
     mp_integer &result);
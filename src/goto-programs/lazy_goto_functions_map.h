@@ -10,6 +10,7 @@
 
 #include "goto_functions.h"
 #include "goto_convert_functions.h"
+#include "indexed_goto_binary.h"
 
 #include <langapi/language_file.h>
 #include <util/journalling_symbol_table.h>
@@ -74,6 +75,7 @@ private:
   mutable std::unordered_set<irep_idt> processed_functions;
 
   language_filest &language_files;
+  const indexed_goto_binaryt &goto_binary;
   symbol_tablet &symbol_table;
   const post_process_functiont post_process_function;
   const can_generate_function_bodyt driver_program_can_generate_function_body;
@@ -85,6 +87,7 @@ public:
   lazy_goto_functions_mapt(
     underlying_mapt &goto_functions,
     language_filest &language_files,
+    const indexed_goto_binaryt &goto_binary,
     symbol_tablet &symbol_table,
     post_process_functiont post_process_function,
     can_generate_function_bodyt driver_program_can_generate_function_body,
@@ -92,6 +95,7 @@ public:
     message_handlert &message_handler)
   : goto_functions(goto_functions),
     language_files(language_files),
+    goto_binary(goto_binary),
     symbol_table(symbol_table),
     post_process_function(post_process_function),
     driver_program_can_generate_function_body(
@@ -127,6 +131,7 @@ public:
   {
     return
       language_files.can_convert_lazy_method(name) ||
+      goto_binary.has_function(name) ||
       driver_program_can_generate_function_body(name);
   }
 
@@ -179,16 +184,23 @@ private:
 
     goto_functiont function;
 
+    const bool body_in_goto_binary = goto_binary.has_function(name);
+
     // First chance: see if the driver program wants to provide a replacement:
     bool body_provided =
       driver_program_generate_function_body(
         name,
         function_symbol_table,
         function,
-        language_files.can_convert_lazy_method(name));
+        body_in_goto_binary || language_files.can_convert_lazy_method(name));
 
-    // Second chance: see if language_filest can provide a body:
-    if(!body_provided)
+    // Second chance: see if the goto binary has a body:
+    if(!body_provided && body_in_goto_binary)
+    {
+      goto_binary.read_function(name, function_symbol_table, function);
+    }
+    // Third chance: see if language_filest can provide a body:
+    else if(!body_provided)
     {
       // Fill in symbol table entry body if not already done
       language_files.convert_lazy_method(name, function_symbol_table);
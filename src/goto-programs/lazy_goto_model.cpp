@@ -31,6 +31,7 @@ lazy_goto_modelt::lazy_goto_modelt(
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      goto_binary,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -64,6 +65,7 @@ lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      goto_binary,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -81,6 +83,7 @@ lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
       other.driver_program_generate_function_body,
       other.message_handler),
     language_files(std::move(other.language_files)),
+    goto_binary(std::move(other.goto_binary)),
     post_process_function(other.post_process_function),
     post_process_functions(other.post_process_functions),
     message_handler(other.message_handler)
@@ -181,16 +184,42 @@ void lazy_goto_modelt::initialize(
     }
   }
 
-  for(const std::string &file : binaries)
+  if(
+    sources.empty() && binaries.size() == 1 &&
+    indexed_goto_binaryt::is_indexed_goto_binary(binaries.front()))
   {
+    // A single indexed goto binary need not be linked with anything, hence
+    // its function bodies can be read on demand.
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, *goto_model, message_handler))
+    try
+    {
+      goto_binary.open(binaries.front());
+      goto_binary.read_symbol_table(symbol_table);
+    }
+    catch(const deserialization_exceptiont &e)
     {
       source_locationt source_location;
-      source_location.set_file(file);
+      source_location.set_file(binaries.front());
       throw incorrect_goto_program_exceptiont(
-        "failed to read/link goto model", source_location);
+        "failed to read goto model: " + e.what(), source_location);
+    }
+
+    config.set_from_symbol_table(symbol_table);
+  }
+  else
+  {
+    for(const std::string &file : binaries)
+    {
+      msg.status() << "Reading GOTO program from file" << messaget::eom;
+
+      if(read_object_and_link(file, *goto_model, message_handler))
+      {
+        source_locationt source_location;
+        source_location.set_file(file);
+        throw incorrect_goto_program_exceptiont(
+          "failed to read/link goto model", source_location);
+      }
     }
   }
 
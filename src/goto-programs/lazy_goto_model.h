@@ -131,6 +131,7 @@ public:
   {
     goto_model = std::move(other.goto_model);
     language_files = std::move(other.language_files);
+    goto_binary = std::move(other.goto_binary);
     return *this;
   }
 
@@ -266,6 +267,10 @@ private:
   const lazy_goto_functions_mapt goto_functions;
   language_filest language_files;
 
+  /// Goto binary in the indexed format from which function bodies are read
+  /// on demand, if any
+  indexed_goto_binaryt goto_binary;
+
   // Function/module processing functions
   const post_process_functiont post_process_function;
   const post_process_functionst post_process_functions;
@@ -11,9 +11,12 @@ Author: Michael Tautschnig, Daniel Kroening
 
 #include "link_goto_model.h"
 
+#include <exception>
 #include <unordered_set>
 
 #include <util/base_type.h>
+#include <util/message.h>
+#include <util/parallel_for.h>
 #include <util/symbol.h>
 #include <util/rename_symbol.h>
 
@@ -199,3 +202,67 @@ void link_goto_model(
     throw invalid_source_file_exceptiont("linking failed");
   }
 }
+
+/// Link all models in \p src into \p dest. Rather than linking them into
+/// \p dest one by one, which takes time quadratic in the number of models as
+/// each step visits all of \p dest, the models are linked pairwise in a
+/// balanced tree: first `src[1]` into `src[0]`, `src[3]` into `src[2]` and so
+/// on, then the results of the first two pairs, and so on, until everything
+/// has been linked into `src[0]`, which is finally linked into \p dest.
+/// The links of each round are independent and run in up to \p jobs threads,
+/// with their messages passed on in order once the round is complete.
+/// The shape of the tree only depends on the number of models, so the result,
+/// including the names given to file-local symbols to resolve conflicts, does
+/// not depend on \p jobs. These names may differ from those chosen when
+/// linking one model after another, though.
+/// \param dest: goto model to link into
+/// \param src: goto models to link; these are left in an unspecified state
+/// \param message_handler: for diagnostics
+/// \param jobs: maximum number of threads to use
+void link_goto_models(
+  goto_modelt &dest,
+  std::vector<goto_modelt> &src,
+  message_handlert &message_handler,
+  std::size_t jobs)
+{
+  for(std::size_t distance = 1; distance < src.size(); distance *= 2)
+  {
+    std::vector<std::size_t> targets;
+    for(std::size_t i = 0; i + distance < src.size(); i += 2 * distance)
+      targets.push_back(i);
+
+    std::vector<buffered_message_handlert> messages;
+    messages.reserve(targets.size());
+    for(std::size_t t = 0; t < targets.size(); ++t)
+      messages.emplace_back(message_handler);
+
+    std::vector<std::exception_ptr> exceptions(targets.size());
+
+    parallel_for(targets.size(), jobs, [&](std::size_t t) {
+      const std::size_t i = targets[t];
+
+      try
+      {
+        link_goto_model(src[i], src[i + distance], messages[t]);
+      }
+      catch(...)
+      {
+        exceptions[t] = std::current_exception();
+      }
+
+      // release the memory held by the model linked into src[i]
+      src[i + distance] = goto_modelt();
+    });
+
+    for(std::size_t t = 0; t < targets.size(); ++t)
+    {
+      messages[t].replay(message_handler);
+
+      if(exceptions[t])
+        std::rethrow_exception(exceptions[t]);
+    }
+  }
+
+  if(!src.empty())
+    link_goto_model(dest, src.front(), message_handler);
+}
@@ -12,6 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_PROGRAMS_LINK_GOTO_MODEL_H
 #define CPROVER_GOTO_PROGRAMS_LINK_GOTO_MODEL_H
 
+#include <cstddef>
+#include <vector>
+
 class goto_modelt;
 class message_handlert;
 
@@ -20,4 +23,10 @@ void link_goto_model(
   goto_modelt &src,
   message_handlert &);
 
+void link_goto_models(
+  goto_modelt &dest,
+  std::vector<goto_modelt> &src,
+  message_handlert &,
+  std::size_t jobs = 1);
+
 #endif // CPROVER_GOTO_PROGRAMS_LINK_GOTO_MODEL_H
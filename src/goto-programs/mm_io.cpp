@@ -102,23 +102,24 @@ void mm_io(
   }
 }
 
+/// \return the function \p id or nil if there is no such symbol
+static exprt
+mm_io_function(const symbol_table_baset &symbol_table, const irep_idt &id)
+{
+  auto maybe_symbol = symbol_table.lookup(id);
+  if(maybe_symbol)
+    return maybe_symbol->symbol_expr();
+  else
+    return nil_exprt();
+}
+
 void mm_io(
   const symbol_tablet &symbol_table,
   goto_functionst &goto_functions)
 {
   const namespacet ns(symbol_table);
-  exprt mm_io_r=nil_exprt(), mm_io_w=nil_exprt();
-
-  irep_idt id_r=CPROVER_PREFIX "mm_io_r";
-  irep_idt id_w=CPROVER_PREFIX "mm_io_w";
-
-  auto maybe_symbol=symbol_table.lookup(id_r);
-  if(maybe_symbol)
-    mm_io_r=maybe_symbol->symbol_expr();
-
-  maybe_symbol=symbol_table.lookup(id_w);
-  if(maybe_symbol)
-    mm_io_w=maybe_symbol->symbol_expr();
+  const exprt mm_io_r = mm_io_function(symbol_table, CPROVER_PREFIX "mm_io_r");
+  const exprt mm_io_w = mm_io_function(symbol_table, CPROVER_PREFIX "mm_io_w");
 
   for(auto & f : goto_functions.function_map)
     mm_io(mm_io_r, mm_io_w, f.second, ns);
@@ -128,3 +129,13 @@ void mm_io(goto_modelt &model)
 {
   mm_io(model.symbol_table, model.goto_functions);
 }
+
+void mm_io(goto_model_functiont &model_function)
+{
+  const symbol_table_baset &symbol_table = model_function.get_symbol_table();
+  const namespacet ns(symbol_table);
+  const exprt mm_io_r = mm_io_function(symbol_table, CPROVER_PREFIX "mm_io_r");
+  const exprt mm_io_w = mm_io_function(symbol_table, CPROVER_PREFIX "mm_io_w");
+
+  mm_io(mm_io_r, mm_io_w, model_function.get_goto_function(), ns);
+}
@@ -18,5 +18,6 @@ Date:   April 2017
 
 void mm_io(const symbol_tablet &, goto_functionst &);
 void mm_io(goto_modelt &);
+void mm_io(goto_model_functiont &);
 
 #endif // CPROVER_GOTO_PROGRAMS_MM_IO_H
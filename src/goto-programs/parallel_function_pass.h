@@ -0,0 +1,49 @@
+/*******************************************************************\
+
+Module: Parallel Passes over Goto Functions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Run a pass over each goto function in several threads
+
+#ifndef CPROVER_GOTO_PROGRAMS_PARALLEL_FUNCTION_PASS_H
+#define CPROVER_GOTO_PROGRAMS_PARALLEL_FUNCTION_PASS_H
+
+#include <vector>
+
+#include <util/parallel_for.h>
+
+#include "goto_functions.h"
+
+/// Call \p pass(function_id, goto_function) for each function in
+/// \p goto_functions, using up to \p jobs threads (see \ref parallel_for).
+/// The pass may modify the function it is given and may read other parts of
+/// the goto model, such as the symbol table, but must not modify anything
+/// that is shared between functions, including the symbol table and the
+/// location numbers kept by \p goto_functions. Passes that need to do so
+/// should make such changes before or after calling this function.
+/// With one job, functions are processed in the order of the function map.
+template <typename passt>
+void parallel_function_pass(
+  goto_functionst &goto_functions,
+  std::size_t jobs,
+  passt pass)
+{
+  std::vector<goto_functionst::function_mapt::iterator> functions;
+  functions.reserve(goto_functions.function_map.size());
+  for(auto it = goto_functions.function_map.begin();
+      it != goto_functions.function_map.end();
+      ++it)
+  {
+    functions.push_back(it);
+  }
+
+  parallel_for(functions.size(), jobs, [&functions, &pass](std::size_t i) {
+    pass(functions[i]->first, functions[i]->second);
+  });
+}
+
+#endif // CPROVER_GOTO_PROGRAMS_PARALLEL_FUNCTION_PASS_H
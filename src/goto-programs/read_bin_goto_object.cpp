@@ -13,14 +13,162 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
+#include <iterator>
+
+#include <util/exception_utils.h>
 #include <util/namespace.h>
 #include <util/message.h>
 #include <util/symbol_table.h>
 #include <util/irep_serialization.h>
 
 #include "goto_functions.h"
+#include "indexed_goto_binary.h"
 #include "write_goto_binary.h"
 
+/// Read a symbol in goto binary format
+/// \param in: input stream
+/// \param irepconverter: deserializer
+/// \return the symbol
+symbolt read_bin_goto_symbol(
+  std::istream &in,
+  irep_serializationt &irepconverter)
+{
+  symbolt sym;
+
+  sym.type = static_cast<const typet &>(irepconverter.reference_convert(in));
+  sym.value = static_cast<const exprt &>(irepconverter.reference_convert(in));
+  sym.location = static_cast<const source_locationt &>(
+    irepconverter.reference_convert(in));
+
+  sym.name = irepconverter.read_string_ref(in);
+  sym.module = irepconverter.read_string_ref(in);
+  sym.base_name = irepconverter.read_string_ref(in);
+  sym.mode = irepconverter.read_string_ref(in);
+  sym.pretty_name = irepconverter.read_string_ref(in);
+
+  // obsolete: symordering
+  irepconverter.read_gb_word(in);
+
+  std::size_t flags=irepconverter.read_gb_word(in);
+
+  sym.is_weak = (flags &(1 << 16))!=0;
+  sym.is_type = (flags &(1 << 15))!=0;
+  sym.is_property = (flags &(1 << 14))!=0;
+  sym.is_macro = (flags &(1 << 13))!=0;
+  sym.is_exported = (flags &(1 << 12))!=0;
+  sym.is_input = (flags &(1 << 11))!=0;
+  sym.is_output = (flags &(1 << 10))!=0;
+  sym.is_state_var = (flags &(1 << 9))!=0;
+  sym.is_parameter = (flags &(1 << 8))!=0;
+  sym.is_auxiliary = (flags &(1 << 7))!=0;
+  // sym.binding = (flags &(1 << 6))!=0;
+  sym.is_lvalue = (flags &(1 << 5))!=0;
+  sym.is_static_lifetime = (flags &(1 << 4))!=0;
+  sym.is_thread_local = (flags &(1 << 3))!=0;
+  sym.is_file_local = (flags &(1 << 2))!=0;
+  sym.is_extern = (flags &(1 << 1))!=0;
+  sym.is_volatile = (flags &1)!=0;
+
+  return sym;
+}
+
+/// Read the instructions of a goto function in goto binary format
+/// \param in: input stream
+/// \param irepconverter: deserializer
+/// \param [out] body: goto program to append the instructions to
+/// \return true if the function is marked as hidden, false otherwise
+bool read_bin_goto_function_body(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  goto_programt &body)
+{
+  typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
+
+  bool hidden=false;
+
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
+  {
+    goto_programt::targett itarget = body.add_instruction();
+    goto_programt::instructiont &instruction=*itarget;
+
+    instruction.code =
+      static_cast<const codet &>(irepconverter.reference_convert(in));
+    instruction.source_location = static_cast<const source_locationt &>(
+      irepconverter.reference_convert(in));
+    instruction.type = (goto_program_instruction_typet)
+                            irepconverter.read_gb_word(in);
+    instruction.guard =
+      static_cast<const exprt &>(irepconverter.reference_convert(in));
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+      UNREACHABLE;
+
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
+
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count; i++)
+    {
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label == CPROVER_PREFIX "HIDE")
+        hidden=true;
+      // The above info is normally in the type of the goto_functiont object,
+      // which should likely be stored in the binary.
+    }
+  }
+
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
+
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
+    {
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      INVARIANT(
+        entry != rev_target_map.end(),
+        "something from the target map should also be in the reverse target "
+        "map");
+      ins->targets.push_back(entry->second);
+    }
+  }
+
+  body.update();
+
+  return hidden;
+}
+
+/// Mark a function read from a goto binary as hidden
+void read_bin_goto_make_hidden(
+  const irep_idt &function_name,
+  goto_functiont &function,
+  symbol_table_baset &symbol_table)
+{
+  function.make_hidden();
+  // can be removed with the next goto-binary version update as the
+  // information is guaranteed to be stored in the symbol table
+#if GOTO_BINARY_VERSION > 5
+#error This code should be removed
+#endif
+  symbol_table.get_writeable_ref(function_name).set_hidden();
+}
+
 /// read goto binary format
 /// \par parameters: input stream, symbol_table, functions
 /// \return true on error, false otherwise
@@ -34,41 +182,7 @@ static bool read_bin_goto_object(
 
   for(std::size_t i=0; i<count; i++)
   {
-    symbolt sym;
-
-    sym.type = static_cast<const typet &>(irepconverter.reference_convert(in));
-    sym.value = static_cast<const exprt &>(irepconverter.reference_convert(in));
-    sym.location = static_cast<const source_locationt &>(
-      irepconverter.reference_convert(in));
-
-    sym.name = irepconverter.read_string_ref(in);
-    sym.module = irepconverter.read_string_ref(in);
-    sym.base_name = irepconverter.read_string_ref(in);
-    sym.mode = irepconverter.read_string_ref(in);
-    sym.pretty_name = irepconverter.read_string_ref(in);
-
-    // obsolete: symordering
-    irepconverter.read_gb_word(in);
-
-    std::size_t flags=irepconverter.read_gb_word(in);
-
-    sym.is_weak = (flags &(1 << 16))!=0;
-    sym.is_type = (flags &(1 << 15))!=0;
-    sym.is_property = (flags &(1 << 14))!=0;
-    sym.is_macro = (flags &(1 << 13))!=0;
-    sym.is_exported = (flags &(1 << 12))!=0;
-    sym.is_input = (flags &(1 << 11))!=0;
-    sym.is_output = (flags &(1 << 10))!=0;
-    sym.is_state_var = (flags &(1 << 9))!=0;
-    sym.is_parameter = (flags &(1 << 8))!=0;
-    sym.is_auxiliary = (flags &(1 << 7))!=0;
-    // sym.binding = (flags &(1 << 6))!=0;
-    sym.is_lvalue = (flags &(1 << 5))!=0;
-    sym.is_static_lifetime = (flags &(1 << 4))!=0;
-    sym.is_thread_local = (flags &(1 << 3))!=0;
-    sym.is_file_local = (flags &(1 << 2))!=0;
-    sym.is_extern = (flags &(1 << 1))!=0;
-    sym.is_volatile = (flags &1)!=0;
+    symbolt sym = read_bin_goto_symbol(in, irepconverter);
 
     if(!sym.is_type && sym.type.id()==ID_code)
     {
@@ -90,85 +204,8 @@ static bool read_bin_goto_object(
     irep_idt fname=irepconverter.read_gb_string(in);
     goto_functionst::goto_functiont &f = functions.function_map[fname];
 
-    typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
-
-    bool hidden=false;
-
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
-    {
-      goto_programt::targett itarget = f.body.add_instruction();
-      goto_programt::instructiont &instruction=*itarget;
-
-      instruction.code =
-        static_cast<const codet &>(irepconverter.reference_convert(in));
-      instruction.source_location = static_cast<const source_locationt &>(
-        irepconverter.reference_convert(in));
-      instruction.type = (goto_program_instruction_typet)
-                              irepconverter.read_gb_word(in);
-      instruction.guard =
-        static_cast<const exprt &>(irepconverter.reference_convert(in));
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
-      {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label == CPROVER_PREFIX "HIDE")
-          hidden=true;
-        // The above info is normally in the type of the goto_functiont object,
-        // which should likely be stored in the binary.
-      }
-    }
-
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
-    {
-      goto_programt::targett ins = tit->first;
-
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
-      {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        INVARIANT(
-          entry != rev_target_map.end(),
-          "something from the target map should also be in the reverse target "
-          "map");
-        ins->targets.push_back(entry->second);
-      }
-    }
-
-    f.body.update();
-
-    if(hidden)
-    {
-      f.make_hidden();
-      // can be removed with the next goto-binary version update as the
-      // information is guaranteed to be stored in the symbol table
-#if GOTO_BINARY_VERSION > 5
-#error This code should be removed
-#endif
-      symbol_table.get_writeable_ref(fname).set_hidden();
-    }
+    if(read_bin_goto_function_body(in, irepconverter, f.body))
+      read_bin_goto_make_hidden(fname, f, symbol_table);
   }
 
   functions.compute_location_numbers();
@@ -205,6 +242,31 @@ bool read_bin_goto_object(
       {
         // OK!
       }
+      else if(indexed_goto_binaryt::is_indexed_goto_binary_header(hdr))
+      {
+        // the index refers to positions in the binary, hence we read it
+        // completely
+        std::vector<char> contents(hdr, hdr + 4);
+        contents.insert(
+          contents.end(),
+          std::istreambuf_iterator<char>(in),
+          std::istreambuf_iterator<char>());
+
+        try
+        {
+          indexed_goto_binaryt indexed_goto_binary;
+          indexed_goto_binary.load(std::move(contents));
+          indexed_goto_binary.read(symbol_table, functions);
+        }
+        catch(const deserialization_exceptiont &e)
+        {
+          message.error() << "failed to read `" << filename
+                          << "': " << e.what() << messaget::eom;
+          return true;
+        }
+
+        return false;
+      }
       else if(hdr[0]==0x7f && hdr[1]=='E' && hdr[2]=='L' && hdr[3]=='F')
       {
         if(filename!="")
@@ -17,9 +17,16 @@ Date: May 2007
 #include <iosfwd>
 #include <string>
 
-class symbol_tablet;
+#include <util/irep.h>
+
 class goto_functionst;
+class goto_functiont;
+class goto_programt;
+class irep_serializationt;
 class message_handlert;
+class symbol_table_baset;
+class symbol_tablet;
+class symbolt;
 
 bool read_bin_goto_object(
   std::istream &in,
@@ -28,4 +35,18 @@ bool read_bin_goto_object(
   goto_functionst &goto_functions,
   message_handlert &message_handler);
 
+symbolt read_bin_goto_symbol(
+  std::istream &in,
+  irep_serializationt &irepconverter);
+
+bool read_bin_goto_function_body(
+  std::istream &in,
+  irep_serializationt &irepconverter,
+  goto_programt &body);
+
+void read_bin_goto_make_hidden(
+  const irep_idt &function_name,
+  goto_functiont &function,
+  symbol_table_baset &symbol_table);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
@@ -15,12 +15,15 @@ Author:
 #include <unordered_set>
 
 #include <util/message.h>
+#include <util/parallel_for.h>
 #include <util/unicode.h>
 #include <util/tempfile.h>
 #include <util/rename_symbol.h>
 #include <util/config.h>
+#include <util/exception_utils.h>
 
 #include "goto_model.h"
+#include "indexed_goto_binary.h"
 #include "link_goto_model.h"
 #include "read_bin_goto_object.h"
 #include "elf_reader.h"
@@ -83,7 +86,9 @@ static bool read_goto_binary(
   hdr[3]=in.get();
   in.seekg(0);
 
-  if(hdr[0]==0x7f && hdr[1]=='G' && hdr[2]=='B' && hdr[3]=='F')
+  if(
+    (hdr[0] == 0x7f && hdr[1] == 'G' && hdr[2] == 'B' && hdr[3] == 'F') ||
+    indexed_goto_binaryt::is_indexed_goto_binary_header(hdr))
   {
     return read_bin_goto_object(
       in, filename, symbol_table, goto_functions, message_handler);
@@ -166,9 +171,10 @@ bool is_goto_binary(const std::string &filename, message_handlert &)
   if(!in)
     return false;
 
-  // We accept two forms:
+  // We accept three forms:
   // 1. goto binaries, marked with 0x7f GBF
-  // 2. ELF binaries, marked with 0x7f ELF
+  // 2. indexed goto binaries, marked with 0x7f GBI
+  // 3. ELF binaries, marked with 0x7f ELF
 
   char hdr[4];
   hdr[0]=in.get();
@@ -176,7 +182,9 @@ bool is_goto_binary(const std::string &filename, message_handlert &)
   hdr[2]=in.get();
   hdr[3]=in.get();
 
-  if(hdr[0]==0x7f && hdr[1]=='G' && hdr[2]=='B' && hdr[3]=='F')
+  if(
+    (hdr[0] == 0x7f && hdr[1] == 'G' && hdr[2] == 'B' && hdr[3] == 'F') ||
+    indexed_goto_binaryt::is_indexed_goto_binary_header(hdr))
   {
     return true; // yes, this is a goto binary
   }
@@ -249,6 +257,137 @@ bool read_object_and_link(
   return false;
 }
 
+/// Read the goto binaries `file_names[first]` to `file_names[first + size - 1]`
+/// (as far as they exist) and link them pairwise in the same tree as
+/// \ref link_goto_models does. Each file is only read once the models before
+/// it have been linked, so that at most one model per level of the tree is
+/// held at any time.
+/// \param file_names: file names of the goto binaries
+/// \param first: index of the first file of the subtree
+/// \param size: number of leaves of the subtree, a power of two
+/// \param message_handler: for diagnostics
+/// \return the linked model, or an empty optional if reading a file failed
+static optionalt<goto_modelt> read_and_link_subtree(
+  const std::vector<std::string> &file_names,
+  std::size_t first,
+  std::size_t size,
+  message_handlert &message_handler)
+{
+  if(size == 1)
+  {
+    messaget(message_handler).statistics() << "Reading: " << file_names[first]
+                                           << messaget::eom;
+    return read_goto_binary(file_names[first], message_handler);
+  }
+
+  const std::size_t half = size / 2;
+
+  auto left = read_and_link_subtree(file_names, first, half, message_handler);
+  if(!left.has_value() || first + half >= file_names.size())
+    return left;
+
+  auto right =
+    read_and_link_subtree(file_names, first + half, half, message_handler);
+  if(!right.has_value())
+    return {};
+
+  link_goto_model(*left, *right, message_handler);
+  return left;
+}
+
+/// Read the goto binaries \p file_names concurrently and link them with
+/// \ref link_goto_models
+/// \return true on error, false otherwise
+static bool read_and_link_concurrently(
+  const std::vector<std::string> &file_names,
+  goto_modelt &dest,
+  message_handlert &message_handler,
+  std::size_t jobs)
+{
+  std::vector<goto_modelt> models(file_names.size());
+  // not std::vector<bool>, as the threads write to it concurrently
+  std::vector<char> failed(file_names.size(), false);
+  std::vector<buffered_message_handlert> messages;
+  messages.reserve(file_names.size());
+  for(std::size_t i = 0; i < file_names.size(); ++i)
+    messages.emplace_back(message_handler);
+
+  parallel_for(file_names.size(), jobs, [&](std::size_t i) {
+    messaget(messages[i]).statistics() << "Reading: " << file_names[i]
+                                       << messaget::eom;
+
+    auto model = read_goto_binary(file_names[i], messages[i]);
+    if(model.has_value())
+      models[i] = std::move(*model);
+    else
+      failed[i] = true;
+  });
+
+  for(std::size_t i = 0; i < file_names.size(); ++i)
+  {
+    messages[i].replay(message_handler);
+
+    if(failed[i])
+      return true;
+  }
+
+  link_goto_models(dest, models, message_handler, jobs);
+
+  return false;
+}
+
+/// \brief reads object files and links them, and also updates config
+/// The files are linked pairwise in a tree as by \ref link_goto_models, so
+/// that file-local symbols that need to be renamed get the same names
+/// whatever the number of jobs. With a single job, the tree is traversed
+/// depth first and each file is read only when it is linked. With several
+/// jobs, all files are read concurrently and then each level of the tree is
+/// linked concurrently.
+/// \param file_names: file names of the goto binaries
+/// \param dest: the goto model to link into
+/// \param message_handler: for diagnostics
+/// \param jobs: maximum number of threads to use
+/// \return true on error, false otherwise
+bool read_objects_and_link(
+  const std::vector<std::string> &file_names,
+  goto_modelt &dest,
+  message_handlert &message_handler,
+  std::size_t jobs)
+{
+  if(file_names.empty())
+    return false;
+
+  try
+  {
+    if(jobs > 1)
+    {
+      if(read_and_link_concurrently(file_names, dest, message_handler, jobs))
+        return true;
+    }
+    else
+    {
+      std::size_t size = 1;
+      while(size < file_names.size())
+        size *= 2;
+
+      auto model = read_and_link_subtree(file_names, 0, size, message_handler);
+      if(!model.has_value())
+        return true;
+
+      link_goto_model(dest, *model, message_handler);
+    }
+  }
+  catch(const invalid_source_file_exceptiont &)
+  {
+    return true;
+  }
+
+  // reading successful, let's update config
+  config.set_from_symbol_table(dest.symbol_table);
+
+  return false;
+}
+
 /// \brief reads an object file, and also updates the config
 /// \param file_name: file name of the goto binary
 /// \param dest_symbol_table: symbol table to update
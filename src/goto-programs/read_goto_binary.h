@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
 
 #include <string>
+#include <vector>
 
 #include <util/deprecate.h>
 #include <util/optional.h>
@@ -38,4 +39,10 @@ bool read_object_and_link(
   goto_modelt &,
   message_handlert &);
 
+bool read_objects_and_link(
+  const std::vector<std::string> &file_names,
+  goto_modelt &,
+  message_handlert &,
+  std::size_t jobs = 1);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
@@ -18,6 +18,7 @@ Date:   September 2014
 #include <util/std_types.h>
 
 #include "goto_model.h"
+#include "parallel_function_pass.h"
 
 static exprt complex_member(const exprt &expr, irep_idt id)
 {
@@ -298,23 +299,40 @@ static void remove_complex(
 }
 
 /// removes complex data type
-static void remove_complex(goto_functionst &goto_functions)
+static void remove_complex(goto_functionst &goto_functions, std::size_t jobs)
 {
-  Forall_goto_functions(it, goto_functions)
-    remove_complex(it->second);
+  parallel_function_pass(
+    goto_functions,
+    jobs,
+    [](const irep_idt &, goto_functionst::goto_functiont &goto_function) {
+      remove_complex(goto_function);
+    });
 }
 
 /// removes complex data type
 void remove_complex(
   symbol_tablet &symbol_table,
-  goto_functionst &goto_functions)
+  goto_functionst &goto_functions,
+  std::size_t jobs)
 {
   remove_complex(symbol_table);
-  remove_complex(goto_functions);
+  remove_complex(goto_functions, jobs);
 }
 
 /// removes complex data type
-void remove_complex(goto_modelt &goto_model)
+void remove_complex(goto_modelt &goto_model, std::size_t jobs)
 {
-  remove_complex(goto_model.symbol_table, goto_model.goto_functions);
+  remove_complex(goto_model.symbol_table, goto_model.goto_functions, jobs);
+}
+
+/// removes complex data type from a function and from the symbols that were
+/// added to the symbol table while producing it, for use with goto models
+/// that produce function bodies on demand
+void remove_complex(goto_model_functiont &model_function)
+{
+  journalling_symbol_tablet &symbol_table = model_function.get_symbol_table();
+  for(const irep_idt &new_symbol_name : symbol_table.get_inserted())
+    remove_complex(symbol_table.get_writeable_ref(new_symbol_name));
+
+  remove_complex(model_function.get_goto_function());
 }
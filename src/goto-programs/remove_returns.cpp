@@ -15,8 +15,10 @@ Date:   September 2009
 
 #include <util/std_expr.h>
 
-#include "goto_model.h"
+#include <unordered_map>
 
+#include "goto_model.h"
+#include "parallel_function_pass.h"
 #include "remove_skip.h"
 
 class remove_returnst
@@ -30,6 +32,10 @@ public:
   void operator()(
     goto_functionst &goto_functions);
 
+  void operator()(
+    goto_functionst &goto_functions,
+    std::size_t jobs);
+
   void operator()(
     goto_model_functiont &model_function,
     function_is_stubt function_is_stub);
@@ -48,6 +54,11 @@ protected:
     function_is_stubt function_is_stub,
     goto_programt &goto_program);
 
+  void create_return_value_symbols(
+    const irep_idt &function_id,
+    const goto_functionst::goto_functiont &function,
+    function_is_stubt function_is_stub);
+
   bool restore_returns(
     goto_functionst::function_mapt::iterator f_it);
 
@@ -233,6 +244,102 @@ void remove_returnst::operator()(goto_functionst &goto_functions)
   }
 }
 
+/// Add the return-value symbols that \ref replace_returns and
+/// \ref do_function_calls would add for \p function, in the same order, such
+/// that these can then run without modifying the symbol table
+/// \param function_id: name of the function
+/// \param function: function that is about to be transformed
+/// \param function_is_stub: function (irep_idt -> bool) that determines
+///   whether a given function ID is a stub
+void remove_returnst::create_return_value_symbols(
+  const irep_idt &function_id,
+  const goto_functionst::goto_functiont &function,
+  function_is_stubt function_is_stub)
+{
+  if(function.type.return_type() != empty_typet())
+    get_or_create_return_value_symbol(function_id);
+
+  forall_goto_program_instructions(i_it, function.body)
+  {
+    if(!i_it->is_function_call())
+      continue;
+
+    const code_function_callt &function_call = i_it->get_function_call();
+
+    // do_function_calls reports indirect calls
+    if(function_call.function().id() != ID_symbol)
+      continue;
+
+    const irep_idt callee_id =
+      to_symbol_expr(function_call.function()).get_identifier();
+
+    if(
+      to_code_type(function_call.function().type()).return_type() !=
+        empty_typet() &&
+      function_call.lhs().is_not_nil() && !function_is_stub(callee_id))
+    {
+      get_or_create_return_value_symbol(callee_id);
+    }
+  }
+}
+
+/// Remove returns using up to \p jobs threads. All symbols are added to the
+/// symbol table before the function bodies are transformed in parallel, and
+/// the transformed functions are renumbered afterwards, in the same order as
+/// a sequential run would do.
+void remove_returnst::operator()(
+  goto_functionst &goto_functions,
+  std::size_t jobs)
+{
+  if(jobs <= 1)
+  {
+    (*this)(goto_functions);
+    return;
+  }
+
+  // other functions' bodies must not be inspected while they are
+  // transformed
+  std::unordered_map<irep_idt, bool> is_stub;
+  for(const auto &function : goto_functions.function_map)
+    is_stub.emplace(function.first, !function.second.body_available());
+
+  // NOLINTNEXTLINE
+  auto function_is_stub = [&is_stub](const irep_idt &function_id) {
+    auto findit = is_stub.find(function_id);
+    INVARIANT(
+      findit != is_stub.end(),
+      "called function should have some entry in the function map");
+    return findit->second;
+  };
+
+  for(const auto &function : goto_functions.function_map)
+  {
+    create_return_value_symbols(
+      function.first, function.second, function_is_stub);
+  }
+
+  std::unordered_map<irep_idt, bool> updated;
+  for(const auto &function : goto_functions.function_map)
+    updated.emplace(function.first, false);
+
+  parallel_function_pass(
+    goto_functions,
+    jobs,
+    [this, &function_is_stub, &updated](
+      const irep_idt &function_id,
+      goto_functionst::goto_functiont &function) {
+      replace_returns(function_id, function);
+      updated.at(function_id) =
+        do_function_calls(function_is_stub, function.body);
+    });
+
+  for(auto &function : goto_functions.function_map)
+  {
+    if(updated.at(function.first))
+      goto_functions.compute_location_numbers(function.second.body);
+  }
+}
+
 void remove_returnst::operator()(
   goto_model_functiont &model_function,
   function_is_stubt function_is_stub)
@@ -278,11 +385,11 @@ void remove_returns(
   rr(goto_model_function, function_is_stub);
 }
 
-/// removes returns
-void remove_returns(goto_modelt &goto_model)
+/// removes returns, using up to \p jobs threads
+void remove_returns(goto_modelt &goto_model, std::size_t jobs)
 {
   remove_returnst rr(goto_model.symbol_table);
-  rr(goto_model.goto_functions);
+  rr(goto_model.goto_functions, jobs);
 }
 
 /// turns an assignment to fkt#return_value back into 'return x'
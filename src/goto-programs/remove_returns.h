@@ -88,7 +88,7 @@ typedef std::function<bool(const irep_idt &)> function_is_stubt;
 
 void remove_returns(goto_model_functiont &, function_is_stubt);
 
-void remove_returns(goto_modelt &);
+void remove_returns(goto_modelt &, std::size_t jobs = 1);
 
 // reverse the above operations
 void restore_returns(symbol_table_baset &, goto_functionst &);
@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "remove_skip.h"
 #include "goto_model.h"
+#include "parallel_function_pass.h"
 
 /// Determine whether the instruction is semantically equivalent to a skip
 /// (no-op).  This includes a skip, but also if(false) goto ..., goto next;
@@ -191,19 +192,23 @@ void remove_skip(goto_programt &goto_program)
 }
 
 /// remove unnecessary skip statements
-void remove_skip(goto_functionst &goto_functions)
+void remove_skip(goto_functionst &goto_functions, std::size_t jobs)
 {
-  Forall_goto_functions(f_it, goto_functions)
-    remove_skip(
-      f_it->second.body,
-      f_it->second.body.instructions.begin(),
-      f_it->second.body.instructions.end());
+  parallel_function_pass(
+    goto_functions,
+    jobs,
+    [](const irep_idt &, goto_functionst::goto_functiont &goto_function) {
+      remove_skip(
+        goto_function.body,
+        goto_function.body.instructions.begin(),
+        goto_function.body.instructions.end());
+    });
 
   // we may remove targets
   goto_functions.update();
 }
 
-void remove_skip(goto_modelt &goto_model)
+void remove_skip(goto_modelt &goto_model, std::size_t jobs)
 {
-  remove_skip(goto_model.goto_functions);
+  remove_skip(goto_model.goto_functions, jobs);
 }
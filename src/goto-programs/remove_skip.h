@@ -22,8 +22,8 @@ bool is_skip(
   goto_programt::const_targett,
   bool ignore_labels = false);
 void remove_skip(goto_programt &);
-void remove_skip(goto_functionst &);
-void remove_skip(goto_modelt &);
+void remove_skip(goto_functionst &, std::size_t jobs = 1);
+void remove_skip(goto_modelt &, std::size_t jobs = 1);
 
 void remove_skip(
   goto_programt &goto_program,
@@ -18,6 +18,7 @@ Date:   September 2014
 #include <util/std_types.h>
 
 #include "goto_model.h"
+#include "parallel_function_pass.h"
 
 static bool have_to_remove_vector(const typet &type);
 
@@ -208,7 +209,7 @@ static void remove_vector(symbolt &symbol)
 }
 
 /// removes vector data type
-static void remove_vector(symbol_tablet &symbol_table)
+void remove_vector(symbol_tablet &symbol_table)
 {
   for(const auto &named_symbol : symbol_table.symbols)
     remove_vector(symbol_table.get_writeable_ref(named_symbol.first));
@@ -232,23 +233,40 @@ void remove_vector(goto_functionst::goto_functiont &goto_function)
 }
 
 /// removes vector data type
-static void remove_vector(goto_functionst &goto_functions)
+static void remove_vector(goto_functionst &goto_functions, std::size_t jobs)
 {
-  Forall_goto_functions(it, goto_functions)
-    remove_vector(it->second);
+  parallel_function_pass(
+    goto_functions,
+    jobs,
+    [](const irep_idt &, goto_functionst::goto_functiont &goto_function) {
+      remove_vector(goto_function);
+    });
 }
 
 /// removes vector data type
 void remove_vector(
   symbol_tablet &symbol_table,
-  goto_functionst &goto_functions)
+  goto_functionst &goto_functions,
+  std::size_t jobs)
 {
   remove_vector(symbol_table);
-  remove_vector(goto_functions);
+  remove_vector(goto_functions, jobs);
 }
 
 /// removes vector data type
-void remove_vector(goto_modelt &goto_model)
+void remove_vector(goto_modelt &goto_model, std::size_t jobs)
 {
-  remove_vector(goto_model.symbol_table, goto_model.goto_functions);
+  remove_vector(goto_model.symbol_table, goto_model.goto_functions, jobs);
+}
+
+/// removes vector data type from a function and from the symbols that were
+/// added to the symbol table while producing it, for use with goto models
+/// that produce function bodies on demand
+void remove_vector(goto_model_functiont &model_function)
+{
+  journalling_symbol_tablet &symbol_table = model_function.get_symbol_table();
+  for(const irep_idt &new_symbol_name : symbol_table.get_inserted())
+    remove_vector(symbol_table.get_writeable_ref(new_symbol_name));
+
+  remove_vector(model_function.get_goto_function());
 }
@@ -14,12 +14,18 @@ Date:   September 2014
 #ifndef CPROVER_GOTO_PROGRAMS_REMOVE_VECTOR_H
 #define CPROVER_GOTO_PROGRAMS_REMOVE_VECTOR_H
 
+#include <cstddef>
+
 class goto_functionst;
 class goto_modelt;
+class goto_model_functiont;
 class symbol_tablet;
 
-void remove_vector(symbol_tablet &, goto_functionst &);
+void remove_vector(symbol_tablet &, goto_functionst &, std::size_t jobs = 1);
+
+void remove_vector(goto_modelt &, std::size_t jobs = 1);
 
-void remove_vector(goto_modelt &);
+void remove_vector(symbol_tablet &);
+void remove_vector(goto_model_functiont &);
 
 #endif // CPROVER_GOTO_PROGRAMS_REMOVE_VECTOR_H
@@ -17,6 +17,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/byte_operators.h>
 
 #include <goto-programs/goto_model.h>
+#include <goto-programs/parallel_function_pass.h>
 
 #include <util/c_types.h>
 
@@ -114,13 +115,17 @@ void rewrite_union(goto_functionst::goto_functiont &goto_function)
   }
 }
 
-void rewrite_union(goto_functionst &goto_functions)
+void rewrite_union(goto_functionst &goto_functions, std::size_t jobs)
 {
-  Forall_goto_functions(it, goto_functions)
-    rewrite_union(it->second);
+  parallel_function_pass(
+    goto_functions,
+    jobs,
+    [](const irep_idt &, goto_functionst::goto_functiont &goto_function) {
+      rewrite_union(goto_function);
+    });
 }
 
-void rewrite_union(goto_modelt &goto_model)
+void rewrite_union(goto_modelt &goto_model, std::size_t jobs)
 {
-  rewrite_union(goto_model.goto_functions);
+  rewrite_union(goto_model.goto_functions, jobs);
 }
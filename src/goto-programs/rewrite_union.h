@@ -21,7 +21,7 @@ class goto_modelt;
 
 void rewrite_union(exprt &);
 void rewrite_union(goto_functionst::goto_functiont &);
-void rewrite_union(goto_functionst &);
-void rewrite_union(goto_modelt &);
+void rewrite_union(goto_functionst &, std::size_t jobs = 1);
+void rewrite_union(goto_modelt &, std::size_t jobs = 1);
 
 #endif // CPROVER_GOTO_PROGRAMS_REWRITE_UNION_H
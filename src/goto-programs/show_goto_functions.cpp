@@ -36,14 +36,20 @@ void show_goto_functions(
   case ui_message_handlert::uit::XML_UI:
   {
     show_goto_functions_xmlt xml_show_functions(ns, list_only);
-    msg.status() << xml_show_functions.convert(goto_functions);
+    xml_show_functions.convert(
+      goto_functions,
+      ui_message_handler.new_xml_stream(messaget::M_STATUS, "functions"));
+    ui_message_handler.close_xml_stream();
   }
   break;
 
   case ui_message_handlert::uit::JSON_UI:
   {
     show_goto_functions_jsont json_show_functions(ns, list_only);
-    msg.status() << json_show_functions.convert(goto_functions);
+    json_stream_objectt &json_result =
+      ui_message_handler.get_json_stream().push_back_stream_object();
+    json_show_functions.convert(
+      goto_functions, json_result.push_back_stream_array("functions"));
   }
   break;
 
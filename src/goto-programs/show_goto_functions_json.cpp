@@ -32,92 +32,121 @@ show_goto_functions_jsont::show_goto_functions_jsont(
   : ns(_ns), list_only(_list_only)
 {}
 
-/// Walks through all of the functions in the program and returns a JSON object
-/// representing all their functions
-/// \param goto_functions: the goto functions that make up the program
-json_objectt show_goto_functions_jsont::convert(
-  const goto_functionst &goto_functions)
+/// Convert a single function to a JSON object
+/// \param function_name: the name of the function
+/// \param function: the function to convert
+/// \return the JSON object representing the function
+json_objectt show_goto_functions_jsont::convert_function(
+  const irep_idt &function_name,
+  const goto_functionst::goto_functiont &function)
 {
-  json_arrayt json_functions;
   const json_irept no_comments_irep_converter(false);
 
-  const auto sorted = goto_functions.sorted();
-
-  for(const auto &function_entry : sorted)
+  json_objectt json_function;
+  json_function["name"] = json_stringt(function_name);
+  json_function["isBodyAvailable"]=
+    jsont::json_boolean(function.body_available());
+  bool is_internal=
+    has_prefix(id2string(function_name), CPROVER_PREFIX) ||
+    has_prefix(id2string(function_name), "java::array[") ||
+    has_prefix(id2string(function_name), "java::org.cprover") ||
+    has_prefix(id2string(function_name), "java::java");
+  json_function["isInternal"]=jsont::json_boolean(is_internal);
+
+  if(list_only)
+    return json_function;
+
+  if(function.body_available())
   {
-    const irep_idt &function_name = function_entry->first;
-    const goto_functionst::goto_functiont &function = function_entry->second;
-
-    json_objectt &json_function=
-      json_functions.push_back(jsont()).make_object();
-    json_function["name"] = json_stringt(function_name);
-    json_function["isBodyAvailable"]=
-      jsont::json_boolean(function.body_available());
-    bool is_internal=
-      has_prefix(id2string(function_name), CPROVER_PREFIX) ||
-      has_prefix(id2string(function_name), "java::array[") ||
-      has_prefix(id2string(function_name), "java::org.cprover") ||
-      has_prefix(id2string(function_name), "java::java");
-    json_function["isInternal"]=jsont::json_boolean(is_internal);
-
-    if(list_only)
-      continue;
-
-    if(function.body_available())
+    json_arrayt json_instruction_array=json_arrayt();
+
+    for(const goto_programt::instructiont &instruction :
+      function.body.instructions)
     {
-      json_arrayt json_instruction_array=json_arrayt();
+      json_objectt instruction_entry{
+        {"instructionId", json_stringt(instruction.to_string())}};
 
-      for(const goto_programt::instructiont &instruction :
-        function.body.instructions)
+      if(instruction.code.source_location().is_not_nil())
       {
-        json_objectt instruction_entry{
-          {"instructionId", json_stringt(instruction.to_string())}};
-
-        if(instruction.code.source_location().is_not_nil())
-        {
-          instruction_entry["sourceLocation"]=
-            json(instruction.code.source_location());
-        }
-
-        std::ostringstream instruction_builder;
-        function.body.output_instruction(
-          ns, function_name, instruction_builder, instruction);
+        instruction_entry["sourceLocation"]=
+          json(instruction.code.source_location());
+      }
 
-        instruction_entry["instruction"]=
-          json_stringt(instruction_builder.str());
+      std::ostringstream instruction_builder;
+      function.body.output_instruction(
+        ns, function_name, instruction_builder, instruction);
 
-        if(!instruction.code.operands().empty())
-        {
-          json_arrayt operand_array;
-          for(const exprt &operand : instruction.code.operands())
-          {
-            json_objectt operand_object=
-              no_comments_irep_converter.convert_from_irep(
-                operand);
-            operand_array.push_back(operand_object);
-          }
-          instruction_entry["operands"] = std::move(operand_array);
-        }
+      instruction_entry["instruction"]=
+        json_stringt(instruction_builder.str());
 
-        if(!instruction.guard.is_true())
+      if(!instruction.code.operands().empty())
+      {
+        json_arrayt operand_array;
+        for(const exprt &operand : instruction.code.operands())
         {
-          json_objectt guard_object=
+          json_objectt operand_object=
             no_comments_irep_converter.convert_from_irep(
-              instruction.guard);
-
-          instruction_entry["guard"] = std::move(guard_object);
+              operand);
+          operand_array.push_back(operand_object);
         }
+        instruction_entry["operands"] = std::move(operand_array);
+      }
+
+      if(!instruction.guard.is_true())
+      {
+        json_objectt guard_object=
+          no_comments_irep_converter.convert_from_irep(
+            instruction.guard);
 
-        json_instruction_array.push_back(std::move(instruction_entry));
+        instruction_entry["guard"] = std::move(guard_object);
       }
 
-      json_function["instructions"] = std::move(json_instruction_array);
+      json_instruction_array.push_back(std::move(instruction_entry));
     }
+
+    json_function["instructions"] = std::move(json_instruction_array);
+  }
+
+  return json_function;
+}
+
+/// Walks through all of the functions in the program and returns a JSON object
+/// representing all their functions
+/// \param goto_functions: the goto functions that make up the program
+json_objectt show_goto_functions_jsont::convert(
+  const goto_functionst &goto_functions)
+{
+  json_arrayt json_functions;
+
+  const auto sorted = goto_functions.sorted();
+
+  for(const auto &function_entry : sorted)
+  {
+    json_functions.push_back(
+      convert_function(function_entry->first, function_entry->second));
   }
 
   return json_objectt({{"functions", json_functions}});
 }
 
+/// Walks through all of the functions in the program and outputs the JSON
+/// object representing each function as soon as it has been converted, so
+/// that only one function is held in memory at a time
+/// \param goto_functions: the goto functions that make up the program
+/// \param json_functions: the array stream to push the functions to
+void show_goto_functions_jsont::convert(
+  const goto_functionst &goto_functions,
+  json_stream_arrayt &json_functions)
+{
+  const auto sorted = goto_functions.sorted();
+
+  for(const auto &function_entry : sorted)
+  {
+    json_functions.push_back(
+      convert_function(function_entry->first, function_entry->second));
+  }
+}
+
 /// Print the json object generated by
 /// show_goto_functions_jsont::show_goto_functions to the provided stream (e.g.
 /// std::cout)
@@ -13,8 +13,10 @@ Author: Thomas Kiley
 #define CPROVER_GOTO_PROGRAMS_SHOW_GOTO_FUNCTIONS_JSON_H
 
 #include <util/json.h>
+#include <util/json_stream.h>
+
+#include "goto_functions.h"
 
-class goto_functionst;
 class namespacet;
 
 class show_goto_functions_jsont
@@ -25,12 +27,19 @@ public:
     bool _list_only = false);
 
   json_objectt convert(const goto_functionst &goto_functions);
+  void convert(
+    const goto_functionst &goto_functions,
+    json_stream_arrayt &json_functions);
   void operator()(
     const goto_functionst &goto_functions, std::ostream &out, bool append=true);
 
 private:
   const namespacet &ns;
   bool list_only;
+
+  json_objectt convert_function(
+    const irep_idt &function_name,
+    const goto_functionst::goto_functiont &function);
 };
 
 #endif // CPROVER_GOTO_PROGRAMS_SHOW_GOTO_FUNCTIONS_JSON_H
@@ -32,6 +32,59 @@ show_goto_functions_xmlt::show_goto_functions_xmlt(
   : ns(_ns), list_only(_list_only)
 {}
 
+/// Convert a single function to an xml object
+/// \param function_name: the name of the function
+/// \param function: the function to convert
+/// \return the xml object representing the function
+xmlt show_goto_functions_xmlt::convert_function(
+  const irep_idt &function_name,
+  const goto_functionst::goto_functiont &function)
+{
+  xmlt xml_function("function");
+  xml_function.set_attribute("name", id2string(function_name));
+  xml_function.set_attribute_bool(
+    "is_body_available", function.body_available());
+  bool is_internal=
+    has_prefix(id2string(function_name), CPROVER_PREFIX) ||
+    has_prefix(id2string(function_name), "java::array[") ||
+    has_prefix(id2string(function_name), "java::org.cprover") ||
+    has_prefix(id2string(function_name), "java::java");
+  xml_function.set_attribute_bool("is_internal", is_internal);
+
+  if(list_only)
+    return xml_function;
+
+  if(function.body_available())
+  {
+    xmlt &xml_instructions=xml_function.new_element("instructions");
+    for(const goto_programt::instructiont &instruction :
+      function.body.instructions)
+    {
+      xmlt &instruction_entry=xml_instructions.new_element("instruction");
+
+      instruction_entry.set_attribute(
+        "instruction_id", instruction.to_string());
+
+      if(instruction.code.source_location().is_not_nil())
+      {
+        instruction_entry.new_element(
+          xml(instruction.code.source_location()));
+      }
+
+      std::ostringstream instruction_builder;
+      function.body.output_instruction(
+        ns, function_name, instruction_builder, instruction);
+
+      xmlt &instruction_value=
+        instruction_entry.new_element("instruction_value");
+      instruction_value.data=instruction_builder.str();
+      instruction_value.elements.clear();
+    }
+  }
+
+  return xml_function;
+}
+
 /// Walks through all of the functions in the program and returns an xml object
 /// representing all their functions. Produces output like this: \code{.xml}
 /// <functions>
@@ -50,52 +103,29 @@ xmlt show_goto_functions_xmlt::convert(
 
   for(const auto &function_entry : sorted)
   {
-    const irep_idt &function_name = function_entry->first;
-    const goto_functionst::goto_functiont &function = function_entry->second;
-
-    xmlt &xml_function=xml_functions.new_element("function");
-    xml_function.set_attribute("name", id2string(function_name));
-    xml_function.set_attribute_bool(
-      "is_body_available", function.body_available());
-    bool is_internal=
-      has_prefix(id2string(function_name), CPROVER_PREFIX) ||
-      has_prefix(id2string(function_name), "java::array[") ||
-      has_prefix(id2string(function_name), "java::org.cprover") ||
-      has_prefix(id2string(function_name), "java::java");
-    xml_function.set_attribute_bool("is_internal", is_internal);
-
-    if(list_only)
-      continue;
-
-    if(function.body_available())
-    {
-      xmlt &xml_instructions=xml_function.new_element("instructions");
-      for(const goto_programt::instructiont &instruction :
-        function.body.instructions)
-      {
-        xmlt &instruction_entry=xml_instructions.new_element("instruction");
-
-        instruction_entry.set_attribute(
-          "instruction_id", instruction.to_string());
+    xml_functions.new_element(
+      convert_function(function_entry->first, function_entry->second));
+  }
 
-        if(instruction.code.source_location().is_not_nil())
-        {
-          instruction_entry.new_element(
-            xml(instruction.code.source_location()));
-        }
+  return xml_functions;
+}
 
-        std::ostringstream instruction_builder;
-        function.body.output_instruction(
-          ns, function_name, instruction_builder, instruction);
+/// Walks through all of the functions in the program and outputs the xml
+/// object representing each function as soon as it has been converted, so
+/// that only one function is held in memory at a time
+/// \param goto_functions: the goto functions that make up the program
+/// \param xml_functions: the stream of the `functions` element
+void show_goto_functions_xmlt::convert(
+  const goto_functionst &goto_functions,
+  xml_streamt &xml_functions)
+{
+  const auto sorted = goto_functions.sorted();
 
-        xmlt &instruction_value=
-          instruction_entry.new_element("instruction_value");
-        instruction_value.data=instruction_builder.str();
-        instruction_value.elements.clear();
-      }
-    }
+  for(const auto &function_entry : sorted)
+  {
+    xml_functions.push_back(
+      convert_function(function_entry->first, function_entry->second));
   }
-  return xml_functions;
 }
 
 /// Print the xml object generated by
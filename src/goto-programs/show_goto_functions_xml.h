@@ -13,8 +13,10 @@ Author: Thomas Kiley
 #define CPROVER_GOTO_PROGRAMS_SHOW_GOTO_FUNCTIONS_XML_H
 
 #include <util/xml.h>
+#include <util/xml_stream.h>
+
+#include "goto_functions.h"
 
-class goto_functionst;
 class namespacet;
 
 class show_goto_functions_xmlt
@@ -25,12 +27,18 @@ public:
     bool _list_only = false);
 
   xmlt convert(const goto_functionst &goto_functions);
+  void
+  convert(const goto_functionst &goto_functions, xml_streamt &xml_functions);
   void operator()(
     const goto_functionst &goto_functions, std::ostream &out, bool append=true);
 
 private:
   const namespacet &ns;
   bool list_only;
+
+  xmlt convert_function(
+    const irep_idt &function_name,
+    const goto_functionst::goto_functiont &function);
 };
 
 #endif // CPROVER_GOTO_PROGRAMS_SHOW_GOTO_FUNCTIONS_XML_H
@@ -109,8 +109,9 @@ void show_properties(
   }
 }
 
-void convert_properties_json(
-  json_arrayt &json_properties,
+template <typename json_arrayT>
+static void convert_properties(
+  json_arrayT &json_properties,
   const namespacet &ns,
   const irep_idt &identifier,
   const goto_programt &goto_program)
@@ -146,19 +147,38 @@ void convert_properties_json(
   }
 }
 
-void show_properties_json(
+void convert_properties_json(
+  json_arrayt &json_properties,
   const namespacet &ns,
-  message_handlert &message_handler,
+  const irep_idt &identifier,
+  const goto_programt &goto_program)
+{
+  convert_properties(json_properties, ns, identifier, goto_program);
+}
+
+void convert_properties_json(
+  json_stream_arrayt &json_properties,
+  const namespacet &ns,
+  const irep_idt &identifier,
+  const goto_programt &goto_program)
+{
+  convert_properties(json_properties, ns, identifier, goto_program);
+}
+
+/// Output the properties of all functions, each as soon as it has been
+/// converted
+static void show_properties_json(
+  const namespacet &ns,
+  ui_message_handlert &ui_message_handler,
   const goto_functionst &goto_functions)
 {
-  messaget msg(message_handler);
-  json_arrayt json_properties;
+  json_stream_objectt &json_result =
+    ui_message_handler.get_json_stream().push_back_stream_object();
+  json_stream_arrayt &json_properties =
+    json_result.push_back_stream_array("properties");
 
   for(const auto &fct : goto_functions.function_map)
     convert_properties_json(json_properties, ns, fct.first, fct.second.body);
-
-  json_objectt json_result{{"properties", json_properties}};
-  msg.result() << json_result;
 }
 
 void show_properties(
@@ -61,4 +61,15 @@ void convert_properties_json(
   const irep_idt &identifier,
   const goto_programt &goto_program);
 
+/// \brief Outputs the properties in the goto program to a JSON array stream
+/// \param json_properties: JSON array stream to output the properties to
+/// \param ns: namespace
+/// \param identifier: function id of the goto program
+/// \param goto_program: the goto program
+void convert_properties_json(
+  json_stream_arrayt &json_properties,
+  const namespacet &ns,
+  const irep_idt &identifier,
+  const goto_programt &goto_program);
+
 #endif // CPROVER_GOTO_PROGRAMS_SHOW_PROPERTIES_H
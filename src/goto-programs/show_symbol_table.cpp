@@ -19,11 +19,87 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/mode.h>
 
 #include <util/json_irep.h>
+#include <util/xml_irep.h>
 
 #include "goto_model.h"
 
-void show_symbol_table_xml_ui()
+static void show_symbol_table_xml_ui(
+  const symbol_tablet &symbol_table,
+  bool brief,
+  ui_message_handlert &message_handler)
 {
+  xml_streamt &result =
+    message_handler.new_xml_stream(messaget::M_RESULT, "symbol_table");
+
+  const namespacet ns(symbol_table);
+
+  for(const auto &id_and_symbol : symbol_table.symbols)
+  {
+    const symbolt &symbol = id_and_symbol.second;
+
+    std::unique_ptr<languaget> ptr;
+
+    if(symbol.mode=="")
+    {
+      ptr=get_default_language();
+    }
+    else
+    {
+      ptr=get_language_from_mode(symbol.mode);
+    }
+
+    if(!ptr)
+      throw "symbol "+id2string(symbol.name)+" has unknown mode";
+
+    std::string type_str, value_str;
+
+    if(symbol.type.is_not_nil())
+      ptr->from_type(symbol.type, type_str, ns);
+
+    xmlt symbol_xml(
+      "symbol",
+      {{"name", id2string(symbol.name)},
+       {"pretty_name", id2string(symbol.pretty_name)},
+       {"base_name", id2string(symbol.base_name)},
+       {"mode", id2string(symbol.mode)},
+       {"module", id2string(symbol.module)}},
+      {});
+
+    symbol_xml.new_element("pretty_type").data = type_str;
+
+    if(!brief)
+    {
+      if(symbol.value.is_not_nil())
+        ptr->from_expr(symbol.value, value_str, ns);
+
+      symbol_xml.new_element("pretty_value").data = value_str;
+
+      if(symbol.location.is_not_nil())
+        symbol_xml.new_element(xml(symbol.location));
+
+      symbol_xml.set_attribute_bool("is_type", symbol.is_type);
+      symbol_xml.set_attribute_bool("is_macro", symbol.is_macro);
+      symbol_xml.set_attribute_bool("is_exported", symbol.is_exported);
+      symbol_xml.set_attribute_bool("is_input", symbol.is_input);
+      symbol_xml.set_attribute_bool("is_output", symbol.is_output);
+      symbol_xml.set_attribute_bool("is_state_var", symbol.is_state_var);
+      symbol_xml.set_attribute_bool("is_property", symbol.is_property);
+      symbol_xml.set_attribute_bool(
+        "is_static_lifetime", symbol.is_static_lifetime);
+      symbol_xml.set_attribute_bool("is_thread_local", symbol.is_thread_local);
+      symbol_xml.set_attribute_bool("is_lvalue", symbol.is_lvalue);
+      symbol_xml.set_attribute_bool("is_file_local", symbol.is_file_local);
+      symbol_xml.set_attribute_bool("is_extern", symbol.is_extern);
+      symbol_xml.set_attribute_bool("is_volatile", symbol.is_volatile);
+      symbol_xml.set_attribute_bool("is_parameter", symbol.is_parameter);
+      symbol_xml.set_attribute_bool("is_auxiliary", symbol.is_auxiliary);
+      symbol_xml.set_attribute_bool("is_weak", symbol.is_weak);
+    }
+
+    result.push_back(symbol_xml);
+  }
+
+  message_handler.close_xml_stream();
 }
 
 void show_symbol_table_brief_plain(
@@ -290,7 +366,7 @@ void show_symbol_table(
     break;
 
   case ui_message_handlert::uit::XML_UI:
-    show_symbol_table_xml_ui();
+    show_symbol_table_xml_ui(symbol_table, false, ui);
     break;
 
   case ui_message_handlert::uit::JSON_UI:
@@ -319,7 +395,7 @@ void show_symbol_table_brief(
     break;
 
   case ui_message_handlert::uit::XML_UI:
-    show_symbol_table_xml_ui();
+    show_symbol_table_xml_ui(symbol_table, true, ui);
     break;
 
   default:
@@ -9,10 +9,13 @@ Date: Oct 2018
 
 #include "validate_goto_model.h"
 
+#include <algorithm>
 #include <set>
 
 #include <util/invariant.h>
+#include <util/parallel_for.h>
 
+#include "abstract_goto_model.h"
 #include "goto_functions.h"
 
 namespace
@@ -22,8 +25,11 @@ class validate_goto_modelt
 public:
   using function_mapt = goto_functionst::function_mapt;
 
+  /// Run the checks selected by \p goto_model_validation_options on
+  /// \p functions, which are functions of \p goto_functions
   validate_goto_modelt(
     const goto_functionst &goto_functions,
+    std::vector<const goto_functionst::goto_functiont *> functions,
     const validation_modet vm,
     const goto_model_validation_optionst goto_model_validation_options);
 
@@ -60,15 +66,30 @@ private:
   /// initialise a function pointer will have no body.
   void check_called_functions();
 
+  /// Call \p check on each goto function, using up to #jobs threads
+  template <typename checkt>
+  void for_each_function(checkt check) const
+  {
+    parallel_for(functions.size(), jobs, [&](std::size_t i) {
+      check(*functions[i]);
+    });
+  }
+
   const validation_modet vm;
   const function_mapt &function_map;
+  const std::size_t jobs;
+  std::vector<const goto_functionst::goto_functiont *> functions;
 };
 
 validate_goto_modelt::validate_goto_modelt(
   const goto_functionst &goto_functions,
+  std::vector<const goto_functionst::goto_functiont *> functions,
   const validation_modet vm,
   const goto_model_validation_optionst validation_options)
-  : vm{vm}, function_map{goto_functions.function_map}
+  : vm{vm},
+    function_map{goto_functions.function_map},
+    jobs{validation_options.jobs},
+    functions{std::move(functions)}
 {
   if(validation_options.entry_point_exists)
     entry_point_exists();
@@ -100,9 +121,8 @@ void validate_goto_modelt::entry_point_exists()
 
 void validate_goto_modelt::function_pointer_calls_removed()
 {
-  for(const auto &fun : function_map)
-  {
-    for(const auto &instr : fun.second.body.instructions)
+  for_each_function([this](const goto_functiont &goto_function) {
+    for(const auto &instr : goto_function.body.instructions)
     {
       if(instr.is_function_call())
       {
@@ -113,15 +133,12 @@ void validate_goto_modelt::function_pointer_calls_removed()
           "no calls via function pointer should be present");
       }
     }
-  }
+  });
 }
 
 void validate_goto_modelt::check_returns_removed()
 {
-  for(const auto &fun : function_map)
-  {
-    const goto_functiont &goto_function = fun.second;
-
+  for_each_function([this](const goto_functiont &goto_function) {
     for(const auto &instr : goto_function.body.instructions)
     {
       DATA_CHECK(
@@ -136,7 +153,7 @@ void validate_goto_modelt::check_returns_removed()
           "function call lhs return should be nil");
       }
     }
-  }
+  });
 }
 
 void validate_goto_modelt::check_called_functions()
@@ -160,9 +177,8 @@ void validate_goto_modelt::check_called_functions()
       }
     };
 
-  for(const auto &fun : function_map)
-  {
-    for(const auto &instr : fun.second.body.instructions)
+  for_each_function([&](const goto_functiont &goto_function) {
+    for(const auto &instr : goto_function.body.instructions)
     {
       // check functions that are called
       if(instr.is_function_call())
@@ -181,7 +197,7 @@ void validate_goto_modelt::check_called_functions()
       const auto &src = static_cast<const exprt &>(instr.code);
       src.visit_pre(test_for_function_address);
     }
-  }
+  });
 }
 
 } // namespace
@@ -191,5 +207,70 @@ void validate_goto_model(
   const validation_modet vm,
   const goto_model_validation_optionst validation_options)
 {
-  validate_goto_modelt{goto_functions, vm, validation_options};
+  std::vector<const goto_functionst::goto_functiont *> functions;
+  functions.reserve(goto_functions.function_map.size());
+  for(const auto &fun : goto_functions.function_map)
+    functions.push_back(&fun.second);
+
+  validate_goto_modelt{
+    goto_functions, std::move(functions), vm, validation_options};
+}
+
+/// True if the checks of the whole function map selected by \p a and \p b
+/// are the same
+static bool same_checks(
+  const goto_model_validation_optionst &a,
+  const goto_model_validation_optionst &b)
+{
+  return a.function_pointer_calls_removed ==
+           b.function_pointer_calls_removed &&
+         a.check_returns_removed == b.check_returns_removed &&
+         a.check_called_functions == b.check_called_functions;
+}
+
+void incremental_goto_model_validatort::operator()(
+  const abstract_goto_modelt &goto_model,
+  const validation_modet vm,
+  const goto_model_validation_optionst &validation_options)
+{
+  const symbol_tablet &symbol_table = goto_model.get_symbol_table();
+  const goto_functionst &goto_functions = goto_model.get_goto_functions();
+
+  symbol_table.validate(vm);
+
+  // the hashes of all functions are only recorded once all checks pass
+  goto_functionst::validated_functionst hashes = validated;
+  const namespacet ns(symbol_table);
+  goto_functions.validate(ns, vm, validation_options.jobs, &hashes);
+
+  // Unchanged functions are only checked again if other checks are
+  // selected, or if a function has been removed, as a call to it may remain.
+  const bool check_all =
+    !last_options.has_value() ||
+    !same_checks(*last_options, validation_options) ||
+    std::any_of(
+      validated.begin(),
+      validated.end(),
+      [&goto_functions](
+        const goto_functionst::validated_functionst::value_type &entry) {
+        return goto_functions.function_map.count(entry.first) == 0;
+      });
+
+  std::vector<const goto_functionst::goto_functiont *> functions;
+  for(const auto &fun : goto_functions.function_map)
+  {
+    const auto entry = validated.find(fun.first);
+    if(
+      check_all || entry == validated.end() ||
+      entry->second != hashes.at(fun.first))
+    {
+      functions.push_back(&fun.second);
+    }
+  }
+
+  validate_goto_modelt{
+    goto_functions, std::move(functions), vm, validation_options};
+
+  validated.swap(hashes);
+  last_options = validation_options;
 }
@@ -10,8 +10,11 @@ Date: Oct 2018
 #ifndef CPROVER_GOTO_PROGRAMS_VALIDATE_GOTO_MODEL_H
 #define CPROVER_GOTO_PROGRAMS_VALIDATE_GOTO_MODEL_H
 
+#include <util/optional.h>
 #include <util/validate.h>
 
+#include "goto_functions.h"
+
 class goto_model_validation_optionst final
 {
 public:
@@ -23,6 +26,9 @@ public:
   bool check_returns_removed = true;
   bool check_called_functions = true;
 
+  /// Maximum number of threads checking goto functions
+  std::size_t jobs = 1;
+
 private:
   void set_all_flags(bool options_value)
   {
@@ -55,11 +61,44 @@ public:
   }
 };
 
-class goto_functionst;
-
 void validate_goto_model(
   const goto_functionst &goto_functions,
   const validation_modet vm,
   const goto_model_validation_optionst validation_options);
 
+class abstract_goto_modelt;
+
+/// Validates a goto model repeatedly, for example after each pass that
+/// transforms it, only checking the goto functions that have changed since
+/// they last passed validation. This applies both to the checks of each
+/// function and to those of \ref validate_goto_model, which are run on all
+/// functions again if other checks are selected or a function has been
+/// removed. The symbol table is validated in full every time.
+/// A function that has not changed is not checked again when only other
+/// symbols it refers to have changed, which a full validation with
+/// \ref abstract_goto_modelt::validate would detect.
+class incremental_goto_model_validatort
+{
+public:
+  /// Validate \p goto_model, with the checks selected by
+  /// \p validation_options
+  void operator()(
+    const abstract_goto_modelt &goto_model,
+    const validation_modet vm,
+    const goto_model_validation_optionst &validation_options);
+
+  /// Forget all earlier validations, so that the next one checks all goto
+  /// functions
+  void clear()
+  {
+    validated.clear();
+    last_options.reset();
+  }
+
+private:
+  goto_functionst::validated_functionst validated;
+  /// Options of the last validation that passed
+  optionalt<goto_model_validation_optionst> last_options;
+};
+
 #endif // CPROVER_GOTO_PROGRAMS_VALIDATE_GOTO_MODEL_H
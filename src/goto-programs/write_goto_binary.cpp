@@ -21,6 +21,82 @@ Author: CM Wintersteiger
 
 #include <goto-programs/goto_model.h>
 
+/// Writes a symbol in goto binary format
+void write_goto_binary_symbol(
+  std::ostream &out,
+  const symbolt &sym,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, symbols are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  irepconverter.reference_convert(sym.type, out);
+  irepconverter.reference_convert(sym.value, out);
+  irepconverter.reference_convert(sym.location, out);
+
+  irepconverter.write_string_ref(out, sym.name);
+  irepconverter.write_string_ref(out, sym.module);
+  irepconverter.write_string_ref(out, sym.base_name);
+  irepconverter.write_string_ref(out, sym.mode);
+  irepconverter.write_string_ref(out, sym.pretty_name);
+
+  write_gb_word(out, 0); // old: sym.ordering
+
+  unsigned flags=0;
+  flags = (flags << 1) | static_cast<int>(sym.is_weak);
+  flags = (flags << 1) | static_cast<int>(sym.is_type);
+  flags = (flags << 1) | static_cast<int>(sym.is_property);
+  flags = (flags << 1) | static_cast<int>(sym.is_macro);
+  flags = (flags << 1) | static_cast<int>(sym.is_exported);
+  flags = (flags << 1) | static_cast<int>(sym.is_input);
+  flags = (flags << 1) | static_cast<int>(sym.is_output);
+  flags = (flags << 1) | static_cast<int>(sym.is_state_var);
+  flags = (flags << 1) | static_cast<int>(sym.is_parameter);
+  flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
+  flags = (flags << 1) | static_cast<int>(false); // sym.binding;
+  flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
+  flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
+  flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_file_local);
+  flags = (flags << 1) | static_cast<int>(sym.is_extern);
+  flags = (flags << 1) | static_cast<int>(sym.is_volatile);
+
+  write_gb_word(out, flags);
+}
+
+/// Writes the instructions of a goto function in goto binary format
+void write_goto_binary_function_body(
+  std::ostream &out,
+  const goto_programt &body,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, goto functions are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  write_gb_word(out, body.instructions.size()); // # instructions
+
+  forall_goto_program_instructions(i_it, body)
+  {
+    const goto_programt::instructiont &instruction = *i_it;
+
+    irepconverter.reference_convert(instruction.code, out);
+    irepconverter.reference_convert(instruction.source_location, out);
+    write_gb_word(out, (long)instruction.type);
+    irepconverter.reference_convert(instruction.guard, out);
+    write_gb_word(out, instruction.target_number);
+
+    write_gb_word(out, instruction.targets.size());
+
+    for(const auto &t_it : instruction.targets)
+      write_gb_word(out, t_it->target_number);
+
+    write_gb_word(out, instruction.labels.size());
+
+    for(const auto &l_it : instruction.labels)
+      irepconverter.write_string_ref(out, l_it);
+  }
+}
+
 /// Writes a goto program to disc, using goto binary format
 bool write_goto_binary(
   std::ostream &out,
@@ -33,45 +109,7 @@ bool write_goto_binary(
   write_gb_word(out, symbol_table.symbols.size());
 
   for(const auto &symbol_pair : symbol_table.symbols)
-  {
-    // Since version 2, symbols are not converted to ireps,
-    // instead they are saved in a custom binary format
-
-    const symbolt &sym = symbol_pair.second;
-
-    irepconverter.reference_convert(sym.type, out);
-    irepconverter.reference_convert(sym.value, out);
-    irepconverter.reference_convert(sym.location, out);
-
-    irepconverter.write_string_ref(out, sym.name);
-    irepconverter.write_string_ref(out, sym.module);
-    irepconverter.write_string_ref(out, sym.base_name);
-    irepconverter.write_string_ref(out, sym.mode);
-    irepconverter.write_string_ref(out, sym.pretty_name);
-
-    write_gb_word(out, 0); // old: sym.ordering
-
-    unsigned flags=0;
-    flags = (flags << 1) | static_cast<int>(sym.is_weak);
-    flags = (flags << 1) | static_cast<int>(sym.is_type);
-    flags = (flags << 1) | static_cast<int>(sym.is_property);
-    flags = (flags << 1) | static_cast<int>(sym.is_macro);
-    flags = (flags << 1) | static_cast<int>(sym.is_exported);
-    flags = (flags << 1) | static_cast<int>(sym.is_input);
-    flags = (flags << 1) | static_cast<int>(sym.is_output);
-    flags = (flags << 1) | static_cast<int>(sym.is_state_var);
-    flags = (flags << 1) | static_cast<int>(sym.is_parameter);
-    flags = (flags << 1) | static_cast<int>(sym.is_auxiliary);
-    flags = (flags << 1) | static_cast<int>(false); // sym.binding;
-    flags = (flags << 1) | static_cast<int>(sym.is_lvalue);
-    flags = (flags << 1) | static_cast<int>(sym.is_static_lifetime);
-    flags = (flags << 1) | static_cast<int>(sym.is_thread_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_file_local);
-    flags = (flags << 1) | static_cast<int>(sym.is_extern);
-    flags = (flags << 1) | static_cast<int>(sym.is_volatile);
-
-    write_gb_word(out, flags);
-  }
+    write_goto_binary_symbol(out, symbol_pair.second, irepconverter);
 
   // now write functions, but only those with body
 
@@ -86,32 +124,8 @@ bool write_goto_binary(
   {
     if(fct.second.body_available())
     {
-      // Since version 2, goto functions are not converted to ireps,
-      // instead they are saved in a custom binary format
-
       write_gb_string(out, id2string(fct.first)); // name
-      write_gb_word(out, fct.second.body.instructions.size()); // # instructions
-
-      forall_goto_program_instructions(i_it, fct.second.body)
-      {
-        const goto_programt::instructiont &instruction = *i_it;
-
-        irepconverter.reference_convert(instruction.code, out);
-        irepconverter.reference_convert(instruction.source_location, out);
-        write_gb_word(out, (long)instruction.type);
-        irepconverter.reference_convert(instruction.guard, out);
-        write_gb_word(out, instruction.target_number);
-
-        write_gb_word(out, instruction.targets.size());
-
-        for(const auto &t_it : instruction.targets)
-          write_gb_word(out, t_it->target_number);
-
-        write_gb_word(out, instruction.labels.size());
-
-        for(const auto &l_it : instruction.labels)
-          irepconverter.write_string_ref(out, l_it);
-      }
+      write_goto_binary_function_body(out, fct.second.body, irepconverter);
     }
   }
 
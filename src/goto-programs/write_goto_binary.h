@@ -20,6 +20,7 @@ Author: CM Wintersteiger
 #include "goto_functions.h"
 
 class goto_modelt;
+class irep_serializationt;
 class message_handlert;
 
 bool write_goto_binary(
@@ -38,4 +39,14 @@ bool write_goto_binary(
   const goto_modelt &,
   message_handlert &);
 
+void write_goto_binary_symbol(
+  std::ostream &out,
+  const symbolt &,
+  irep_serializationt &);
+
+void write_goto_binary_function_body(
+  std::ostream &out,
+  const goto_programt &,
+  irep_serializationt &);
+
 #endif // CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
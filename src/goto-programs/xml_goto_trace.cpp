@@ -23,13 +23,14 @@ Author: Daniel Kroening
 #include "printf_formatter.h"
 #include "xml_expr.h"
 
-void convert(
+/// Add an element for each step of \p goto_trace to \p dest, which is
+/// either an `xmlt` or an `xml_streamt`
+template <typename xml_elementT>
+static void convert_steps(
   const namespacet &ns,
   const goto_tracet &goto_trace,
-  xmlt &dest)
+  xml_elementT &dest)
 {
-  dest=xmlt("goto_trace");
-
   source_locationt previous_source_location;
 
   for(const auto &step : goto_trace.steps)
@@ -221,3 +222,20 @@ void convert(
       previous_source_location=source_location;
   }
 }
+
+void convert(
+  const namespacet &ns,
+  const goto_tracet &goto_trace,
+  xmlt &dest)
+{
+  dest=xmlt("goto_trace");
+  convert_steps(ns, goto_trace, dest);
+}
+
+void convert(
+  const namespacet &ns,
+  const goto_tracet &goto_trace,
+  xml_streamt &dest)
+{
+  convert_steps(ns, goto_trace, dest);
+}
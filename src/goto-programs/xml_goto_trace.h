@@ -15,6 +15,7 @@ Date: November 2005
 #define CPROVER_GOTO_PROGRAMS_XML_GOTO_TRACE_H
 
 #include <util/xml.h>
+#include <util/xml_stream.h>
 
 #include "goto_trace.h"
 
@@ -23,4 +24,11 @@ void convert(
   const goto_tracet &goto_trace,
   xmlt &xml);
 
+/// Output the steps of \p goto_trace to \p xml, the stream of a
+/// `goto_trace` element, one step at a time
+void convert(
+  const namespacet &ns,
+  const goto_tracet &goto_trace,
+  xml_streamt &xml);
+
 #endif // CPROVER_GOTO_PROGRAMS_XML_GOTO_TRACE_H
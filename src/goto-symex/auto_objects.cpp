@@ -18,12 +18,12 @@ Author: Daniel Kroening, kroening@kroening.com
 
 exprt goto_symext::make_auto_object(const typet &type, statet &state)
 {
-  dynamic_counter++;
+  const unsigned dynamic_number = ++dynamic_counter;
 
   // produce auto-object symbol
   symbolt symbol;
 
-  symbol.base_name="auto_object"+std::to_string(dynamic_counter);
+  symbol.base_name = "auto_object" + std::to_string(dynamic_number);
   symbol.name="symex::"+id2string(symbol.base_name);
   symbol.is_lvalue=true;
   symbol.type=type;
@@ -90,9 +90,8 @@ void goto_symext::trigger_auto_object(const exprt &expr, statet &state)
         if(has_prefix(id2string(symbol.base_name), "auto_object"))
         {
           // done already?
-          if(
-            state.get_level2().current_names.find(ssa_expr.get_identifier()) ==
-            state.get_level2().current_names.end())
+          if(!state.get_level2().current_names.has_key(
+               ssa_expr.get_identifier()))
           {
             initialize_auto_object(e, state);
           }
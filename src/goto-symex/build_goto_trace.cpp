@@ -213,12 +213,13 @@ void build_goto_trace(
   // events with the same clock.
 
   typedef symex_target_equationt::SSA_stepst::const_iterator ssa_step_iteratort;
-  typedef std::map<mp_integer, std::vector<ssa_step_iteratort>> time_mapt;
+  // The steps do not move in memory, hence the time slots point to them.
+  typedef std::map<mp_integer, std::vector<const SSA_stept *>> time_mapt;
   time_mapt time_map;
 
   mp_integer current_time=0;
 
-  ssa_step_iteratort last_step_to_keep = target.SSA_steps.end();
+  const SSA_stept *last_step_to_keep = nullptr;
   bool last_step_was_kept = false;
 
   // First sort the SSA steps by time, in the process dropping steps
@@ -228,15 +229,15 @@ void build_goto_trace(
       it != target.SSA_steps.end();
       it++)
   {
+    const SSA_stept &SSA_step = *it;
+
     if(
-      last_step_to_keep == target.SSA_steps.end() &&
+      last_step_to_keep == nullptr &&
       is_last_step_to_keep(it, decision_procedure))
     {
-      last_step_to_keep = it;
+      last_step_to_keep = &SSA_step;
     }
 
-    const SSA_stept &SSA_step = *it;
-
     if(!decision_procedure.get(SSA_step.guard_handle).is_true())
       continue;
 
@@ -284,7 +285,7 @@ void build_goto_trace(
 
         if(time_before_steps_it != time_map.end())
         {
-          std::vector<ssa_step_iteratort> &current_time_steps =
+          std::vector<const SSA_stept *> &current_time_steps =
             time_map[current_time];
 
           current_time_steps.insert(
@@ -309,16 +310,16 @@ void build_goto_trace(
       continue;
     }
 
-    if(it == last_step_to_keep)
+    if(&SSA_step == last_step_to_keep)
     {
       last_step_was_kept = true;
     }
 
-    time_map[current_time].push_back(it);
+    time_map[current_time].push_back(&SSA_step);
   }
 
   INVARIANT(
-    last_step_to_keep == target.SSA_steps.end() || last_step_was_kept,
+    last_step_to_keep == nullptr || last_step_was_kept,
     "last step in SSA trace to keep must not be filtered out as a sync "
     "instruction, not-taken branch, PHI node, or similar");
 
@@ -329,9 +330,9 @@ void build_goto_trace(
 
   for(const auto &time_and_ssa_steps : time_map)
   {
-    for(const auto ssa_step_it : time_and_ssa_steps.second)
+    for(const SSA_stept *ssa_step : time_and_ssa_steps.second)
     {
-      const auto &SSA_step = *ssa_step_it;
+      const SSA_stept &SSA_step = *ssa_step;
       goto_trace.steps.push_back(goto_trace_stept());
       goto_trace_stept &goto_trace_step = goto_trace.steps.back();
 
@@ -342,16 +343,18 @@ void build_goto_trace(
       goto_trace_step.function_id = SSA_step.source.function_id;
       if(SSA_step.is_assert())
       {
-        goto_trace_step.comment = SSA_step.comment;
+        goto_trace_step.comment = id2string(SSA_step.comment);
         goto_trace_step.property_id = SSA_step.get_property_id();
       }
       goto_trace_step.type = SSA_step.type;
       goto_trace_step.hidden = SSA_step.hidden;
-      goto_trace_step.format_string = SSA_step.format_string;
-      goto_trace_step.io_id = SSA_step.io_id;
-      goto_trace_step.formatted = SSA_step.formatted;
+      const SSA_stept::argumentst &arguments = SSA_step.arguments();
+      goto_trace_step.format_string = arguments.format_string;
+      goto_trace_step.io_id = arguments.io_id;
+      goto_trace_step.formatted = arguments.formatted;
       goto_trace_step.called_function = SSA_step.called_function;
-      goto_trace_step.function_arguments = SSA_step.converted_function_arguments;
+      goto_trace_step.function_arguments =
+        arguments.converted_function_arguments;
 
       for(auto &arg : goto_trace_step.function_arguments)
         arg = decision_procedure.get(arg);
@@ -387,7 +390,7 @@ void build_goto_trace(
           goto_trace_step.full_lhs_value, decision_procedure);
       }
 
-      for(const auto &j : SSA_step.converted_io_args)
+      for(const auto &j : arguments.converted_io_args)
       {
         if(j.is_constant() || j.id() == ID_string_constant)
         {
@@ -408,7 +411,7 @@ void build_goto_trace(
           decision_procedure.get(SSA_step.cond_handle).is_true();
       }
 
-      if(ssa_step_it == last_step_to_keep)
+      if(ssa_step == last_step_to_keep)
         return;
     }
   }
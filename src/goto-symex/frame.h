@@ -12,6 +12,10 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 #ifndef CPROVER_GOTO_SYMEX_FRAME_H
 #define CPROVER_GOTO_SYMEX_FRAME_H
 
+#include <chrono>
+
+#include <util/optional.h>
+
 #include "goto_state.h"
 #include "symex_target.h"
 
@@ -31,6 +35,10 @@ struct framet
   exprt return_value = nil_exprt();
   bool hidden_function = false;
 
+  /// Time at which symbolic execution of the function started, for the
+  /// trace timeline
+  optionalt<std::chrono::microseconds> trace_start;
+
   symex_renaming_levelt::current_namest old_level1;
 
   std::set<irep_idt> local_objects;
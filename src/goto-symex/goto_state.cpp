@@ -28,13 +28,19 @@ std::size_t goto_statet::increase_generation(
   const ssa_exprt &lhs,
   std::function<std::size_t(const irep_idt &)> fresh_l2_name_provider)
 {
-  auto current_emplace_res =
-    level2.current_names.emplace(l1_identifier, std::make_pair(lhs, 0));
+  const std::size_t n = fresh_l2_name_provider(l1_identifier);
 
-  current_emplace_res.first->second.second =
-    fresh_l2_name_provider(l1_identifier);
+  if(level2.current_names.has_key(l1_identifier))
+  {
+    level2.current_names.update(
+      l1_identifier, [n](std::pair<ssa_exprt, unsigned> &value) {
+        value.second = n;
+      });
+  }
+  else
+    level2.current_names.insert(l1_identifier, std::make_pair(lhs, n));
 
-  return current_emplace_res.first->second.second;
+  return n;
 }
 
 /// Given a condition that must hold on this path, propagate as much knowledge
@@ -13,10 +13,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/simplify_expr.h>
 
-unsigned goto_symext::dynamic_counter=0;
+std::atomic<unsigned> goto_symext::dynamic_counter{0};
 
 void goto_symext::do_simplify(exprt &expr)
 {
   if(symex_config.simplify_opt)
-    simplify(expr, ns);
+    simplifier.simplify(expr);
 }
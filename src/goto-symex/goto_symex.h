@@ -12,8 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 #define CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 
+#include <atomic>
+
 #include <util/options.h>
 #include <util/message.h>
+#include <util/simplify_expr_class.h>
 
 #include <goto-programs/abstract_goto_model.h>
 
@@ -53,6 +56,9 @@ struct symex_configt final
 
   bool simplify_opt;
 
+  /// Maximum number of simplification results to memoize, 0 to disable
+  std::size_t simplify_cache_size;
+
   bool unwinding_assertions;
 
   bool partial_loops;
@@ -100,6 +106,7 @@ public:
       symex_config(options),
       outer_symbol_table(outer_symbol_table),
       ns(outer_symbol_table),
+      simplifier(ns),
       guard_manager(guard_manager),
       target(_target),
       atomic_section_counter(0),
@@ -109,6 +116,8 @@ public:
       _total_vccs(std::numeric_limits<unsigned>::max()),
       _remaining_vccs(std::numeric_limits<unsigned>::max())
   {
+    if(symex_config.simplify_cache_size != 0)
+      simplifier.enable_cache(symex_config.simplify_cache_size);
   }
 
   /// A virtual destructor allowing derived classes to be cleaned up correctly
@@ -247,6 +256,9 @@ protected:
   /// goto-program, and the names of dynamically-created objects.
   namespacet ns;
 
+  /// Used by \ref do_simplify; holds the simplification cache, if enabled
+  simplify_exprt simplifier;
+
   /// Used to create guards. Guards created with different guard managers cannot
   /// be combined together, so guards created by goto-symex should not escape
   /// the scope of this manager.
@@ -602,8 +614,9 @@ protected:
   /// \param code: The cleaned up output instruction
   virtual void symex_output(statet &state, const codet &code);
 
-  /// A monotonically increasing index for each created dynamic object
-  static unsigned dynamic_counter;
+  /// A monotonically increasing index for each created dynamic object. This is
+  /// shared by the symex instances of all threads exploring paths in parallel.
+  static std::atomic<unsigned> dynamic_counter;
 
   void rewrite_quantifiers(exprt &, statet &);
 
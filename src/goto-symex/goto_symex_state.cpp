@@ -790,16 +790,14 @@ ssa_exprt goto_symex_statet::add_object(
   const std::size_t l1_index = index_generator(l0_name);
 
   // save old L1 name, if any
-  auto existing_or_new_entry = level1.current_names.emplace(
-    std::piecewise_construct,
-    std::forward_as_tuple(l0_name),
-    std::forward_as_tuple(ssa, l1_index));
-
-  if(!existing_or_new_entry.second)
+  if(const auto existing = level1.current_names.find(l0_name))
   {
-    frame.old_level1.emplace(l0_name, existing_or_new_entry.first->second);
-    existing_or_new_entry.first->second = std::make_pair(ssa, l1_index);
+    if(!frame.old_level1.has_key(l0_name))
+      frame.old_level1.insert(l0_name, existing->get());
+    level1.current_names.replace(l0_name, std::make_pair(ssa, l1_index));
   }
+  else
+    level1.current_names.insert(l0_name, std::make_pair(ssa, l1_index));
 
   ssa = rename_ssa<L1>(std::move(ssa), ns).get();
   const bool inserted = frame.local_objects.insert(ssa.get_identifier()).second;
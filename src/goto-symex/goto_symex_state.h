@@ -225,12 +225,6 @@ public:
       l1_identifier, lhs, fresh_l2_name_provider);
   }
 
-  /// Drops an L1 name from the local L2 map
-  void drop_l1_name(symex_renaming_levelt::current_namest::const_iterator it)
-  {
-    level2.current_names.erase(it);
-  }
-
   /// Drops an L1 name from the local L2 map
   void drop_l1_name(const irep_idt &l1_identifier)
   {
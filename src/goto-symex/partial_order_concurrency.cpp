@@ -70,7 +70,9 @@ void partial_order_concurrencyt::add_init_writes(
     init_done.insert(a);
   }
 
-  equation.SSA_steps.splice(equation.SSA_steps.begin(), init_steps);
+  // add to the front, keeping their order
+  for(auto it = init_steps.rbegin(); it != init_steps.rend(); ++it)
+    equation.SSA_steps.push_front(std::move(*it));
 }
 
 void partial_order_concurrencyt::build_event_lists(
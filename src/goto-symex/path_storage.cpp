@@ -8,6 +8,7 @@ Author: Kareem Khazem <karkhaz@karkhaz.com>
 
 #include "path_storage.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include <util/exit_codes.h>
@@ -15,7 +16,7 @@ Author: Kareem Khazem <karkhaz@karkhaz.com>
 
 nondet_symbol_exprt symex_nondet_generatort::operator()(const typet &type)
 {
-  irep_idt identifier = "symex::nondet" + std::to_string(nondet_count++);
+  irep_idt identifier = "symex::nondet" + std::to_string((*nondet_count)++);
   return nondet_symbol_exprt(identifier, type);
 }
 
@@ -79,6 +80,90 @@ void path_fifot::clear()
   paths.clear();
 }
 
+// _____________________________________________________________________________
+// path_priority_queuet
+
+path_storaget::patht &path_priority_queuet::private_peek()
+{
+  if(peeked)
+    return *peeked;
+
+  while(has_increasing_priorities())
+  {
+    entryt &next = heap.front();
+    const std::size_t current_priority = priority(next.path->state);
+    if(current_priority <= next.priority)
+      break;
+
+    std::pop_heap(heap.begin(), heap.end(), resumed_latert());
+    heap.back().priority = current_priority;
+    std::push_heap(heap.begin(), heap.end(), resumed_latert());
+  }
+
+  std::pop_heap(heap.begin(), heap.end(), resumed_latert());
+  peeked = std::move(heap.back().path);
+  heap.pop_back();
+  return *peeked;
+}
+
+void path_priority_queuet::push(const path_storaget::patht &path)
+{
+  auto copy = util_make_unique<patht>(path);
+  const std::size_t path_priority = priority(copy->state);
+  heap.push_back(
+    entryt{path_priority, next_sequence_number++, std::move(copy)});
+  std::push_heap(heap.begin(), heap.end(), resumed_latert());
+}
+
+void path_priority_queuet::private_pop()
+{
+  if(!peeked)
+    private_peek();
+  peeked.reset();
+}
+
+std::size_t path_priority_queuet::size() const
+{
+  return heap.size() + (peeked ? 1 : 0);
+}
+
+void path_priority_queuet::clear()
+{
+  heap.clear();
+  peeked.reset();
+}
+
+// _____________________________________________________________________________
+// path_shortest_distancet
+
+std::size_t path_shortest_distancet::priority(const goto_symex_statet &state)
+{
+  const goto_programt::const_targett target = resume_target(state);
+  std::size_t distance =
+    distances.to_property(state.source.function_id, target);
+  std::size_t to_return = distances.to_end(state.source.function_id, target);
+
+  // an assertion may also be reached after returning to one of the callers;
+  // the first frame is the one of the entry point, which has no caller
+  const call_stackt &call_stack = state.call_stack();
+  for(std::size_t i = call_stack.size() - 1;
+      i > 0 && to_return != property_distancet::infinity;
+      --i)
+  {
+    const symex_targett::sourcet &call = call_stack[i].calling_location;
+    const goto_programt::const_targett return_target = std::next(call.pc);
+
+    distance = std::min(
+      distance,
+      property_distancet::add(
+        to_return, distances.to_property(call.function_id, return_target)));
+    to_return = property_distancet::add(
+      to_return, distances.to_end(call.function_id, return_target));
+  }
+
+  return distance;
+}
+
 // _____________________________________________________________________________
 // path_strategy_choosert
 
@@ -86,14 +171,15 @@ static const std::map<
   const std::string,
   std::pair<
     const std::string,
-    const std::function<std::unique_ptr<path_storaget>()>>>
+    const std::function<
+      std::unique_ptr<path_storaget>(abstract_goto_modelt &)>>>
   path_strategies(
     {{"lifo",
       {" lifo                         next instruction is pushed before\n"
        "                              goto target; paths are popped in\n"
        "                              last-in, first-out order. Explores\n"
        "                              the program tree depth-first.\n",
-       []() { // NOLINT(whitespace/braces)
+       [](abstract_goto_modelt &) { // NOLINT(whitespace/braces)
          return util_make_unique<path_lifot>();
        }}},
      {"fifo",
@@ -101,8 +187,24 @@ static const std::map<
        "                              goto target; paths are popped in\n"
        "                              first-in, first-out order. Explores\n"
        "                              the program tree breadth-first.\n",
-       []() { // NOLINT(whitespace/braces)
+       [](abstract_goto_modelt &) { // NOLINT(whitespace/braces)
          return util_make_unique<path_fifot>();
+       }}},
+     {"coverage-guided",
+      {" coverage-guided              paths continuing with an instruction\n"
+       "                              that no path has executed yet are\n"
+       "                              popped first, otherwise in last-in,\n"
+       "                              first-out order.\n",
+       [](abstract_goto_modelt &) { // NOLINT(whitespace/braces)
+         return util_make_unique<path_coverage_guidedt>();
+       }}},
+     {"shortest-distance",
+      {" shortest-distance            paths that are the fewest instructions\n"
+       "                              away from an assertion in the\n"
+       "                              control-flow graph are popped first,\n"
+       "                              otherwise in last-in, first-out order.\n",
+       [](abstract_goto_modelt &goto_model) { // NOLINT(whitespace/braces)
+         return util_make_unique<path_shortest_distancet>(goto_model);
        }}}});
 
 std::string show_path_strategies()
@@ -123,12 +225,13 @@ bool is_valid_path_strategy(const std::string strategy)
   return path_strategies.find(strategy) != path_strategies.end();
 }
 
-std::unique_ptr<path_storaget> get_path_strategy(const std::string strategy)
+std::unique_ptr<path_storaget>
+get_path_strategy(const std::string strategy, abstract_goto_modelt &goto_model)
 {
   auto found = path_strategies.find(strategy);
   INVARIANT(
     found != path_strategies.end(), "Unknown strategy '" + strategy + "'.");
-  return found->second.second();
+  return found->second.second(goto_model);
 }
 
 void parse_path_strategy_options(
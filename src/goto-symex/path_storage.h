@@ -12,8 +12,13 @@
 
 #include <analyses/dirty.h>
 #include <analyses/local_safe_pointers.h>
+#include <analyses/property_distance.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
 
 #include "goto_symex_state.h"
 #include "symex_target_equation.h"
@@ -24,8 +29,16 @@ class symex_nondet_generatort
 public:
   nondet_symbol_exprt operator()(const typet &type);
 
+  /// Continue numbering with the counter of \p other, such that this and
+  /// \p other generate distinct symbols, even when called concurrently
+  void share_counter_with(const symex_nondet_generatort &other)
+  {
+    nondet_count = other.nondet_count;
+  }
+
 private:
-  std::size_t nondet_count = 0;
+  std::shared_ptr<std::atomic<std::size_t>> nondet_count =
+    std::make_shared<std::atomic<std::size_t>>(0);
 };
 
 /// \brief Storage for symbolic execution paths to be resumed later
@@ -90,6 +103,13 @@ public:
     return size() == 0;
   };
 
+  /// Called by symbolic execution for each instruction it executes during
+  /// path exploration, for strategies that choose paths by what has been
+  /// executed so far
+  virtual void instruction_executed(goto_programt::const_targett)
+  {
+  }
+
   /// Counter for nondet objects, which require unique names
   symex_nondet_generatort build_symex_nondet;
 
@@ -103,18 +123,41 @@ public:
   /// \p minimum_index.
   std::size_t get_unique_l1_index(const irep_idt &id, std::size_t minimum_index)
   {
-    return get_unique_index(l1_indices, id, minimum_index);
+    return get_unique_index(unique_indices->l1_indices, id, minimum_index);
   }
 
   std::size_t get_unique_l2_index(const irep_idt &id)
   {
-    return get_unique_index(l2_indices, id, 1);
+    return get_unique_index(unique_indices->l2_indices, id, 1);
   }
 
   /// Local variables are considered 'dirty' if they've had an address taken and
   /// therefore may be referred to by a pointer.
   incremental_dirtyt dirty;
 
+  /// Make sure that \ref dirty and \ref safe_pointers include the results for
+  /// the function \p id with body \p goto_function
+  void add_function_analyses(
+    const irep_idt &id,
+    const goto_functionst::goto_functiont &goto_function)
+  {
+    dirty.populate_dirty_for_function(id, goto_function);
+
+    if(safe_pointers.find(id) == safe_pointers.end())
+      safe_pointers[id](goto_function.body);
+  }
+
+  /// Use the same unique L1 and L2 indices and nondet symbols as \p other,
+  /// such that the names generated by symbolic execution using either storage
+  /// never clash. Paths can then be moved between the two storages, and they
+  /// may be used by several threads at once.
+  void share_fresh_names_with(path_storaget &other)
+  {
+    other.unique_indices->shared = true;
+    unique_indices = other.unique_indices;
+    build_symex_nondet.share_counter_with(other.build_symex_nondet);
+  }
+
 private:
   // Derived classes should override these methods, allowing the base class to
   // enforce preconditions.
@@ -128,6 +171,10 @@ private:
     const irep_idt &id,
     std::size_t minimum_index)
   {
+    std::unique_lock<std::mutex> lock(unique_indices->mutex, std::defer_lock);
+    if(unique_indices->shared)
+      lock.lock();
+
     auto entry = unique_index_map.emplace(id, minimum_index);
 
     if(!entry.second)
@@ -136,9 +183,19 @@ private:
     return entry.first->second;
   }
 
-  /// Storage used by \ref get_unique_index.
-  name_index_mapt l1_indices;
-  name_index_mapt l2_indices;
+  /// Storage used by \ref get_unique_index, which may be shared with other
+  /// path storages (see \ref share_fresh_names_with)
+  struct unique_indicest
+  {
+    name_index_mapt l1_indices;
+    name_index_mapt l2_indices;
+    /// Set when the indices are shared, accesses are then serialized
+    bool shared = false;
+    std::mutex mutex;
+  };
+
+  std::shared_ptr<unique_indicest> unique_indices =
+    std::make_shared<unique_indicest>();
 };
 
 /// \brief LIFO save queue: depth-first search, try to finish paths
@@ -174,6 +231,107 @@ private:
   void private_pop() override;
 };
 
+/// \brief Priority queue of paths: resumes a path of the smallest priority,
+/// and among those the one saved last, such that exploration is depth-first
+/// as long as priorities are equal
+class path_priority_queuet : public path_storaget
+{
+public:
+  void push(const patht &) override;
+  std::size_t size() const override;
+  void clear() override;
+
+protected:
+  /// Priority of resuming \p state; paths of smaller priorities are resumed
+  /// first
+  virtual std::size_t priority(const goto_symex_statet &state) = 0;
+
+  /// If priorities can increase after a path has been saved, the priority of
+  /// the next path is recomputed before resuming it, and the path is put back
+  /// if it has increased
+  virtual bool has_increasing_priorities() const
+  {
+    return false;
+  }
+
+  /// The instruction that \p state will be resumed from
+  static goto_programt::const_targett
+  resume_target(const goto_symex_statet &state)
+  {
+    return state.has_saved_jump_target || state.has_saved_next_instruction
+             ? state.saved_target
+             : state.source.pc;
+  }
+
+private:
+  struct entryt
+  {
+    std::size_t priority;
+    std::size_t sequence_number;
+    std::unique_ptr<patht> path;
+  };
+
+  /// Orders entries such that the one to resume next is the maximum
+  struct resumed_latert
+  {
+    bool operator()(const entryt &a, const entryt &b) const
+    {
+      if(a.priority != b.priority)
+        return a.priority > b.priority;
+      return a.sequence_number < b.sequence_number;
+    }
+  };
+
+  std::vector<entryt> heap;
+  std::size_t next_sequence_number = 0;
+  /// The path returned by \ref peek, which is taken off the heap as symbolic
+  /// execution of it will push further paths before it is popped
+  std::unique_ptr<patht> peeked;
+
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
+/// \brief Coverage-guided: resume paths that continue with an instruction that
+/// no path has executed yet first, otherwise depth-first
+class path_coverage_guidedt : public path_priority_queuet
+{
+public:
+  void instruction_executed(goto_programt::const_targett target) override
+  {
+    covered.insert(target);
+  }
+
+protected:
+  std::unordered_set<goto_programt::const_targett, const_target_hash> covered;
+
+  std::size_t priority(const goto_symex_statet &state) override
+  {
+    return covered.count(resume_target(state));
+  }
+
+  bool has_increasing_priorities() const override
+  {
+    return true;
+  }
+};
+
+/// \brief Shortest-distance: resume paths that are the fewest instructions away
+/// from an assertion first, see \ref property_distancet
+class path_shortest_distancet : public path_priority_queuet
+{
+public:
+  explicit path_shortest_distancet(abstract_goto_modelt &goto_model)
+    : distances(goto_model)
+  {
+  }
+
+protected:
+  property_distancet distances;
+
+  std::size_t priority(const goto_symex_statet &state) override;
+};
+
 /// \brief suitable for displaying as a front-end help message
 std::string show_path_strategies();
 
@@ -182,7 +340,11 @@ bool is_valid_path_strategy(const std::string strategy);
 
 /// Ensure that is_valid_strategy() returns true for a
 /// particular string before calling this function on that string.
-std::unique_ptr<path_storaget> get_path_strategy(const std::string strategy);
+/// \param strategy: name of the strategy
+/// \param goto_model: the program whose paths will be stored, which
+///   strategies may analyse to choose the paths to resume
+std::unique_ptr<path_storaget>
+get_path_strategy(const std::string strategy, abstract_goto_modelt &goto_model);
 
 /// \brief add `paths` and `exploration-strategy` option, suitable to be
 /// invoked from front-ends.
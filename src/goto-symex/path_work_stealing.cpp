@@ -0,0 +1,179 @@
+/*******************************************************************\
+
+Module: Path Storage
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storage of symbolic execution paths shared between several threads
+
+#include "path_work_stealing.h"
+
+#include <util/make_unique.h>
+
+path_work_poolt::path_work_poolt(std::size_t number_of_workers, bool lifo)
+  : deques(number_of_workers), lifo(lifo), is_busy(number_of_workers, false)
+{
+  PRECONDITION(number_of_workers > 0);
+}
+
+void path_work_poolt::push(
+  std::size_t worker,
+  const path_storaget::patht &path)
+{
+  PRECONDITION(worker < deques.size());
+
+  // copying the path is the expensive part, do it outside of any lock
+  auto copy = util_make_unique<path_storaget::patht>(path);
+
+  {
+    std::lock_guard<std::mutex> lock(deques[worker].mutex);
+    deques[worker].paths.push_back(std::move(copy));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++pending_paths;
+  }
+  paths_or_finished.notify_one();
+}
+
+std::unique_ptr<path_storaget::patht>
+path_work_poolt::try_take(std::size_t worker)
+{
+  {
+    dequet &own = deques[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if(!own.paths.empty())
+    {
+      std::unique_ptr<path_storaget::patht> path;
+      if(lifo)
+      {
+        path = std::move(own.paths.back());
+        own.paths.pop_back();
+      }
+      else
+      {
+        path = std::move(own.paths.front());
+        own.paths.pop_front();
+      }
+      return path;
+    }
+  }
+
+  for(std::size_t i = 1; i < deques.size(); ++i)
+  {
+    dequet &victim = deques[(worker + i) % deques.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if(!victim.paths.empty())
+    {
+      auto path = std::move(victim.paths.front());
+      victim.paths.pop_front();
+      return path;
+    }
+  }
+
+  return nullptr;
+}
+
+std::unique_ptr<path_storaget::patht> path_work_poolt::take(std::size_t worker)
+{
+  PRECONDITION(worker < deques.size());
+
+  std::unique_lock<std::mutex> lock(mutex);
+
+  if(is_busy[worker])
+  {
+    is_busy[worker] = false;
+    --busy_workers;
+  }
+
+  while(true)
+  {
+    if(stopped || finished)
+      return nullptr;
+
+    if(pending_paths > 0)
+    {
+      // reserve a path such that no other worker concludes that exploration
+      // has finished while this one is looking for it
+      --pending_paths;
+      ++busy_workers;
+      is_busy[worker] = true;
+      lock.unlock();
+
+      // as the path is reserved, one of the deques holds a path for us
+      std::unique_ptr<path_storaget::patht> path;
+      while(!path)
+        path = try_take(worker);
+      return path;
+    }
+
+    if(busy_workers == 0)
+    {
+      finished = true;
+      paths_or_finished.notify_all();
+      return nullptr;
+    }
+
+    paths_or_finished.wait(lock);
+  }
+}
+
+void path_work_poolt::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = true;
+  }
+  paths_or_finished.notify_all();
+}
+
+bool path_work_poolt::is_stopped() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return stopped;
+}
+
+std::size_t path_work_poolt::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return pending_paths;
+}
+
+// _____________________________________________________________________________
+// path_work_stealingt
+
+void path_work_stealingt::push(const patht &path)
+{
+  pool.push(worker, path);
+}
+
+std::size_t path_work_stealingt::size() const
+{
+  return current ? 1 : 0;
+}
+
+void path_work_stealingt::clear()
+{
+  current.reset();
+  pool.stop();
+}
+
+bool path_work_stealingt::take_next()
+{
+  current = pool.take(worker);
+  return current != nullptr;
+}
+
+path_storaget::patht &path_work_stealingt::private_peek()
+{
+  return *current;
+}
+
+void path_work_stealingt::private_pop()
+{
+  current.reset();
+}
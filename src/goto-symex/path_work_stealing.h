@@ -0,0 +1,115 @@
+/*******************************************************************\
+
+Module: Path Storage
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Storage of symbolic execution paths shared between several threads
+
+#ifndef CPROVER_GOTO_SYMEX_PATH_WORK_STEALING_H
+#define CPROVER_GOTO_SYMEX_PATH_WORK_STEALING_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "path_storage.h"
+
+/// Paths to resume, shared between the workers of a parallel path
+/// exploration. Each worker has its own deque of paths: it adds the paths it
+/// saves to the back and takes paths according to the exploration strategy,
+/// from the back (lifo) or from the front (fifo). A worker whose deque is empty
+/// steals the path at the front of the deque of another worker. This is the
+/// oldest path of that worker, and thus likely the root of the largest part
+/// of the program tree that remains to be explored.
+class path_work_poolt
+{
+public:
+  /// \param number_of_workers: number of workers taking paths from the pool
+  /// \param lifo: whether workers take their own paths in last-in, first-out
+  ///   order (otherwise first-in, first-out)
+  path_work_poolt(std::size_t number_of_workers, bool lifo);
+
+  /// Add \p path to the deque of \p worker
+  void push(std::size_t worker, const path_storaget::patht &path);
+
+  /// Take a path for \p worker, from its own deque or, if that is empty, from
+  /// the deque of another worker. Taking a path signals that \p worker has
+  /// finished the path it took before. If there is no path, wait until one is
+  /// added. Exploration has finished when all deques are empty and no worker
+  /// is resuming a path, as no paths can be added any more.
+  /// \return the path, or nullptr once exploration has finished or has been
+  ///   stopped
+  std::unique_ptr<path_storaget::patht> take(std::size_t worker);
+
+  /// Stop exploration: all subsequent calls to \ref take return nullptr
+  void stop();
+
+  bool is_stopped() const;
+
+  /// Number of paths in all deques
+  std::size_t size() const;
+
+private:
+  struct dequet
+  {
+    std::mutex mutex;
+    std::deque<std::unique_ptr<path_storaget::patht>> paths;
+  };
+
+  std::vector<dequet> deques;
+  const bool lifo;
+
+  /// Guards the members below
+  mutable std::mutex mutex;
+  std::condition_variable paths_or_finished;
+  std::size_t pending_paths = 0;
+  std::size_t busy_workers = 0;
+  std::vector<bool> is_busy;
+  bool stopped = false;
+  bool finished = false;
+
+  std::unique_ptr<path_storaget::patht> try_take(std::size_t worker);
+};
+
+/// The path storage of one worker of a parallel path exploration, which
+/// saves and resumes paths via a \ref path_work_poolt. The storages of all
+/// workers must share their fresh names (see
+/// \ref path_storaget::share_fresh_names_with).
+class path_work_stealingt : public path_storaget
+{
+public:
+  path_work_stealingt(path_work_poolt &pool, std::size_t worker)
+    : pool(pool), worker(worker)
+  {
+  }
+
+  void push(const patht &) override;
+
+  /// The path taken by the last call to \ref take_next, if not yet popped
+  std::size_t size() const override;
+
+  /// Stop the exploration of all workers
+  void clear() override;
+
+  /// Take the next path to resume from the pool, see
+  /// \ref path_work_poolt::take
+  /// \return false once exploration has finished or has been stopped
+  bool take_next();
+
+protected:
+  path_work_poolt &pool;
+  const std::size_t worker;
+  std::unique_ptr<patht> current;
+
+private:
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
+#endif // CPROVER_GOTO_SYMEX_PATH_WORK_STEALING_H
@@ -12,10 +12,10 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 #ifndef CPROVER_GOTO_SYMEX_RENAMING_LEVEL_H
 #define CPROVER_GOTO_SYMEX_RENAMING_LEVEL_H
 
-#include <map>
 #include <unordered_set>
 
 #include <util/irep.h>
+#include <util/sharing_map.h>
 #include <util/simplify_expr.h>
 #include <util/ssa_expr.h>
 
@@ -29,6 +29,9 @@ enum levelt
 
 /// Wrapper for a \c current_names map, which maps each identifier to an SSA
 /// expression and a counter.
+/// The map is a \ref sharing_mapt so that copies of it, as made whenever a
+/// state is saved at a branch, share all entries that are not subsequently
+/// changed.
 /// This is extended by the different symex_level structures which are used
 /// during symex to ensure static single assignment (SSA) form.
 struct symex_renaming_levelt
@@ -42,27 +45,26 @@ struct symex_renaming_levelt
   symex_renaming_levelt(symex_renaming_levelt &&other) = default;
 
   /// Map identifier to ssa_exprt and counter
-  typedef std::map<irep_idt, std::pair<ssa_exprt, unsigned>> current_namest;
+  typedef sharing_mapt<irep_idt, std::pair<ssa_exprt, unsigned>>
+    current_namest;
   current_namest current_names;
 
+  typedef current_namest::delta_viewt delta_viewt;
+
   /// Counter corresponding to an identifier
   unsigned current_count(const irep_idt &identifier) const
   {
-    const auto it = current_names.find(identifier);
-    return it == current_names.end() ? 0 : it->second.second;
-  }
-
-  /// Increase the counter corresponding to an identifier
-  static void increase_counter(const current_namest::iterator &it)
-  {
-    ++it->second.second;
+    const auto r_opt = current_names.find(identifier);
+    return r_opt ? r_opt->get().second : 0;
   }
 
   /// Add the \c ssa_exprt of current_names to vars
   void get_variables(std::unordered_set<ssa_exprt, irep_hash> &vars) const
   {
-    for(const auto &pair : current_names)
-      vars.insert(pair.second.first);
+    current_names.iterate(
+      [&vars](const irep_idt &, const std::pair<ssa_exprt, unsigned> &value) {
+        vars.insert(value.first);
+      });
   }
 };
 
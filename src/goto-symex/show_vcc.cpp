@@ -48,7 +48,7 @@ show_vcc_plain(messaget::mstreamt &out, const symex_target_equationt &equation)
     if(s_it->source.pc->source_location.is_not_nil())
       out << s_it->source.pc->source_location << '\n';
 
-    if(s_it->comment != "")
+    if(!s_it->comment.empty())
       out << s_it->comment << '\n';
 
     symex_target_equationt::SSA_stepst::const_iterator p_it =
@@ -133,7 +133,7 @@ show_vcc_json(std::ostream &out, const symex_target_equationt &equation)
     if(source_location.is_not_nil())
       object["sourceLocation"] = json(source_location);
 
-    const std::string &s = s_it->comment;
+    const std::string &s = id2string(s_it->comment);
     if(!s.empty())
       object["comment"] = json_stringt(s);
 
@@ -44,11 +44,9 @@ void symex_slicet::slice(
 
 void symex_slicet::slice(symex_target_equationt &equation)
 {
-  for(symex_target_equationt::SSA_stepst::reverse_iterator
-      it=equation.SSA_steps.rbegin();
-      it!=equation.SSA_steps.rend();
-      it++)
-    slice(*it);
+  // the steps are stored contiguously in chunks, walk them back by index
+  for(std::size_t i = equation.SSA_steps.size(); i != 0; --i)
+    slice(equation.SSA_steps[i - 1]);
 }
 
 void symex_slicet::slice(SSA_stept &SSA_step)
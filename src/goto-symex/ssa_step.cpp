@@ -8,6 +8,7 @@ Author: Romain Brenguier <romain.brenguier@diffblue.com>
 
 #include "ssa_step.h"
 
+#include <util/find_symbols.h>
 #include <util/format_expr.h>
 
 void SSA_stept::output(std::ostream &out) const
@@ -122,6 +123,49 @@ void SSA_stept::output(std::ostream &out) const
   out << "Guard: " << format(guard) << '\n';
 }
 
+void SSA_stept::release_converted_exprs()
+{
+  guard.make_nil();
+
+  if(is_assignment() || is_decl() || is_constraint())
+    cond_expr.make_nil();
+
+  if(ssa_rhs.is_not_nil())
+  {
+    std::set<symbol_exprt> symbols;
+    find_symbols(ssa_rhs, symbols);
+
+    exprt rhs_symbols(ID_expression_list);
+    for(const auto &symbol : symbols)
+      rhs_symbols.copy_to_operands(symbol);
+    ssa_rhs = std::move(rhs_symbols);
+  }
+
+  if(arguments_ptr)
+  {
+    argumentst &args = write_arguments();
+    args.io_args.clear();
+    args.ssa_function_arguments.clear();
+    args.ssa_function_arguments.shrink_to_fit();
+  }
+}
+
+const SSA_stept::argumentst &SSA_stept::arguments() const
+{
+  static const argumentst no_arguments;
+  return arguments_ptr ? *arguments_ptr : no_arguments;
+}
+
+SSA_stept::argumentst &SSA_stept::write_arguments()
+{
+  if(!arguments_ptr)
+    arguments_ptr = std::make_shared<argumentst>();
+  else if(arguments_ptr.use_count() != 1)
+    arguments_ptr = std::make_shared<argumentst>(*arguments_ptr);
+
+  return *arguments_ptr;
+}
+
 /// Check that the SSA step is well-formed
 /// \param ns: namespace to lookup identifiers
 /// \param vm: validation mode to be used for reporting failures
@@ -156,11 +200,11 @@ void SSA_stept::validate(const namespacet &ns, const validation_modet vm) const
     break;
   case goto_trace_stept::typet::INPUT:
   case goto_trace_stept::typet::OUTPUT:
-    for(const auto &expr : io_args)
+    for(const auto &expr : arguments().io_args)
       validate_full_expr(expr, ns, vm);
     break;
   case goto_trace_stept::typet::FUNCTION_CALL:
-    for(const auto &expr : ssa_function_arguments)
+    for(const auto &expr : arguments().ssa_function_arguments)
       validate_full_expr(expr, ns, vm);
   case goto_trace_stept::typet::FUNCTION_RETURN:
   {
@@ -9,6 +9,8 @@ Author: Romain Brenguier <romain.brenguier@diffblue.com>
 #ifndef CPROVER_GOTO_SYMEX_SSA_STEP_H
 #define CPROVER_GOTO_SYMEX_SSA_STEP_H
 
+#include <memory>
+
 #include <goto-programs/goto_trace.h>
 
 #include "symex_target.h"
@@ -39,7 +41,8 @@ Author: Romain Brenguier <romain.brenguier@diffblue.com>
 /// or partial orders: they represent assumptions with global effect.
 ///
 /// Function calls store `called_function` name as well as a vector of
-/// arguments `ssa_function_arguments`. The `converted` version of a
+/// arguments `ssa_function_arguments`, which like the arguments of
+/// input/output steps are kept in \ref arguments. The `converted` version of a
 /// variable will contain its version for the SAT/SMT conversion.
 class SSA_stept
 {
@@ -134,6 +137,12 @@ public:
   // we may choose to hide
   bool hidden = false;
 
+  // for slicing
+  bool ignore = false;
+
+  // for incremental conversion
+  bool converted = false;
+
   exprt guard;
   exprt guard_handle;
 
@@ -143,38 +152,45 @@ public:
   exprt ssa_rhs;
   symex_targett::assignment_typet assignment_type;
 
+  // for SHARED_READ/SHARED_WRITE and ATOMIC_BEGIN/ATOMIC_END
+  unsigned atomic_section_id = 0;
+
   // for ASSUME/ASSERT/GOTO/CONSTRAINT
   exprt cond_expr;
   exprt cond_handle;
-  std::string comment;
-
-  // for INPUT/OUTPUT
-  irep_idt format_string, io_id;
-  bool formatted = false;
-  std::list<exprt> io_args;
-  std::list<exprt> converted_io_args;
+  irep_idt comment;
 
   // for function calls: the function that is called
   irep_idt called_function;
 
-  // for function calls
-  std::vector<exprt> ssa_function_arguments, converted_function_arguments;
+  /// Arguments of INPUT/OUTPUT and FUNCTION_CALL steps. Most steps have none,
+  /// hence these are stored apart from the step, and only once they are
+  /// written to. Copies of a step share its arguments until either is
+  /// written to.
+  struct argumentst
+  {
+    // for INPUT/OUTPUT
+    irep_idt format_string, io_id;
+    bool formatted = false;
+    std::list<exprt> io_args;
+    std::list<exprt> converted_io_args;
 
-  // for SHARED_READ/SHARED_WRITE and ATOMIC_BEGIN/ATOMIC_END
-  unsigned atomic_section_id = 0;
+    // for function calls
+    std::vector<exprt> ssa_function_arguments, converted_function_arguments;
+  };
 
-  // for slicing
-  bool ignore = false;
+  /// The arguments of this step, which are empty if they have not been written
+  const argumentst &arguments() const;
 
-  // for incremental conversion
-  bool converted = false;
+  /// The arguments of this step for writing, which stores them apart from
+  /// any copies of this step
+  argumentst &write_arguments();
 
   SSA_stept(
     const symex_targett::sourcet &_source,
     goto_trace_stept::typet _type)
     : source(_source),
       type(_type),
-      hidden(false),
       guard(static_cast<const exprt &>(get_nil_irep())),
       guard_handle(false_exprt()),
       ssa_lhs(static_cast<const ssa_exprt &>(get_nil_irep())),
@@ -183,16 +199,24 @@ public:
       ssa_rhs(static_cast<const exprt &>(get_nil_irep())),
       assignment_type(symex_targett::assignment_typet::STATE),
       cond_expr(static_cast<const exprt &>(get_nil_irep())),
-      cond_handle(false_exprt()),
-      formatted(false),
-      atomic_section_id(0),
-      ignore(false)
+      cond_handle(false_exprt())
   {
   }
 
   void output(std::ostream &out) const;
 
+  /// Drop the expressions that are only needed to convert this step to a
+  /// decision procedure, once it has been converted. This keeps the handles,
+  /// the left-hand sides, the conditions of assertions, assumptions and
+  /// gotos, and the converted arguments, which build_goto_trace uses. Of the
+  /// right-hand side only the symbols are kept, as these determine whether
+  /// the step is internal to the trace.
+  void release_converted_exprs();
+
   void validate(const namespacet &ns, const validation_modet vm) const;
+
+private:
+  std::shared_ptr<argumentst> arguments_ptr;
 };
 
 #endif // CPROVER_GOTO_SYMEX_SSA_STEP_H
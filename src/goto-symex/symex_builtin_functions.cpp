@@ -54,7 +54,7 @@ void goto_symext::symex_allocate(
   if(lhs.is_nil())
     return; // ignore
 
-  dynamic_counter++;
+  const unsigned dynamic_number = ++dynamic_counter;
 
   exprt size=code.op0();
   optionalt<typet> object_type;
@@ -135,7 +135,7 @@ void goto_symext::symex_allocate(
       auxiliary_symbolt size_symbol;
 
       size_symbol.base_name=
-        "dynamic_object_size"+std::to_string(dynamic_counter);
+        "dynamic_object_size" + std::to_string(dynamic_number);
       size_symbol.name =
         SYMEX_DYNAMIC_PREFIX + id2string(size_symbol.base_name);
       size_symbol.type=tmp_size.type();
@@ -155,7 +155,7 @@ void goto_symext::symex_allocate(
   // value
   symbolt value_symbol;
 
-  value_symbol.base_name="dynamic_object"+std::to_string(dynamic_counter);
+  value_symbol.base_name = "dynamic_object" + std::to_string(dynamic_number);
   value_symbol.name = SYMEX_DYNAMIC_PREFIX + id2string(value_symbol.base_name);
   value_symbol.is_lvalue=true;
   value_symbol.type = *object_type;
@@ -393,9 +393,7 @@ void goto_symext::symex_cpp_new(
     (code.get(ID_statement) == ID_cpp_new_array ||
      code.get(ID_statement) == ID_java_new_array_data);
 
-  dynamic_counter++;
-
-  const std::string count_string(std::to_string(dynamic_counter));
+  const std::string count_string(std::to_string(++dynamic_counter));
 
   // value
   symbolt symbol;
@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/invariant.h>
 #include <util/prefix.h>
 #include <util/range.h>
+#include <util/trace_timeline.h>
 
 static void locality(
   const irep_idt &function_identifier,
@@ -238,12 +239,7 @@ void goto_symext::symex_function_call_code(
   const goto_functionst::goto_functiont &goto_function =
     get_goto_function(identifier);
 
-  path_storage.dirty.populate_dirty_for_function(identifier, goto_function);
-
-  auto emplace_safe_pointers_result =
-    path_storage.safe_pointers.emplace(identifier, local_safe_pointerst{});
-  if(emplace_safe_pointers_result.second)
-    emplace_safe_pointers_result.first->second(goto_function.body);
+  path_storage.add_function_analyses(identifier, goto_function);
 
   const bool stop_recursing = get_unwind_recursion(
     identifier,
@@ -319,6 +315,8 @@ void goto_symext::symex_function_call_code(
   frame.return_value=call.lhs();
   frame.function_identifier=identifier;
   frame.hidden_function = callee_is_hidden;
+  if(trace_timeline().is_enabled())
+    frame.trace_start = trace_timelinet::now();
 
   const framet &p_frame = state.call_stack().previous_frame();
   for(const auto &pair : p_frame.loop_iterations)
@@ -344,6 +342,15 @@ pop_frame(goto_symext::statet &state, const path_storaget &path_storage)
   {
     const framet &frame = state.call_stack().top();
 
+    if(frame.trace_start.has_value() && trace_timeline().is_enabled())
+    {
+      trace_timeline().complete(
+        "symex " + id2string(frame.function_identifier),
+        "symex",
+        *frame.trace_start,
+        trace_timelinet::now() - *frame.trace_start);
+    }
+
     // restore program counter
     symex_transition(state, frame.calling_location.pc, false);
     state.source.function_id = frame.calling_location.function_id;
@@ -352,23 +359,24 @@ pop_frame(goto_symext::statet &state, const path_storaget &path_storage)
     state.level1.restore_from(frame.old_level1);
 
     // clear function-locals from L2 renaming
-    for(auto c_it = state.get_level2().current_names.begin();
-        c_it != state.get_level2().current_names.end();) // no ++c_it
-    {
-      const irep_idt l1_o_id=c_it->second.first.get_l1_object_identifier();
-      // could use iteration over local_objects as l1_o_id is prefix
-      if(
-        frame.local_objects.find(l1_o_id) == frame.local_objects.end() ||
-        (state.threads.size() > 1 &&
-         path_storage.dirty(c_it->second.first.get_object_name())))
-      {
-        ++c_it;
-        continue;
-      }
-      auto cur = c_it;
-      ++c_it;
-      state.drop_l1_name(cur);
-    }
+    std::vector<irep_idt> keys_to_erase;
+    state.get_level2().current_names.iterate(
+      [&](const irep_idt &l1_identifier,
+          const std::pair<ssa_exprt, unsigned> &value) {
+        const irep_idt l1_o_id = value.first.get_l1_object_identifier();
+        // could use iteration over local_objects as l1_o_id is prefix
+        if(
+          frame.local_objects.find(l1_o_id) == frame.local_objects.end() ||
+          (state.threads.size() > 1 &&
+           path_storage.dirty(value.first.get_object_name())))
+        {
+          return;
+        }
+        keys_to_erase.push_back(l1_identifier);
+      });
+
+    for(const irep_idt &l1_identifier : keys_to_erase)
+      state.drop_l1_name(l1_identifier);
   }
 
   state.call_stack().pop();
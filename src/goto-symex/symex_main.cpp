@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <cassert>
 #include <memory>
+#include <sstream>
 
 #include <pointer-analysis/value_set_dereference.h>
 
@@ -21,10 +22,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/expr_util.h>
 #include <util/make_unique.h>
 #include <util/mathematical_expr.h>
+#include <util/memory_report.h>
+#include <util/perf_counters.h>
 #include <util/replace_symbol.h>
 #include <util/std_expr.h>
 #include <util/string2int.h>
 #include <util/symbol_table.h>
+#include <util/trace_timeline.h>
 
 symex_configt::symex_configt(const optionst &options)
   : max_depth(options.get_unsigned_int_option("depth")),
@@ -35,6 +39,7 @@ symex_configt::symex_configt(const optionst &options)
     self_loops_to_assumptions(
       options.get_bool_option("self-loops-to-assumptions")),
     simplify_opt(options.get_bool_option("simplify")),
+    simplify_cache_size(options.get_unsigned_int_option("simplify-cache")),
     unwinding_assertions(options.get_bool_option("unwinding-assertions")),
     partial_loops(options.get_bool_option("partial-loops")),
     debug_level(unsafe_string2int(options.get_option("debug-level"))),
@@ -247,6 +252,9 @@ void goto_symext::symex_with_state(
   const get_goto_functiont &get_goto_function,
   symbol_tablet &new_symbol_table)
 {
+  PERF_TIMER("symex");
+  trace_spant span("symex");
+
   // resets the namespace to only wrap a single symbol table, and does so upon
   // destruction of an object of this type; instantiating the type is thus all
   // that's needed to achieve a reset upon exiting this method
@@ -278,6 +286,9 @@ void goto_symext::symex_with_state(
   // as state.symbol_table might go out of scope
   reset_namespacet reset_ns(ns);
 
+  // simplification results may depend on the symbols in the namespace
+  simplifier.clear_cache();
+
   PRECONDITION(state.call_stack().top().end_of_function->is_end_function());
 
   symex_threaded_step(state, get_goto_function);
@@ -292,6 +303,15 @@ void goto_symext::symex_with_state(
       return;
   }
 
+  if(symex_config.simplify_cache_size != 0)
+  {
+    log.statistics() << "Simplifier cache: " << simplifier.cache_hits()
+                     << " hits, " << simplifier.cache_misses() << " misses"
+                     << messaget::eom;
+  }
+
+  memory_report().record_size("symex.SSA_steps", target.SSA_steps.size());
+
   // Clients may need to construct a namespace with both the names in
   // the original goto-program and the names generated during symbolic
   // execution, so return the names generated through symbolic execution
@@ -313,6 +333,26 @@ void goto_symext::resume_symex_from_saved_state(
   // its equation member point to the (valid) equation passed as an argument.
   statet state(saved_state, saved_equation);
 
+  // The state may have been saved by a symex instance using another path
+  // storage (see path_work_stealingt): use the analyses of ours, and make sure
+  // that they cover the functions of all frames of the state.
+  state.dirty = &path_storage.dirty;
+  const irep_idt entry_point_id = goto_functionst::entry_point();
+  path_storage.add_function_analyses(
+    entry_point_id, get_goto_function(entry_point_id));
+  for(const auto &thread : state.threads)
+  {
+    for(const auto &frame : thread.call_stack)
+    {
+      if(!frame.function_identifier.empty())
+      {
+        path_storage.add_function_analyses(
+          frame.function_identifier,
+          get_goto_function(frame.function_identifier));
+      }
+    }
+  }
+
   // Do NOT do the same initialization that `symex_with_state` does for a
   // fresh state, as that would clobber the saved state's program counter
   symex_with_state(
@@ -362,13 +402,7 @@ std::unique_ptr<goto_symext::statet> goto_symext::initialize_entry_point_state(
   state->run_validation_checks = symex_config.run_validation_checks;
 
   // initialize support analyses
-  auto emplace_safe_pointers_result =
-    path_storage.safe_pointers.emplace(entry_point_id, local_safe_pointerst{});
-  if(emplace_safe_pointers_result.second)
-    emplace_safe_pointers_result.first->second(start_function->body);
-
-  path_storage.dirty.populate_dirty_for_function(
-    entry_point_id, *start_function);
+  path_storage.add_function_analyses(entry_point_id, *start_function);
   state->dirty = &path_storage.dirty;
 
   // make the first step onto the instruction pointed to by the initial program
@@ -409,6 +443,25 @@ goto_symext::get_goto_function(abstract_goto_modelt &goto_model)
   };
 }
 
+/// Count the symbolic execution of an instruction of type \p type in the
+/// counter "symex.steps.<type>"
+static void count_symex_step(goto_program_instruction_typet type)
+{
+  static const std::vector<perf_countert *> counters = [] {
+    std::vector<perf_countert *> result;
+    for(int t = NO_INSTRUCTION_TYPE; t <= INCOMPLETE_GOTO; ++t)
+    {
+      std::ostringstream name;
+      name << "symex.steps." << goto_program_instruction_typet(t);
+      result.push_back(&perf_counters().counter(name.str()));
+    }
+    return result;
+  }();
+
+  PRECONDITION(type < counters.size());
+  counters[type]->add(1);
+}
+
 /// do just one step
 void goto_symext::symex_step(
   const get_goto_functiont &get_goto_function,
@@ -426,8 +479,13 @@ void goto_symext::symex_step(
 
   const goto_programt::instructiont &instruction=*state.source.pc;
 
+  if(perf_counters_enabled())
+    count_symex_step(instruction.type);
+
   if(!symex_config.doing_path_exploration)
     merge_gotos(state);
+  else if(!state.guard.is_false())
+    path_storage.instruction_executed(state.source.pc);
 
   // depth exceeded?
   if(symex_config.max_depth != 0 && state.depth > symex_config.max_depth)
@@ -52,17 +52,20 @@ void goto_symext::symex_start_thread(statet &state)
   // create a copy of the local variables for the new thread
   framet &frame = state.call_stack().top();
 
-  for(auto c_it = state.get_level2().current_names.begin();
-      c_it != state.get_level2().current_names.end();
-      ++c_it)
+  // collect the locals first, the assignments below modify the L2 map
+  std::vector<ssa_exprt> locals;
+  state.get_level2().current_names.iterate(
+    [&](const irep_idt &, const std::pair<ssa_exprt, unsigned> &value) {
+      const irep_idt l1_o_id = value.first.get_l1_object_identifier();
+      // could use iteration over local_objects as l1_o_id is prefix
+      if(frame.local_objects.find(l1_o_id) != frame.local_objects.end())
+        locals.push_back(value.first);
+    });
+
+  for(const ssa_exprt &ssa : locals)
   {
-    const irep_idt l1_o_id=c_it->second.first.get_l1_object_identifier();
-    // could use iteration over local_objects as l1_o_id is prefix
-    if(frame.local_objects.find(l1_o_id)==frame.local_objects.end())
-      continue;
-
     // get original name
-    ssa_exprt lhs(c_it->second.first.get_original_expr());
+    ssa_exprt lhs(ssa.get_original_expr());
 
     // get L0 name for current thread
     lhs.set_level_0(t);
@@ -71,18 +74,16 @@ void goto_symext::symex_start_thread(statet &state)
     CHECK_RETURN(l1_index == 0);
 
     // set up L1 name
-    auto emplace_result = state.level1.current_names.emplace(
-      std::piecewise_construct,
-      std::forward_as_tuple(lhs.get_l1_object_identifier()),
-      std::forward_as_tuple(lhs, 0));
-    CHECK_RETURN(emplace_result.second);
+    const irep_idt l0_object_name = lhs.get_l1_object_identifier();
+    CHECK_RETURN(!state.level1.current_names.has_key(l0_object_name));
+    state.level1.current_names.insert(l0_object_name, std::make_pair(lhs, 0));
     const ssa_exprt lhs_l1 = state.rename_ssa<L1>(std::move(lhs), ns).get();
     const irep_idt l1_name = lhs_l1.get_l1_object_identifier();
     // store it
     new_thread.call_stack.back().local_objects.insert(l1_name);
 
     // make copy
-    ssa_exprt rhs=c_it->second.first;
+    ssa_exprt rhs = ssa;
 
     exprt::operandst lhs_conditions;
     const bool record_events=state.record_events;
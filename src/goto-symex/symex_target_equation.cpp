@@ -13,7 +13,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "symex_target_equation.h"
 
 #include <util/format_expr.h>
+#include <util/perf_counters.h>
 #include <util/std_expr.h>
+#include <util/trace_timeline.h>
 #include <util/throw_with_nested.h>
 #include <util/unwrap_nested_exception.h>
 
@@ -192,8 +194,13 @@ void symex_target_equationt::function_call(
 
   SSA_step.guard = guard;
   SSA_step.called_function = function_id;
-  for(const auto &arg : function_arguments)
-    SSA_step.ssa_function_arguments.emplace_back(arg.get());
+  if(!function_arguments.empty())
+  {
+    auto &arguments = SSA_step.write_arguments().ssa_function_arguments;
+    arguments.reserve(function_arguments.size());
+    for(const auto &arg : function_arguments)
+      arguments.emplace_back(arg.get());
+  }
   SSA_step.hidden = hidden;
 
   merge_ireps(SSA_step);
@@ -225,9 +232,10 @@ void symex_target_equationt::output(
   SSA_stept &SSA_step=SSA_steps.back();
 
   SSA_step.guard=guard;
+  SSA_stept::argumentst &arguments = SSA_step.write_arguments();
   for(const auto &arg : args)
-    SSA_step.io_args.emplace_back(arg.get());
-  SSA_step.io_id=output_id;
+    arguments.io_args.emplace_back(arg.get());
+  arguments.io_id = output_id;
 
   merge_ireps(SSA_step);
 }
@@ -243,10 +251,11 @@ void symex_target_equationt::output_fmt(
   SSA_stept &SSA_step=SSA_steps.back();
 
   SSA_step.guard=guard;
-  SSA_step.io_args=args;
-  SSA_step.io_id=output_id;
-  SSA_step.formatted=true;
-  SSA_step.format_string=fmt;
+  SSA_stept::argumentst &arguments = SSA_step.write_arguments();
+  arguments.io_args = args;
+  arguments.io_id = output_id;
+  arguments.formatted = true;
+  arguments.format_string = fmt;
 
   merge_ireps(SSA_step);
 }
@@ -261,8 +270,9 @@ void symex_target_equationt::input(
   SSA_stept &SSA_step=SSA_steps.back();
 
   SSA_step.guard=guard;
-  SSA_step.io_args=args;
-  SSA_step.io_id=input_id;
+  SSA_stept::argumentst &arguments = SSA_step.write_arguments();
+  arguments.io_args = args;
+  arguments.io_id = input_id;
 
   merge_ireps(SSA_step);
 }
@@ -329,6 +339,9 @@ void symex_target_equationt::constraint(
 
 void symex_target_equationt::convert(decision_proceduret &decision_procedure)
 {
+  PERF_TIMER("symex_target_equation.convert");
+  trace_spant span("convert_SSA");
+
   try
   {
     convert_guards(decision_procedure);
@@ -603,27 +616,38 @@ void symex_target_equationt::convert_function_calls(
 {
   for(auto &step : SSA_steps)
     if(!step.ignore)
-    {
-      step.converted_function_arguments.reserve(step.ssa_function_arguments.size());
+      convert_function_arguments(dec_proc, step);
+}
 
-      for(const auto &arg : step.ssa_function_arguments)
-      {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_function_arguments.push_back(arg);
-        else
-        {
-          const irep_idt identifier="symex::args::"+std::to_string(argument_count++);
-          symbol_exprt symbol(identifier, arg.type());
+void symex_target_equationt::convert_function_arguments(
+  decision_proceduret &dec_proc,
+  SSA_stept &step)
+{
+  if(step.arguments().ssa_function_arguments.empty())
+    return;
 
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
+  SSA_stept::argumentst &arguments = step.write_arguments();
+  arguments.converted_function_arguments.reserve(
+    arguments.ssa_function_arguments.size());
 
-          dec_proc.set_to(eq, true);
-          step.converted_function_arguments.push_back(symbol);
-        }
-      }
+  for(const auto &arg : arguments.ssa_function_arguments)
+  {
+    if(arg.is_constant() ||
+       arg.id()==ID_string_constant)
+      arguments.converted_function_arguments.push_back(arg);
+    else
+    {
+      const irep_idt identifier =
+        "symex::args::" + std::to_string(argument_count++);
+      symbol_exprt symbol(identifier, arg.type());
+
+      equal_exprt eq(arg, symbol);
+      merge(eq);
+
+      dec_proc.set_to(eq, true);
+      arguments.converted_function_arguments.push_back(symbol);
     }
+  }
 }
 
 void symex_target_equationt::convert_io(
@@ -631,26 +655,186 @@ void symex_target_equationt::convert_io(
 {
   for(auto &step : SSA_steps)
     if(!step.ignore)
+      convert_io_arguments(dec_proc, step);
+}
+
+void symex_target_equationt::convert_io_arguments(
+  decision_proceduret &dec_proc,
+  SSA_stept &step)
+{
+  if(step.arguments().io_args.empty())
+    return;
+
+  SSA_stept::argumentst &arguments = step.write_arguments();
+  for(const auto &arg : arguments.io_args)
+  {
+    if(arg.is_constant() ||
+       arg.id()==ID_string_constant)
+      arguments.converted_io_args.push_back(arg);
+    else
+    {
+      const irep_idt identifier =
+        "symex::io::" + std::to_string(io_count++);
+      symbol_exprt symbol(identifier, arg.type());
+
+      equal_exprt eq(arg, symbol);
+      merge(eq);
+
+      dec_proc.set_to(eq, true);
+      arguments.converted_io_args.push_back(symbol);
+    }
+  }
+}
+
+void symex_target_equationt::convert_new_steps(
+  decision_proceduret &decision_procedure,
+  bool release_steps)
+{
+  if(SSA_steps.empty())
+    return;
+
+  SSA_stepst::iterator it;
+  if(conversion_started)
+    it = std::next(last_converted_step);
+  else
+  {
+    conversion_started = true;
+    it = first_converted_step = SSA_steps.begin();
+  }
+
+  try
+  {
+    for(; it != SSA_steps.end(); ++it)
     {
-      for(const auto &arg : step.io_args)
+      convert_step(decision_procedure, *it);
+      last_converted_step = it;
+
+      // the memory model needs the guards and left-hand sides of the
+      // events of threads, which are added while symex is still running
+      if(
+        release_steps && !it->is_shared_read() && !it->is_shared_write() &&
+        !it->is_spawn() && !it->is_memory_barrier() &&
+        !it->is_atomic_begin() && !it->is_atomic_end())
       {
-        if(arg.is_constant() ||
-           arg.id()==ID_string_constant)
-          step.converted_io_args.push_back(arg);
-        else
-        {
-          const irep_idt identifier =
-            "symex::io::" + std::to_string(io_count++);
-          symbol_exprt symbol(identifier, arg.type());
+        it->release_converted_exprs();
+      }
+    }
+  }
+  catch(const equation_conversion_exceptiont &conversion_exception)
+  {
+    // unwrap the except and throw like normal
+    const std::string full_error = unwrap_exception(conversion_exception);
+    throw full_error;
+  }
+}
+
+void symex_target_equationt::finish_conversion(
+  decision_proceduret &decision_procedure)
+{
+  PERF_TIMER("symex_target_equation.finish_conversion");
 
-          equal_exprt eq(arg, symbol);
-          merge_irep(eq);
+  convert_new_steps(decision_procedure, false);
 
-          dec_proc.set_to(eq, true);
-          step.converted_io_args.push_back(symbol);
-        }
+  try
+  {
+    // steps that have been added to the front since the conversion started
+    for(auto it = SSA_steps.begin();
+        conversion_started && it != first_converted_step;
+        ++it)
+    {
+      convert_step(decision_procedure, *it);
+    }
+  }
+  catch(const equation_conversion_exceptiont &conversion_exception)
+  {
+    const std::string full_error = unwrap_exception(conversion_exception);
+    throw full_error;
+  }
+
+  // We do (NOT a1) OR (NOT a2) ...
+  // where the a's are the assertions
+  if(!negated_assertions.empty())
+  {
+    decision_procedure.set_to_true(disjunction(negated_assertions));
+    negated_assertions.clear();
+  }
+}
+
+void symex_target_equationt::convert_step(
+  decision_proceduret &decision_procedure,
+  SSA_stept &step)
+{
+  if(step.ignore)
+  {
+    step.guard_handle = false_exprt();
+    if(step.is_assume() || step.is_goto())
+      step.cond_handle = true_exprt();
+    return;
+  }
+
+  log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
+    step.output(mstream);
+    mstream << messaget::eom;
+  });
+
+  try
+  {
+    step.guard_handle = decision_procedure.handle(step.guard);
+  }
+  catch(const bitvector_conversion_exceptiont &)
+  {
+    util_throw_with_nested(
+      equation_conversion_exceptiont("Error converting guard for step", step));
+  }
+
+  try
+  {
+    if(step.is_assignment() && !step.converted)
+    {
+      decision_procedure.set_to_true(step.cond_expr);
+      step.converted = true;
+    }
+    else if(step.is_decl() && !step.converted)
+    {
+      decision_procedure.handle(step.cond_expr);
+      step.converted = true;
+    }
+    else if(step.is_assume())
+    {
+      step.cond_handle = decision_procedure.handle(step.cond_expr);
+
+      // avoid deep nesting of ID_and expressions
+      if(converted_assumptions.id() == ID_and)
+        converted_assumptions.copy_to_operands(step.cond_handle);
+      else
+      {
+        converted_assumptions =
+          and_exprt(converted_assumptions, step.cond_handle);
       }
     }
+    else if(step.is_assert() && !step.converted)
+    {
+      step.converted = true;
+      step.cond_handle = decision_procedure.handle(
+        implies_exprt(converted_assumptions, step.cond_expr));
+      negated_assertions.push_back(not_exprt(step.cond_handle));
+    }
+    else if(step.is_goto())
+      step.cond_handle = decision_procedure.handle(step.cond_expr);
+    else if(step.is_constraint() && !step.converted)
+    {
+      decision_procedure.set_to_true(step.cond_expr);
+      step.converted = true;
+    }
+  }
+  catch(const bitvector_conversion_exceptiont &)
+  {
+    util_throw_with_nested(
+      equation_conversion_exceptiont("Error converting step", step));
+  }
+
+  convert_function_arguments(decision_procedure, step);
+  convert_io_arguments(decision_procedure, step);
 }
 
 /// Merging causes identical ireps to be shared.
@@ -658,24 +842,45 @@ void symex_target_equationt::convert_io(
 /// \param SSA_step The step you want to have shared values.
 void symex_target_equationt::merge_ireps(SSA_stept &SSA_step)
 {
-  merge_irep(SSA_step.guard);
+  merge(SSA_step.guard);
 
-  merge_irep(SSA_step.ssa_lhs);
-  merge_irep(SSA_step.ssa_full_lhs);
-  merge_irep(SSA_step.original_full_lhs);
-  merge_irep(SSA_step.ssa_rhs);
+  merge(SSA_step.ssa_lhs);
+  merge(SSA_step.ssa_full_lhs);
+  merge(SSA_step.original_full_lhs);
+  merge(SSA_step.ssa_rhs);
 
-  merge_irep(SSA_step.cond_expr);
+  merge(SSA_step.cond_expr);
 
-  for(auto &step : SSA_step.io_args)
-    merge_irep(step);
+  if(
+    !SSA_step.arguments().io_args.empty() ||
+    !SSA_step.arguments().ssa_function_arguments.empty())
+  {
+    SSA_stept::argumentst &arguments = SSA_step.write_arguments();
+
+    for(auto &arg : arguments.io_args)
+      merge(arg);
 
-  for(auto &arg : SSA_step.ssa_function_arguments)
-    merge_irep(arg);
+    for(auto &arg : arguments.ssa_function_arguments)
+      merge(arg);
+  }
 
   // converted_io_args is merged in convert_io
 }
 
+/// Cause \p irep to share its nodes with identical ireps stored before, using
+/// the process-wide unique table if hash-consing has been enabled (see
+/// \ref hash_consing_irept) and the table of this equation otherwise.
+/// \param irep: The irep you want to have shared values.
+void symex_target_equationt::merge(irept &irep)
+{
+  hash_consing_irept &hash_consing = get_hash_consing_irep();
+
+  if(hash_consing.is_enabled())
+    hash_consing(irep);
+  else
+    merge_irep(irep);
+}
+
 void symex_target_equationt::output(std::ostream &out) const
 {
   for(const auto &step : SSA_steps)
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <list>
 
+#include <util/chunked_deque.h>
 #include <util/invariant.h>
 #include <util/merge_irep.h>
 #include <util/message.h>
@@ -219,6 +220,28 @@ public:
   /// \param decision_procedure: A handle to a decision procedure interface
   void convert_io(decision_proceduret &decision_procedure);
 
+  /// Converts the steps that have been added since the last call, in the
+  /// order in which they have been added, such that the equation can be
+  /// converted while symbolic execution is still running. Unlike
+  /// \ref convert, each assertion is converted as soon as it is added, into
+  /// the implication of the assumptions added before it. Call
+  /// \ref finish_conversion once symbolic execution has completed.
+  /// \param decision_procedure: A handle to a decision procedure interface
+  /// \param release_steps: Whether to drop the expressions of converted steps
+  ///   that are not needed to build traces, see
+  ///   \ref SSA_stept::release_converted_exprs. Steps of threads are kept
+  ///   for the memory model.
+  void convert_new_steps(
+    decision_proceduret &decision_procedure,
+    bool release_steps);
+
+  /// Completes a conversion by \ref convert_new_steps: converts the steps
+  /// added since its last call, including those a memory model has added to
+  /// the front of the equation, and sets the disjunction of the negated
+  /// assertions to _True_.
+  /// \param decision_procedure: A handle to a decision procedure interface
+  void finish_conversion(decision_proceduret &decision_procedure);
+
   exprt make_expression() const;
 
   std::size_t count_assertions() const
@@ -237,18 +260,15 @@ public:
       }));
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  /// The steps are stored in chunks of contiguous memory, which they do not
+  /// leave when steps are added; iterators to steps remain valid as well.
+  typedef chunked_dequet<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
-    SSA_stepst::iterator it=SSA_steps.begin();
-    for(; s!=0; s--)
-    {
-      PRECONDITION(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    PRECONDITION(s <= SSA_steps.size());
+    return SSA_steps.begin() + narrow_cast<std::ptrdiff_t>(s);
   }
 
   void output(std::ostream &out) const;
@@ -278,19 +298,24 @@ protected:
   // for enforcing sharing in the expressions stored
   merge_irept merge_irep;
   void merge_ireps(SSA_stept &SSA_step);
+  void merge(irept &irep);
 
   // for unique I/O identifiers
   std::size_t io_count = 0;
 
   // for unique function call argument identifiers
   std::size_t argument_count = 0;
-};
 
-inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a)<&(*b);
-}
+  void convert_step(decision_proceduret &, SSA_stept &);
+  void convert_function_arguments(decision_proceduret &, SSA_stept &);
+  void convert_io_arguments(decision_proceduret &, SSA_stept &);
+
+  // for converting the steps while they are added, see convert_new_steps
+  bool conversion_started = false;
+  SSA_stepst::iterator first_converted_step;
+  SSA_stepst::iterator last_converted_step;
+  exprt converted_assumptions = true_exprt();
+  exprt::operandst negated_assertions;
+};
 
 #endif // CPROVER_GOTO_SYMEX_SYMEX_TARGET_EQUATION_H
@@ -10,7 +10,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <fstream>
 
+#include <util/memory_report.h>
 #include <util/object_factory_parameters.h>
+#include <util/trace_timeline.h>
 
 #include "language.h"
 
@@ -52,6 +54,8 @@ void language_filest::show_parse(std::ostream &out)
 
 bool language_filest::parse()
 {
+  trace_spant span("parse");
+
   for(auto &file : file_map)
   {
     // open file
@@ -79,6 +83,8 @@ bool language_filest::parse()
     file.second.get_modules();
   }
 
+  memory_report().snapshot("parse");
+
   return false;
 }
 
@@ -86,6 +92,8 @@ bool language_filest::typecheck(
   symbol_tablet &symbol_table,
   const bool keep_file_local)
 {
+  trace_spant span("typecheck");
+
   // typecheck interfaces
 
   for(auto &file : file_map)
@@ -159,6 +167,10 @@ bool language_filest::typecheck(
       return true;
   }
 
+  memory_report().snapshot("typecheck");
+  memory_report().record_size(
+    "symbol_table.symbols", symbol_table.symbols.size());
+
   return false;
 }
 
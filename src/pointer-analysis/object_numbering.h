@@ -18,13 +18,91 @@ Author: Daniel Kroening, kroening@kroening.com
 /// Then any users that agree to use the same object_numberingt instance as a
 /// common reference source can use '1' and '2' as shorthands for "Hello" and
 /// "World" respectively.
+///
+/// The numbering of \ref value_sett is shared by the value sets of all
+/// symbolic execution states, including those of paths that are explored in
+/// several threads at once. While an \ref irep_concurrency_scopet is active,
+/// numbering expressions and looking them up is therefore serialized. The
+/// expressions are kept in a std::deque, so that references to them stay valid
+/// while further expressions are numbered.
 
 #ifndef CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
 #define CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
 
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
 #include <util/expr.h>
-#include <util/numbering.h>
+#include <util/optional.h>
+
+class object_numberingt
+{
+public:
+  typedef std::size_t number_type;
+
+  number_type number(const exprt &expr)
+  {
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(irep_concurrency_scopet::is_active())
+      lock.lock();
+
+    const auto result = numbers.emplace(expr, objects.size());
+    if(result.second) // inserted?
+      objects.push_back(expr);
+
+    return result.first->second;
+  }
+
+  optionalt<number_type> get_number(const exprt &expr) const
+  {
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(irep_concurrency_scopet::is_active())
+      lock.lock();
+
+    const auto it = numbers.find(expr);
+    if(it == numbers.end())
+      return {};
+    return it->second;
+  }
+
+  const exprt &operator[](number_type n) const
+  {
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(irep_concurrency_scopet::is_active())
+      lock.lock();
+
+    return objects[n];
+  }
+
+  const exprt &at(number_type n) const
+  {
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(irep_concurrency_scopet::is_active())
+      lock.lock();
+
+    return objects.at(n);
+  }
+
+  std::size_t size() const
+  {
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+    if(irep_concurrency_scopet::is_active())
+      lock.lock();
+
+    return objects.size();
+  }
+
+  void clear()
+  {
+    objects.clear();
+    numbers.clear();
+  }
 
-typedef hash_numbering<exprt, irep_hash> object_numberingt;
+private:
+  std::deque<exprt> objects;
+  std::unordered_map<exprt, number_type, irep_hash> numbers;
+  mutable std::mutex mutex;
+};
 
 #endif // CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
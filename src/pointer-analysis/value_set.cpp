@@ -234,33 +234,33 @@ exprt value_sett::to_expr(const object_map_dt::value_type &it) const
 
 bool value_sett::make_union(const value_sett::valuest &new_values)
 {
-  bool result=false;
-
-  value_sett::valuest::delta_viewt delta_view;
-
-  new_values.get_delta_view(values, delta_view, false);
-
-  for(const auto &delta_entry : delta_view)
-  {
-    if(delta_entry.in_both)
-    {
-      if(make_union_would_change(
-           delta_entry.other_m.object_map, delta_entry.m.object_map))
+  // A three-way merge with an empty base map yields the union of the maps.
+  // Subtrees that are shared between the maps are skipped, and subtrees that
+  // only the new values have are shared rather than copied key by key.
+  const valuest empty;
+
+  return values.merge(
+    empty,
+    new_values,
+    [this](
+      const irep_idt &,
+      const entryt *,
+      const entryt *entry,
+      const entryt *new_entry) -> optionalt<entryt> {
+      if(entry == nullptr)
+        return *new_entry;
+
+      if(
+        new_entry == nullptr ||
+        !make_union_would_change(entry->object_map, new_entry->object_map))
       {
-        values.update(delta_entry.k, [&](entryt &existing_entry) {
-          make_union(existing_entry.object_map, delta_entry.m.object_map);
-        });
-        result = true;
+        return *entry;
       }
-    }
-    else
-    {
-      values.insert(delta_entry.k, delta_entry.m);
-      result = true;
-    }
-  }
 
-  return result;
+      entryt merged_entry = *entry;
+      make_union(merged_entry.object_map, new_entry->object_map);
+      return std::move(merged_entry);
+    });
 }
 
 bool value_sett::make_union_would_change(
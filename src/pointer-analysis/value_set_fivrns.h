@@ -20,6 +20,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/mp_arith.h>
 #include <util/namespace.h>
+#include <util/numbering.h>
 #include <util/reference_counting.h>
 #include <util/invariant.h>
 
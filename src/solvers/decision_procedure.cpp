@@ -11,12 +11,16 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "decision_procedure.h"
 
+#include <util/trace_timeline.h>
+
 decision_proceduret::~decision_proceduret()
 {
 }
 
 decision_proceduret::resultt decision_proceduret::operator()()
 {
+  trace_spant span("dec_solve");
+
   return dec_solve();
 }
 
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/arith_tools.h>
 #include <util/magic.h>
 #include <util/mp_arith.h>
+#include <util/perf_counters.h>
 #include <util/prefix.h>
 #include <util/replace_expr.h>
 #include <util/std_expr.h>
@@ -28,6 +29,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <solvers/floatbv/float_utils.h>
 #include <solvers/lowering/expr_lowering.h>
+#include <solvers/sat/cnf.h>
 
 bool boolbvt::literal(
   const exprt &expr,
@@ -123,13 +125,15 @@ boolbvt::convert_bv(const exprt &expr, optionalt<std::size_t> expected_width)
     bv_cache.insert(std::make_pair(expr, bvt()));
   if(!cache_result.second)
   {
+    PERF_COUNT("boolbv.cache_hits");
     return cache_result.first->second;
   }
 
   // Iterators into hash_maps supposedly stay stable
   // even though we are inserting more elements recursively.
 
-  const bvt &bv = convert_bitvector(expr);
+  const bvt &bv = perf_counters_enabled() ? convert_bitvector_profiled(expr)
+                                          : convert_bitvector(expr);
 
   INVARIANT_WITH_DIAGNOSTICS(
     !expected_width || bv.size() == *expected_width,
@@ -155,6 +159,40 @@ boolbvt::convert_bv(const exprt &expr, optionalt<std::size_t> expected_width)
   return cache_result.first->second;
 }
 
+bvt boolbvt::convert_bitvector_profiled(const exprt &expr)
+{
+  const cnft *cnf = dynamic_cast<const cnft *>(&prop);
+
+  const std::size_t variables_before = prop.no_variables();
+  const std::size_t clauses_before = cnf ? cnf->no_clauses() : 0;
+
+  const std::size_t outer_variables = profiled_variables;
+  const std::size_t outer_clauses = profiled_clauses;
+  profiled_variables = 0;
+  profiled_clauses = 0;
+
+  bvt bv = convert_bitvector(expr);
+
+  const std::size_t variables = prop.no_variables() - variables_before;
+  const std::size_t clauses = cnf ? cnf->no_clauses() - clauses_before : 0;
+
+  const std::string &id = id2string(expr.id());
+  perf_counters()
+    .counter("boolbv.variables." + id)
+    .add(variables - profiled_variables);
+  if(cnf)
+  {
+    perf_counters()
+      .counter("boolbv.clauses." + id)
+      .add(clauses - profiled_clauses);
+  }
+
+  profiled_variables = outer_variables + variables;
+  profiled_clauses = outer_clauses + clauses;
+
+  return bv;
+}
+
 /// Print that the expression of x has failed conversion,
 /// then return a vector of x's width.
 bvt boolbvt::conversion_failed(const exprt &expr)
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/byte_operators.h>
 #include <util/expr.h>
+#include <util/memory_report.h>
 #include <util/mp_arith.h>
 #include <util/optional.h>
 
@@ -65,6 +66,7 @@ public:
 
   void post_process() override
   {
+    memory_report().record_size("boolbv.bv_cache", bv_cache.size());
     post_process_quantifiers();
     functions.post_process();
     SUB::post_process();
@@ -119,6 +121,17 @@ protected:
   typedef std::unordered_map<const exprt, bvt, irep_hash> bv_cachet;
   bv_cachet bv_cache;
 
+  /// Like \ref convert_bitvector, but also records the number of variables
+  /// and clauses created for \p expr (excluding those created for its
+  /// operands) in the performance counters "boolbv.variables.<id>" and
+  /// "boolbv.clauses.<id>"
+  bvt convert_bitvector_profiled(const exprt &expr);
+
+  // variables and clauses created by nested calls to
+  // convert_bitvector_profiled
+  std::size_t profiled_variables = 0;
+  std::size_t profiled_clauses = 0;
+
   bool type_conversion(
     const typet &src_type, const bvt &src,
     const typet &dest_type, bvt &dest);
@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "boolbv.h"
 
 #include <algorithm>
+#include <atomic>
 
 #include <util/arith_tools.h>
 #include <util/cprover_prefix.h>
@@ -116,7 +117,7 @@ bvt boolbvt::convert_index(const index_exprt &expr)
 
     if(is_uniform && prop.has_set_to())
     {
-      static int uniform_array_counter;  // Temporary hack
+      static std::atomic<int> uniform_array_counter;  // Temporary hack
 
       const std::string identifier = CPROVER_PREFIX "internal_uniform_array_" +
                                      std::to_string(uniform_array_counter++);
@@ -155,7 +156,7 @@ bvt boolbvt::convert_index(const index_exprt &expr)
       #endif
 
       // Symbol for output
-      static int actual_array_counter;  // Temporary hack
+      static std::atomic<int> actual_array_counter;  // Temporary hack
 
       const std::string identifier = CPROVER_PREFIX "internal_actual_array_" +
                                      std::to_string(actual_array_counter++);
@@ -10,6 +10,11 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <algorithm>
 
+#include <util/memory_report.h>
+#include <util/perf_counters.h>
+
+#include <solvers/sat/cnf.h>
+
 bool prop_conv_solvert::literal(const symbol_exprt &expr, literalt &dest) const
 {
   PRECONDITION(expr.type().id() == ID_bool);
@@ -424,6 +429,8 @@ void prop_conv_solvert::post_process()
 
 decision_proceduret::resultt prop_conv_solvert::dec_solve()
 {
+  PERF_TIMER("prop_conv_solver.dec_solve");
+
   // post-processing isn't incremental yet
   if(!post_processing_done)
   {
@@ -432,6 +439,15 @@ decision_proceduret::resultt prop_conv_solvert::dec_solve()
     post_processing_done = true;
   }
 
+  if(memory_report().is_enabled())
+  {
+    memory_report().record_size("prop.variables", prop.no_variables());
+
+    const cnft *cnf = dynamic_cast<const cnft *>(&prop);
+    if(cnf != nullptr)
+      memory_report().record_size("prop.clauses", cnf->no_clauses());
+  }
+
   log.statistics() << "Solving with " << prop.solver_text() << messaget::eom;
 
   switch(prop.prop_solve())
@@ -0,0 +1,426 @@
+/*******************************************************************\
+
+Module: Chunked deque
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Sequence container that stores its elements in chunks of contiguous memory
+
+#ifndef CPROVER_UTIL_CHUNKED_DEQUE_H
+#define CPROVER_UTIL_CHUNKED_DEQUE_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "invariant.h"
+#include "make_unique.h"
+
+/// Sequence container that stores its elements in chunks of `chunk_size`
+/// contiguous elements. Elements are added at either end and accessed by
+/// index in constant time; they cannot be removed individually.
+///
+/// Adding elements invalidates neither references nor iterators, unlike for
+/// std::deque: an iterator stores the position of its element relative to the
+/// first element that was added at the back, which does not change when
+/// elements are added at either end. Like those of std::list, iterators remain
+/// valid when the container is moved.
+template <typename T, std::size_t chunk_size = 64>
+class chunked_dequet
+{
+  static_assert(
+    chunk_size > 0 && (chunk_size & (chunk_size - 1)) == 0,
+    "chunk size must be a power of two");
+
+  using slott = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+  using chunkt = std::unique_ptr<slott[]>;
+
+  /// The elements at positions 0, 1, ... are stored in the chunks of `back`,
+  /// those at positions -1, -2, ... in the chunks of `front`. The container
+  /// holds the elements at positions `first` to `last - 1`.
+  struct storaget
+  {
+    std::vector<chunkt> front;
+    std::vector<chunkt> back;
+    std::ptrdiff_t first = 0;
+    std::ptrdiff_t last = 0;
+
+    T *address(std::ptrdiff_t position) const
+    {
+      if(position >= 0)
+      {
+        const auto index = static_cast<std::size_t>(position);
+        return reinterpret_cast<T *>(
+          &back[index / chunk_size][index % chunk_size]);
+      }
+      else
+      {
+        const auto index = static_cast<std::size_t>(-(position + 1));
+        return reinterpret_cast<T *>(
+          &front[index / chunk_size][index % chunk_size]);
+      }
+    }
+  };
+
+public:
+  template <bool is_const>
+  class iteratort
+  {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::conditional<is_const, const T *, T *>::type;
+    using reference =
+      typename std::conditional<is_const, const T &, T &>::type;
+
+    iteratort() = default;
+
+    /// Conversion of an iterator into a const_iterator
+    template <
+      bool other_is_const,
+      typename = typename std::enable_if<is_const && !other_is_const>::type>
+    // NOLINTNEXTLINE(runtime/explicit)
+    iteratort(const iteratort<other_is_const> &other)
+      : storage(other.storage), position(other.position)
+    {
+    }
+
+    reference operator*() const
+    {
+      return *storage->address(position);
+    }
+
+    pointer operator->() const
+    {
+      return storage->address(position);
+    }
+
+    reference operator[](difference_type n) const
+    {
+      return *storage->address(position + n);
+    }
+
+    iteratort &operator++()
+    {
+      ++position;
+      return *this;
+    }
+
+    iteratort operator++(int)
+    {
+      iteratort tmp = *this;
+      ++position;
+      return tmp;
+    }
+
+    iteratort &operator--()
+    {
+      --position;
+      return *this;
+    }
+
+    iteratort operator--(int)
+    {
+      iteratort tmp = *this;
+      --position;
+      return tmp;
+    }
+
+    iteratort &operator+=(difference_type n)
+    {
+      position += n;
+      return *this;
+    }
+
+    iteratort &operator-=(difference_type n)
+    {
+      position -= n;
+      return *this;
+    }
+
+    iteratort operator+(difference_type n) const
+    {
+      return iteratort(storage, position + n);
+    }
+
+    iteratort operator-(difference_type n) const
+    {
+      return iteratort(storage, position - n);
+    }
+
+    friend iteratort operator+(difference_type n, const iteratort &it)
+    {
+      return it + n;
+    }
+
+    template <bool other_is_const>
+    difference_type operator-(const iteratort<other_is_const> &other) const
+    {
+      return position - other.position;
+    }
+
+    template <bool other_is_const>
+    bool operator==(const iteratort<other_is_const> &other) const
+    {
+      return position == other.position;
+    }
+
+    template <bool other_is_const>
+    bool operator!=(const iteratort<other_is_const> &other) const
+    {
+      return position != other.position;
+    }
+
+    /// Iterators are ordered by the position of their elements
+    template <bool other_is_const>
+    bool operator<(const iteratort<other_is_const> &other) const
+    {
+      return position < other.position;
+    }
+
+    template <bool other_is_const>
+    bool operator>(const iteratort<other_is_const> &other) const
+    {
+      return position > other.position;
+    }
+
+    template <bool other_is_const>
+    bool operator<=(const iteratort<other_is_const> &other) const
+    {
+      return position <= other.position;
+    }
+
+    template <bool other_is_const>
+    bool operator>=(const iteratort<other_is_const> &other) const
+    {
+      return position >= other.position;
+    }
+
+  private:
+    const storaget *storage = nullptr;
+    std::ptrdiff_t position = 0;
+
+    iteratort(const storaget *storage, std::ptrdiff_t position)
+      : storage(storage), position(position)
+    {
+    }
+
+    friend class chunked_dequet;
+    template <bool>
+    friend class iteratort;
+  };
+
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = iteratort<false>;
+  using const_iterator = iteratort<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  chunked_dequet() : storage(util_make_unique<storaget>())
+  {
+  }
+
+  chunked_dequet(const chunked_dequet &other) : chunked_dequet()
+  {
+    for(const T &element : other)
+      emplace_back(element);
+  }
+
+  chunked_dequet(chunked_dequet &&other) : storage(std::move(other.storage))
+  {
+    other.storage = util_make_unique<storaget>();
+  }
+
+  chunked_dequet &operator=(const chunked_dequet &other)
+  {
+    if(this != &other)
+    {
+      chunked_dequet copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  chunked_dequet &operator=(chunked_dequet &&other)
+  {
+    swap(other);
+    return *this;
+  }
+
+  ~chunked_dequet()
+  {
+    clear();
+  }
+
+  void swap(chunked_dequet &other)
+  {
+    std::swap(storage, other.storage);
+  }
+
+  template <typename... Ts>
+  T &emplace_back(Ts &&... ts)
+  {
+    const auto index = static_cast<std::size_t>(storage->last);
+    if(index / chunk_size == storage->back.size())
+      storage->back.emplace_back(new slott[chunk_size]);
+
+    T *element = storage->address(storage->last);
+    new(element) T(std::forward<Ts>(ts)...);
+    ++storage->last;
+    return *element;
+  }
+
+  template <typename... Ts>
+  T &emplace_front(Ts &&... ts)
+  {
+    const auto index = static_cast<std::size_t>(-storage->first);
+    if(index / chunk_size == storage->front.size())
+      storage->front.emplace_back(new slott[chunk_size]);
+
+    T *element = storage->address(storage->first - 1);
+    new(element) T(std::forward<Ts>(ts)...);
+    --storage->first;
+    return *element;
+  }
+
+  void push_back(const T &element)
+  {
+    emplace_back(element);
+  }
+
+  void push_back(T &&element)
+  {
+    emplace_back(std::move(element));
+  }
+
+  void push_front(const T &element)
+  {
+    emplace_front(element);
+  }
+
+  void push_front(T &&element)
+  {
+    emplace_front(std::move(element));
+  }
+
+  /// Destroy all elements, which invalidates all references and iterators
+  void clear()
+  {
+    for(auto p = storage->first; p != storage->last; ++p)
+      storage->address(p)->~T();
+
+    storage->front.clear();
+    storage->back.clear();
+    storage->first = storage->last = 0;
+  }
+
+  size_type size() const
+  {
+    return static_cast<size_type>(storage->last - storage->first);
+  }
+
+  bool empty() const
+  {
+    return storage->first == storage->last;
+  }
+
+  T &operator[](size_type n)
+  {
+    return *storage->address(storage->first + static_cast<difference_type>(n));
+  }
+
+  const T &operator[](size_type n) const
+  {
+    return *storage->address(storage->first + static_cast<difference_type>(n));
+  }
+
+  T &front()
+  {
+    PRECONDITION(!empty());
+    return *storage->address(storage->first);
+  }
+
+  const T &front() const
+  {
+    PRECONDITION(!empty());
+    return *storage->address(storage->first);
+  }
+
+  T &back()
+  {
+    PRECONDITION(!empty());
+    return *storage->address(storage->last - 1);
+  }
+
+  const T &back() const
+  {
+    PRECONDITION(!empty());
+    return *storage->address(storage->last - 1);
+  }
+
+  iterator begin()
+  {
+    return iterator(storage.get(), storage->first);
+  }
+
+  iterator end()
+  {
+    return iterator(storage.get(), storage->last);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(storage.get(), storage->first);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(storage.get(), storage->last);
+  }
+
+  const_iterator cbegin() const
+  {
+    return begin();
+  }
+
+  const_iterator cend() const
+  {
+    return end();
+  }
+
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  reverse_iterator rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+private:
+  std::unique_ptr<storaget> storage;
+};
+
+#endif // CPROVER_UTIL_CHUNKED_DEQUE_H
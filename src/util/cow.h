@@ -12,6 +12,7 @@ Author: Reuben Thomas, reuben.thomas@diffblue.com
 #include "invariant.h"
 #include "small_shared_ptr.h"
 
+#include <atomic>
 #include <limits>
 
 /// A utility class for writing types with copy-on-write behaviour (like irep).
@@ -158,35 +159,49 @@ public:
     return *this;
   }
 
+  /// As in \ref small_shared_pointeet, the use count is updated atomically
+  /// only while an \ref irep_concurrency_scopet is active.
   void increment_use_count()
   {
     INVARIANT(
       is_shareable(),
       "cannot increment the use count of a non-shareable reference");
-    ++use_count_;
+    if(irep_concurrency_scopet::is_active())
+      use_count_.fetch_add(1, std::memory_order_relaxed);
+    else
+      use_count_.store(
+        use_count_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
   }
 
-  void decrement_use_count()
+  /// \return the use count after decrementing it
+  Num decrement_use_count()
   {
     INVARIANT(
       is_shareable(),
       "cannot decrement the use count of a non-shareable reference");
-    --use_count_;
+    if(irep_concurrency_scopet::is_active())
+      return use_count_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+    const Num result = use_count_.load(std::memory_order_relaxed) - 1;
+    use_count_.store(result, std::memory_order_relaxed);
+    return result;
   }
 
   Num use_count() const
   {
-    return is_shareable() ? use_count_ : 1;
+    const Num count = use_count_.load(std::memory_order_acquire);
+    return count != unshareable ? count : 1;
   }
 
   void set_shareable(bool u)
   {
-    use_count_ = u ? 1 : unshareable;
+    use_count_.store(u ? 1 : unshareable, std::memory_order_release);
   }
 
   bool is_shareable() const
   {
-    return use_count_ != unshareable;
+    return use_count_.load(std::memory_order_acquire) != unshareable;
   }
 
 protected:
@@ -200,7 +215,7 @@ private:
   /// Note that this is set to the max value that can be held by Num, but
   /// this cannot be done inline.
   static const Num unshareable;
-  Num use_count_ = 0;
+  std::atomic<Num> use_count_{0};
 };
 
 template <typename Num>
@@ -222,9 +237,9 @@ inline void pointee_increment_use_count(copy_on_write_pointeet<Num> &p)
 }
 
 template <typename Num>
-inline void pointee_decrement_use_count(copy_on_write_pointeet<Num> &p)
+inline Num pointee_decrement_use_count(copy_on_write_pointeet<Num> &p)
 {
-  p.decrement_use_count();
+  return p.decrement_use_count();
 }
 
 template <typename Num>
@@ -21,6 +21,8 @@ std::ostream &dstringt::operator<<(std::ostream &out) const
 dstringt get_dstring_number(std::size_t value)
 {
   static const dstringt *const dstring_numbers = [] {
+    // these are kept forever, hence must not have provisional numbers
+    const deferred_interningt intern_now(nullptr);
     dstringt *array = new dstringt[DSTRING_NUMBERS_MAX + 1];
     for(std::size_t i = 0; i <= DSTRING_NUMBERS_MAX; i++)
       array[i] = dstringt(std::to_string(i));
@@ -55,6 +55,15 @@ const irept &get_nil_irep()
   return nil_rep_storage;
 }
 
+unsigned irep_concurrency_scopet::active_scopes = 0;
+
+irep_concurrency_scopet::irep_concurrency_scopet()
+{
+  // initialize the nil irep before any threads may race to do so
+  get_nil_irep();
+  ++active_scopes;
+}
+
 void irept::move_to_named_sub(const irep_namet &name, irept &irep)
 {
   #ifdef SHARING
@@ -224,6 +233,7 @@ irept &irept::add(const irep_namet &name, irept irep)
 #ifdef IREP_HASH_STATS
 unsigned long long irep_cmp_cnt=0;
 unsigned long long irep_cmp_ne_cnt=0;
+unsigned long long irep_cmp_hash_ne_cnt = 0;
 #endif
 
 bool irept::operator==(const irept &other) const
@@ -236,6 +246,19 @@ bool irept::operator==(const irept &other) const
     return true;
   #endif
 
+#ifdef HASH_CODE
+  if(
+    has_cached_hash() && other.has_cached_hash() &&
+    read().hash_code != other.read().hash_code)
+  {
+#  ifdef IREP_HASH_STATS
+    ++irep_cmp_ne_cnt;
+    ++irep_cmp_hash_ne_cnt;
+#  endif
+    return false;
+  }
+#endif
+
   if(id() != other.id() || get_sub() != other.get_sub()) // recursive call
   {
     #ifdef IREP_HASH_STATS
@@ -504,6 +527,7 @@ bool irept::operator<(const irept &other) const
 
 #ifdef IREP_HASH_STATS
 unsigned long long irep_hash_cnt=0;
+unsigned long long irep_hash_cache_hit_cnt = 0;
 #endif
 
 std::size_t irept::number_of_non_comments(const named_subt &named_sub)
@@ -519,10 +543,15 @@ std::size_t irept::number_of_non_comments(const named_subt &named_sub)
 
 std::size_t irept::hash() const
 {
-  #ifdef HASH_CODE
-  if(read().hash_code!=0)
+#ifdef HASH_CODE
+  if(has_cached_hash())
+  {
+#  ifdef IREP_HASH_STATS
+    ++irep_hash_cache_hit_cnt;
+#  endif
     return read().hash_code;
-  #endif
+  }
+#endif
 
   const irept::subt &sub=get_sub();
   const irept::named_subt &named_sub=get_named_sub();
@@ -544,7 +573,8 @@ std::size_t irept::hash() const
   result = hash_finalize(result, sub.size() + number_of_named_ireps);
 
 #ifdef HASH_CODE
-  read().hash_code=result;
+  if(may_cache_hash())
+    read().hash_code = result;
 #endif
 #ifdef IREP_HASH_STATS
   ++irep_hash_cnt;
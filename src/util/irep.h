@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_IREP_H
 #define CPROVER_UTIL_IREP_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -17,7 +18,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "irep_ids.h"
 
 #define SHARING
-// #define HASH_CODE
+#define HASH_CODE
+#define POOL_ALLOCATED_NODES
 // #define NAMED_SUB_IS_FORWARD_LIST
 
 #ifdef NAMED_SUB_IS_FORWARD_LIST
@@ -26,6 +28,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #endif
 
+#ifdef POOL_ALLOCATED_NODES
+#include "pool_allocator.h"
+#endif
+
 #ifdef USE_DSTRING
 typedef dstringt irep_idt;
 typedef dstringt irep_namet;
@@ -80,6 +86,35 @@ inline const std::string &name2string(const irep_namet &n)
 class irept;
 const irept &get_nil_irep();
 
+/// While an object of this class exists, ireps may be shared between threads:
+/// reference counts are then updated atomically, and hash codes are neither
+/// cached in nor taken from nodes. Outside of such scopes reference counts are
+/// updated with plain loads and stores, which is considerably cheaper.
+/// Objects of this class must only be created and destroyed while no other
+/// thread uses ireps, that is, just before starting and after joining the
+/// threads that share them.
+class irep_concurrency_scopet
+{
+public:
+  irep_concurrency_scopet();
+
+  ~irep_concurrency_scopet()
+  {
+    --active_scopes;
+  }
+
+  irep_concurrency_scopet(const irep_concurrency_scopet &) = delete;
+  irep_concurrency_scopet &operator=(const irep_concurrency_scopet &) = delete;
+
+  static bool is_active()
+  {
+    return active_scopes != 0;
+  }
+
+private:
+  static unsigned active_scopes;
+};
+
 /// Used in tree_nodet for activating or not reference counting.
 /// tree_nodet uses inheritance from ref_count_ift instead of a field, so that
 /// it gets deleted if empty ([[no_unique_address]] only appears in C++20).
@@ -91,7 +126,51 @@ struct ref_count_ift
 template <>
 struct ref_count_ift<true>
 {
-  unsigned ref_count = 1;
+  ref_count_ift() = default;
+
+  // a copy of a node is not shared (yet)
+  ref_count_ift(const ref_count_ift &)
+  {
+  }
+
+  ref_count_ift &operator=(const ref_count_ift &)
+  {
+    return *this;
+  }
+
+  unsigned get_ref_count() const
+  {
+    return ref_count.load(std::memory_order_acquire);
+  }
+
+  void increment_ref_count()
+  {
+    if(irep_concurrency_scopet::is_active())
+      ref_count.fetch_add(1, std::memory_order_relaxed);
+    else
+      ref_count.store(
+        ref_count.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+  }
+
+  /// \return the reference count after decrementing it
+  unsigned decrement_ref_count()
+  {
+    if(irep_concurrency_scopet::is_active())
+      return ref_count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+    const unsigned result = ref_count.load(std::memory_order_relaxed) - 1;
+    ref_count.store(result, std::memory_order_relaxed);
+    return result;
+  }
+
+  void reset_ref_count()
+  {
+    ref_count.store(1, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<unsigned> ref_count{1};
 };
 
 /// A node with data in a tree, it contains:
@@ -112,7 +191,12 @@ struct ref_count_ift<true>
 ///   of references to a node.
 ///
 /// * \c hash_code : if HASH_CODE is activated, this is used to cache the
-///   result of the hash function.
+///   result of the hash function. The cached value is reset whenever the
+///   node is written to or ceases to be shared, and is only stored and used
+///   while the node is shared (see \ref sharing_treet::may_cache_hash).
+///
+/// If POOL_ALLOCATED_NODES is activated, nodes are allocated using
+/// \ref pool_allocatort rather than individually by the system allocator.
 template <typename treet, bool sharing = true>
 class tree_nodet : public ref_count_ift<sharing>
 {
@@ -174,6 +258,19 @@ public:
       sub(std::move(_sub))
   {
   }
+
+#ifdef POOL_ALLOCATED_NODES
+  static void *operator new(std::size_t size)
+  {
+    PRECONDITION(size == sizeof(tree_nodet));
+    return pool_allocatort<tree_nodet>::allocate();
+  }
+
+  static void operator delete(void *ptr)
+  {
+    pool_allocatort<tree_nodet>::deallocate(ptr);
+  }
+#endif
 };
 
 /// Base class for tree-like data structures with sharing
@@ -207,10 +304,10 @@ public:
   {
     if(data!=&empty_d)
     {
-      PRECONDITION(data->ref_count != 0);
-      data->ref_count++;
+      PRECONDITION(data->get_ref_count() != 0);
+      data->increment_ref_count();
 #ifdef IREP_DEBUG
-      std::cout << "COPY " << data << " " << data->ref_count << '\n';
+      std::cout << "COPY " << data << " " << data->get_ref_count() << '\n';
 #endif
     }
   }
@@ -236,7 +333,7 @@ public:
     // Consider self-assignment, which may destroy 'irep'
     dt *irep_data=irep.data;
     if(irep_data!=&empty_d)
-      irep_data->ref_count++;
+      irep_data->increment_ref_count();
 
     remove_ref(data); // this may kill 'irep'
     data=irep_data;
@@ -283,6 +380,27 @@ public:
 #endif
     return *data;
   }
+
+protected:
+#ifdef HASH_CODE
+  /// Hash codes are only cached in shared nodes: a shared node cannot be
+  /// written to without detaching it first, whereas an unshared node may also
+  /// be modified via references obtained earlier (see \ref irept::get_sub),
+  /// which would leave a stale hash code in its parent. The cache is reset
+  /// when a node ceases to be shared (see \ref remove_ref). Hash codes are
+  /// not cached while ireps may be shared between threads, as threads could
+  /// otherwise race to fill the cache of a shared node.
+  bool may_cache_hash() const
+  {
+    return !irep_concurrency_scopet::is_active() &&
+           data->get_ref_count() > 1;
+  }
+
+  bool has_cached_hash() const
+  {
+    return may_cache_hash() && data->hash_code != 0;
+  }
+#endif
 };
 
 // Static field initialization
@@ -327,6 +445,20 @@ public:
 
 protected:
   dt data;
+
+#ifdef HASH_CODE
+  /// Without sharing there is no way of telling whether a node was modified
+  /// via a reference obtained before its hash code was computed.
+  bool may_cache_hash() const
+  {
+    return false;
+  }
+
+  bool has_cached_hash() const
+  {
+    return false;
+  }
+#endif
 };
 
 /// There are a large number of kinds of tree structured or tree-like data in
@@ -545,7 +677,7 @@ void sharing_treet<derivedt>::detach()
     std::cout << "ALLOCATED " << data << '\n';
 #endif
   }
-  else if(data->ref_count > 1)
+  else if(data->get_ref_count() > 1)
   {
     dt *old_data(data);
     data = new dt(*old_data);
@@ -554,11 +686,11 @@ void sharing_treet<derivedt>::detach()
     std::cout << "ALLOCATED " << data << '\n';
 #endif
 
-    data->ref_count = 1;
+    data->reset_ref_count();
     remove_ref(old_data);
   }
 
-  POSTCONDITION(data->ref_count == 1);
+  POSTCONDITION(data->get_ref_count() == 1);
 
 #ifdef IREP_DEBUG
   std::cout << "DETACH2: " << data << '\n';
@@ -575,14 +707,14 @@ void sharing_treet<derivedt>::remove_ref(dt *old_data)
     nonrecursive_destructor(old_data);
 #else
 
-  PRECONDITION(old_data->ref_count != 0);
+  PRECONDITION(old_data->get_ref_count() != 0);
 
 #ifdef IREP_DEBUG
-  std::cout << "R: " << old_data << " " << old_data->ref_count << '\n';
+  std::cout << "R: " << old_data << " " << old_data->get_ref_count() << '\n';
 #endif
 
-  old_data->ref_count--;
-  if(old_data->ref_count == 0)
+  const unsigned ref_count = old_data->decrement_ref_count();
+  if(ref_count == 0)
   {
 #ifdef IREP_DEBUG
     std::cout << "D: " << pretty() << '\n';
@@ -598,6 +730,14 @@ void sharing_treet<derivedt>::remove_ref(dt *old_data)
     std::cout << "DONE\n";
 #endif
   }
+#ifdef HASH_CODE
+  else if(ref_count == 1 && !irep_concurrency_scopet::is_active())
+  {
+    // The remaining owner may modify the node via references it obtained
+    // before the node was shared.
+    old_data->hash_code = 0;
+  }
+#endif
 #endif
 }
 
@@ -615,10 +755,10 @@ void sharing_treet<derivedt>::nonrecursive_destructor(dt *old_data)
     if(d == &empty_d)
       continue;
 
-    INVARIANT(d->ref_count != 0, "All contents of the stack must be in use");
-    d->ref_count--;
+    INVARIANT(
+      d->get_ref_count() != 0, "All contents of the stack must be in use");
 
-    if(d->ref_count == 0)
+    if(d->decrement_ref_count() == 0)
     {
       stack.reserve(
         stack.size() + std::distance(d->named_sub.begin(), d->named_sub.end()) +
@@ -28,6 +28,7 @@ public:
 
   void clear()
   {
+    ptr_hash.clear();
     numbering.clear();
   }
 
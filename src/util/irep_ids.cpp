@@ -52,9 +52,12 @@ enum class idt:unsigned
 #include "irep_ids.def" // NOLINT(build/include)
 
 string_containert::string_containert()
+  : segments(),
+    number_of_strings(0),
+    next_provisional_number(first_provisional_number)
 {
   // pre-allocate empty string -- this gets index 0
-  get("");
+  operator[]("");
 
   // allocate strings
   for(unsigned i=0; irep_ids_table[i]!=nullptr; i++)
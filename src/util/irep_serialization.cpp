@@ -204,6 +204,9 @@ irep_idt irep_serializationt::read_gb_string(std::istream &in)
 
   while((c=static_cast<char>(in.get()))!=0)
   {
+    if(in.eof())
+      throw deserialization_exceptiont("unexpected end of input stream");
+
     if(length>=read_buffer.size())
       read_buffer.resize(read_buffer.size()*2, 0);
 
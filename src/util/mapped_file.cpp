@@ -0,0 +1,136 @@
+/*******************************************************************\
+
+Module: Read-only memory-mapped files
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Read-only memory-mapped files
+
+#include "mapped_file.h"
+
+#include "exception_utils.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__) || \
+    defined(__FreeBSD_kernel__) || \
+    defined(__GNU__) || \
+    defined(__unix__) || \
+    defined(__CYGWIN__) || \
+    defined(__MACH__)
+#define MAPPED_FILE_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#include "unicode.h"
+#endif
+
+mapped_filet::mapped_filet(const std::string &filename)
+{
+#ifdef MAPPED_FILE_USE_MMAP
+  const int fd = open(filename.c_str(), O_RDONLY);
+
+  if(fd == -1)
+  {
+    throw system_exceptiont(
+      "failed to open `" + filename + "': " + std::strerror(errno));
+  }
+
+  struct stat st;
+
+  if(fstat(fd, &st) != 0)
+  {
+    const int error = errno;
+    close(fd);
+    throw system_exceptiont(
+      "failed to stat `" + filename + "': " + std::strerror(error));
+  }
+
+  length = static_cast<std::size_t>(st.st_size);
+
+  // mmap does not support empty mappings
+  if(length != 0)
+  {
+    void *p = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    if(p == MAP_FAILED)
+    {
+      const int error = errno;
+      close(fd);
+      throw system_exceptiont(
+        "failed to map `" + filename + "': " + std::strerror(error));
+    }
+
+    contents = static_cast<const char *>(p);
+    is_mapped = true;
+  }
+
+  // the mapping remains valid after closing the file
+  close(fd);
+#else
+#ifdef _MSC_VER
+  std::ifstream in(widen(filename), std::ios::binary);
+#else
+  std::ifstream in(filename, std::ios::binary);
+#endif
+
+  if(!in)
+    throw system_exceptiont("failed to open `" + filename + "'");
+
+  buffer.assign(
+    std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+  contents = buffer.data();
+  length = buffer.size();
+#endif
+}
+
+mapped_filet::mapped_filet(mapped_filet &&other)
+{
+  *this = std::move(other);
+}
+
+mapped_filet &mapped_filet::operator=(mapped_filet &&other)
+{
+  if(this != &other)
+  {
+    release();
+
+    contents = other.contents;
+    length = other.length;
+    is_mapped = other.is_mapped;
+    buffer = std::move(other.buffer);
+
+    other.contents = nullptr;
+    other.length = 0;
+    other.is_mapped = false;
+  }
+
+  return *this;
+}
+
+mapped_filet::~mapped_filet()
+{
+  release();
+}
+
+void mapped_filet::release()
+{
+#ifdef MAPPED_FILE_USE_MMAP
+  if(is_mapped)
+    munmap(const_cast<char *>(contents), length);
+#endif
+
+  contents = nullptr;
+  length = 0;
+  is_mapped = false;
+  buffer.clear();
+}
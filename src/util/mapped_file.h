@@ -0,0 +1,68 @@
+/*******************************************************************\
+
+Module: Read-only memory-mapped files
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Read-only memory-mapped files
+
+#ifndef CPROVER_UTIL_MAPPED_FILE_H
+#define CPROVER_UTIL_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// The contents of a file, mapped into memory for reading. Pages are loaded
+/// by the operating system only when they are accessed, which makes this
+/// suitable for large files of which only parts are needed. On platforms
+/// without `mmap` the contents are read into memory instead.
+class mapped_filet
+{
+public:
+  mapped_filet() = default;
+
+  /// Map the file \p filename into memory. Throws a `system_exceptiont` if the
+  /// file cannot be opened or mapped.
+  explicit mapped_filet(const std::string &filename);
+
+  mapped_filet(const mapped_filet &) = delete;
+  mapped_filet &operator=(const mapped_filet &) = delete;
+
+  mapped_filet(mapped_filet &&other);
+  mapped_filet &operator=(mapped_filet &&other);
+
+  ~mapped_filet();
+
+  const char *data() const
+  {
+    return contents;
+  }
+
+  std::size_t size() const
+  {
+    return length;
+  }
+
+  bool empty() const
+  {
+    return length == 0;
+  }
+
+protected:
+  const char *contents = nullptr;
+  std::size_t length = 0;
+
+  /// true if \ref contents points to a mapping that needs to be unmapped
+  bool is_mapped = false;
+
+  /// storage for the file contents if the file could not be mapped
+  std::vector<char> buffer;
+
+  void release();
+};
+
+#endif // CPROVER_UTIL_MAPPED_FILE_H
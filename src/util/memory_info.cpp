@@ -12,10 +12,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <mach/task.h>
 #include <mach/mach_init.h>
 #include <malloc/malloc.h>
+#include <sys/resource.h>
 #endif
 
 #ifdef __linux__
+#include <fstream>
 #include <malloc.h>
+#include <string>
 #endif
 
 #ifdef _WIN32
@@ -72,3 +75,70 @@ void memory_info(std::ostream &out)
       << static_cast<double>(t.size_allocated)/1000000 << "m\n";
 #endif
 }
+
+#ifdef __linux__
+/// \return the value in kilobytes of the field \p field of
+///   /proc/self/status, converted to bytes, or zero if not available
+static std::size_t proc_status_bytes(const std::string &field)
+{
+  std::ifstream status("/proc/self/status");
+  std::string line;
+
+  while(std::getline(status, line))
+  {
+    if(line.compare(0, field.size(), field) == 0)
+      return std::stoull(line.substr(field.size())) * 1024;
+  }
+
+  return 0;
+}
+#endif
+
+memory_usaget get_memory_usage()
+{
+  memory_usaget usage;
+
+#if defined(__linux__)
+  usage.resident = proc_status_bytes("VmRSS:");
+  usage.peak_resident = proc_status_bytes("VmHWM:");
+#  if defined(__GLIBC__)
+#    if __GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct mallinfo2 m = mallinfo2();
+  usage.heap_in_use = m.uordblks + m.hblkhd;
+#    else
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct mallinfo m = mallinfo();
+  // the fields are int and wrap around beyond 2 GB
+  usage.heap_in_use =
+    static_cast<unsigned>(m.uordblks) + static_cast<unsigned>(m.hblkhd);
+#    endif
+#  endif
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+  {
+    usage.resident = pmc.WorkingSetSize;
+    usage.peak_resident = pmc.PeakWorkingSetSize;
+    usage.heap_in_use = pmc.PagefileUsage;
+  }
+#elif defined(__APPLE__)
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct task_basic_info t_info;
+  mach_msg_type_number_t t_info_count = TASK_BASIC_INFO_COUNT;
+  task_info(
+    current_task(), TASK_BASIC_INFO, (task_info_t)&t_info, &t_info_count);
+  usage.resident = t_info.resident_size;
+
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct rusage r_usage;
+  if(getrusage(RUSAGE_SELF, &r_usage) == 0)
+    usage.peak_resident = r_usage.ru_maxrss; // in bytes on macOS
+
+  malloc_statistics_t t;
+  malloc_zone_statistics(NULL, &t);
+  usage.heap_in_use = t.size_in_use;
+#endif
+
+  return usage;
+}
@@ -10,8 +10,23 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_MEMORY_INFO_H
 #define CPROVER_UTIL_MEMORY_INFO_H
 
+#include <cstddef>
 #include <iosfwd>
 
 void memory_info(std::ostream &);
 
+/// Memory used by the process, in bytes. Values that cannot be determined on
+/// the current platform are zero.
+struct memory_usaget
+{
+  /// Resident set size (working set size on Windows)
+  std::size_t resident = 0;
+  /// Largest resident set size so far
+  std::size_t peak_resident = 0;
+  /// Bytes handed out by malloc and not yet freed
+  std::size_t heap_in_use = 0;
+};
+
+memory_usaget get_memory_usage();
+
 #endif // CPROVER_UTIL_MEMORY_INFO_H
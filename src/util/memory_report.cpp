@@ -0,0 +1,104 @@
+/*******************************************************************\
+
+Module: Memory Report
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Memory usage per phase and sizes of major data structures
+
+#include "memory_report.h"
+
+#include <algorithm>
+
+#include "irep.h"
+#include "json.h"
+
+/// \return the number of irep nodes that the pool has allocated from the
+///   system, which bounds the number of nodes alive at any time, or zero if
+///   not known. Nodes are not counted individually, which would cost an
+///   atomic operation per node allocation.
+static std::size_t irep_node_capacity()
+{
+#ifdef POOL_ALLOCATED_NODES
+  return pool_allocatort<irept::dt>::capacity();
+#else
+  return 0;
+#endif
+}
+
+static json_numbert json_number(std::size_t n)
+{
+  return json_numbert(std::to_string(n));
+}
+
+static json_objectt to_json(const memory_usaget &usage)
+{
+  return json_objectt{{"residentBytes", json_number(usage.resident)},
+                      {"peakResidentBytes", json_number(usage.peak_resident)},
+                      {"heapBytesInUse", json_number(usage.heap_in_use)}};
+}
+
+void memory_reportt::snapshot(const std::string &phase)
+{
+  if(!is_enabled())
+    return;
+
+  const memory_usaget usage = get_memory_usage();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  snapshots.push_back({phase, usage, irep_node_capacity()});
+}
+
+void memory_reportt::record_size(const std::string &structure, std::size_t size)
+{
+  if(!is_enabled())
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto entry = sizes.insert({structure, {size, size}});
+  if(!entry.second)
+  {
+    entry.first->second.latest = size;
+    entry.first->second.largest = std::max(entry.first->second.largest, size);
+  }
+}
+
+json_objectt memory_reportt::to_json() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  json_arrayt json_phases;
+  for(const auto &snapshot : snapshots)
+  {
+    json_objectt json_snapshot = ::to_json(snapshot.usage);
+    json_snapshot["phase"] = json_stringt(snapshot.phase);
+    json_snapshot["irepNodeCapacity"] =
+      json_number(snapshot.irep_node_capacity);
+    json_phases.push_back(std::move(json_snapshot));
+  }
+
+  json_objectt json_structures;
+  for(const auto &size : sizes)
+  {
+    json_structures[size.first] =
+      json_objectt{{"latest", json_number(size.second.latest)},
+                   {"largest", json_number(size.second.largest)}};
+  }
+
+  json_objectt json_exit = ::to_json(get_memory_usage());
+  json_exit["irepNodeCapacity"] = json_number(irep_node_capacity());
+
+  return json_objectt{{"phases", std::move(json_phases)},
+                      {"structures", std::move(json_structures)},
+                      {"exit", std::move(json_exit)}};
+}
+
+memory_reportt &memory_report()
+{
+  static memory_reportt report;
+  return report;
+}
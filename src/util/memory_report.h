@@ -0,0 +1,87 @@
+/*******************************************************************\
+
+Module: Memory Report
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Memory usage per phase and sizes of major data structures
+
+#ifndef CPROVER_UTIL_MEMORY_REPORT_H
+#define CPROVER_UTIL_MEMORY_REPORT_H
+
+#define OPT_MEMORY_REPORT "(memory-report)"
+
+#define HELP_MEMORY_REPORT                                                     \
+  " --memory-report              print memory usage after each phase and\n"   \
+  "                              sizes of major data structures as JSON at\n" \
+  "                              exit\n"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "memory_info.h"
+
+class json_objectt;
+
+/// Collects the memory usage of the process at the end of each phase of a
+/// run, together with the sizes of major data structures such as the number
+/// of SSA steps or SAT clauses, which helps to attribute memory to phases.
+/// Nothing is recorded unless the report has been enabled; callers can thus
+/// unconditionally call \ref snapshot and \ref record_size.
+class memory_reportt
+{
+public:
+  bool is_enabled() const
+  {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  void enable()
+  {
+    enabled.store(true, std::memory_order_relaxed);
+  }
+
+  /// Record the memory usage of the process at the end of phase \p phase
+  void snapshot(const std::string &phase);
+
+  /// Record that the data structure \p structure currently has \p size
+  /// elements. The latest and the largest size are reported.
+  void record_size(const std::string &structure, std::size_t size);
+
+  /// \return an object with members "phases", an array of the snapshots in
+  ///   the order they were taken, "structures", mapping the names of data
+  ///   structures to their latest and largest sizes, and "exit", the memory
+  ///   usage at the time of the call
+  json_objectt to_json() const;
+
+private:
+  std::atomic<bool> enabled{false};
+
+  struct snapshott
+  {
+    std::string phase;
+    memory_usaget usage;
+    std::size_t irep_node_capacity;
+  };
+
+  struct sizet
+  {
+    std::size_t latest;
+    std::size_t largest;
+  };
+
+  mutable std::mutex mutex;
+  std::vector<snapshott> snapshots;
+  std::map<std::string, sizet> sizes;
+};
+
+/// \return the process-wide memory report
+memory_reportt &memory_report();
+
+#endif // CPROVER_UTIL_MEMORY_REPORT_H
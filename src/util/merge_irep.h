@@ -107,6 +107,19 @@ class merge_irept
 public:
   void operator()(irept &);
 
+  /// Number of distinct nodes held by this store
+  std::size_t size() const
+  {
+    return irep_store.size();
+  }
+
+  /// Drop all nodes held by this store; ireps merged before remain valid,
+  /// but will no longer be shared with ireps merged afterwards
+  void clear()
+  {
+    irep_store.clear();
+  }
+
 protected:
   typedef std::unordered_set<irept, irep_hash> irep_storet;
   irep_storet irep_store;
@@ -126,4 +139,55 @@ protected:
   const irept &merged(const irept &irep);
 };
 
+/// Process-wide unique table for hash-consing ireps. Once enabled, all ireps
+/// passed through it share their nodes with every structurally equal irep
+/// (ignoring comments) previously passed through it, by whichever client.
+/// Comparing two such ireps using \ref irept::operator== is then decided by
+/// the pointer comparison it performs first whenever they are equal.
+class hash_consing_irept
+{
+public:
+  /// Replace \p irep by the shared instance from the unique table, or do
+  /// nothing when hash-consing has not been enabled.
+  void operator()(irept &irep)
+  {
+    if(enabled)
+      merge(irep);
+  }
+
+  bool is_enabled() const
+  {
+    return enabled;
+  }
+
+  void enable()
+  {
+    enabled = true;
+  }
+
+  /// Disable hash-consing and release all nodes held by the unique table
+  void disable()
+  {
+    enabled = false;
+    merge.clear();
+  }
+
+  /// Number of distinct nodes in the unique table
+  std::size_t size() const
+  {
+    return merge.size();
+  }
+
+protected:
+  bool enabled = false;
+  merge_irept merge;
+};
+
+/// Get a reference to the global hash-consing unique table.
+inline hash_consing_irept &get_hash_consing_irep()
+{
+  static hash_consing_irept ret;
+  return ret;
+}
+
 #endif // CPROVER_UTIL_MERGE_IREP_H
@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "json.h"
 #include "string2int.h"
+#include "xml.h"
 
 void message_handlert::print(
   unsigned level,
@@ -65,6 +66,87 @@ void message_handlert::print(
   ++message_count[level];
 }
 
+void buffered_message_handlert::print(
+  unsigned level,
+  const std::string &message)
+{
+  message_handlert::print(level, message);
+  messages.push_back([level, message](message_handlert &message_handler) {
+    message_handler.print(level, message);
+  });
+}
+
+void buffered_message_handlert::print(unsigned level, const xmlt &xml)
+{
+  messages.push_back([level, xml](message_handlert &message_handler) {
+    message_handler.print(level, xml);
+  });
+}
+
+void buffered_message_handlert::print(unsigned level, const jsont &json)
+{
+  messages.push_back([level, json](message_handlert &message_handler) {
+    message_handler.print(level, json);
+  });
+}
+
+void buffered_message_handlert::print(
+  unsigned level,
+  const std::string &message,
+  const source_locationt &location)
+{
+  message_handlert::print(level, message);
+  messages.push_back(
+    [level, message, location](message_handlert &message_handler) {
+      message_handler.print(level, message, location);
+    });
+}
+
+void buffered_message_handlert::replay(message_handlert &message_handler)
+{
+  for(const auto &message : messages)
+    message(message_handler);
+
+  messages.clear();
+}
+
+void synchronized_message_handlert::print(
+  unsigned level,
+  const std::string &message)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  message_handlert::print(level, message);
+  target.print(level, message);
+}
+
+void synchronized_message_handlert::print(unsigned level, const xmlt &xml)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  target.print(level, xml);
+}
+
+void synchronized_message_handlert::print(unsigned level, const jsont &json)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  target.print(level, json);
+}
+
+void synchronized_message_handlert::print(
+  unsigned level,
+  const std::string &message,
+  const source_locationt &location)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  message_handlert::print(level, message);
+  target.print(level, message, location);
+}
+
+void synchronized_message_handlert::flush(unsigned level)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  target.flush(level);
+}
+
 messaget::~messaget()
 {
 }
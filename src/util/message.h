@@ -12,8 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <functional>
 #include <iosfwd>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "deprecate.h"
 #include "invariant.h"
@@ -136,6 +138,71 @@ protected:
   std::ostream &out;
 };
 
+/// Records messages so that they can be passed on to another message handler
+/// later, for example to report the messages produced by several threads in
+/// a deterministic order once all threads have finished.
+class buffered_message_handlert : public message_handlert
+{
+public:
+  /// \param target: the message handler the messages are meant for, whose
+  ///   verbosity is adopted
+  explicit buffered_message_handlert(const message_handlert &target)
+  {
+    verbosity = target.get_verbosity();
+  }
+
+  void print(unsigned level, const std::string &message) override;
+  void print(unsigned level, const xmlt &xml) override;
+  void print(unsigned level, const jsont &json) override;
+  void print(
+    unsigned level,
+    const std::string &message,
+    const source_locationt &location) override;
+
+  void flush(unsigned) override
+  {
+  }
+
+  /// Pass on all messages recorded so far to \p message_handler, in the
+  /// order they were recorded, and forget them
+  void replay(message_handlert &message_handler);
+
+private:
+  std::vector<std::function<void(message_handlert &)>> messages;
+};
+
+/// Passes messages on to another message handler one at a time, so that
+/// several threads can print messages through it concurrently
+class synchronized_message_handlert : public message_handlert
+{
+public:
+  /// \param target: the message handler to pass the messages on to, whose
+  ///   verbosity is adopted
+  explicit synchronized_message_handlert(message_handlert &target)
+    : target(target)
+  {
+    verbosity = target.get_verbosity();
+  }
+
+  void print(unsigned level, const std::string &message) override;
+  void print(unsigned level, const xmlt &xml) override;
+  void print(unsigned level, const jsont &json) override;
+  void print(
+    unsigned level,
+    const std::string &message,
+    const source_locationt &location) override;
+  void flush(unsigned level) override;
+
+  std::string command(unsigned c) const override
+  {
+    return target.command(c);
+  }
+
+private:
+  message_handlert &target;
+  std::mutex mutex;
+};
+
 /// \brief Class that provides messages with a built-in verbosity 'level'.
 /// These messages are then processed by a subclass of \ref message_handlert -
 /// which filters out all messages above a set verbosity level. By default the
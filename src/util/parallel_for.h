@@ -0,0 +1,101 @@
+/*******************************************************************\
+
+Module: Parallel Loops
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Run independent iterations of a loop in several threads
+
+#ifndef CPROVER_UTIL_PARALLEL_FOR_H
+#define CPROVER_UTIL_PARALLEL_FOR_H
+
+#define OPT_JOBS "(jobs):"
+
+#define HELP_JOBS                                                              \
+  " --jobs N                     use up to N threads to link goto binaries,\n" \
+  "                              to convert functions to goto programs and\n"  \
+  "                              to run passes that transform each function\n" \
+  "                              separately and to check goto programs with\n"  \
+  "                              --validate-goto-model (default: 1)\n"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "irep.h"
+
+/// Call \p f(i) for each i from 0 to \p n - 1, using up to \p jobs threads,
+/// including the calling thread. Threads take the next index that has not
+/// been handed out yet, which balances the load when calls take very
+/// different amounts of time. The calls may share ireps (see
+/// \ref irep_concurrency_scopet), but must not otherwise modify state that is
+/// shared between them. This function must not be called from within one of
+/// the calls.
+/// If any call throws, no further indices are handed out and, once all
+/// threads have finished, the exception thrown by the call for the smallest
+/// index is rethrown. As indices are handed out in increasing order, this is
+/// the exception a sequential loop would have thrown.
+/// \param n: number of iterations
+/// \param jobs: maximum number of threads to use; with one or zero jobs, all
+///   calls are made by the calling thread, in order of increasing index
+/// \param f: function taking an index of type std::size_t
+template <typename functiont>
+void parallel_for(std::size_t n, std::size_t jobs, functiont f)
+{
+  if(jobs <= 1 || n <= 1)
+  {
+    for(std::size_t i = 0; i < n; ++i)
+      f(i);
+    return;
+  }
+
+  std::atomic<std::size_t> next_index{0};
+  std::atomic<bool> failed{false};
+  std::vector<std::exception_ptr> exceptions(n);
+
+  auto worker = [&]() {
+    while(!failed.load(std::memory_order_relaxed))
+    {
+      const std::size_t i = next_index.fetch_add(1, std::memory_order_relaxed);
+      if(i >= n)
+        return;
+
+      try
+      {
+        f(i);
+      }
+      catch(...)
+      {
+        exceptions[i] = std::current_exception();
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  {
+    irep_concurrency_scopet concurrency_scope;
+
+    std::vector<std::thread> threads;
+    const std::size_t number_of_threads = std::min(jobs, n);
+    for(std::size_t t = 1; t < number_of_threads; ++t)
+      threads.emplace_back(worker);
+
+    worker();
+
+    for(auto &thread : threads)
+      thread.join();
+  }
+
+  for(const auto &exception : exceptions)
+  {
+    if(exception)
+      std::rethrow_exception(exception);
+  }
+}
+
+#endif // CPROVER_UTIL_PARALLEL_FOR_H
@@ -22,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "cmdline.h"
 #include "exception_utils.h"
 #include "exit_codes.h"
+#include "run_reports.h"
 #include "signal_catcher.h"
 
 parse_options_baset::parse_options_baset(
@@ -78,7 +79,17 @@ int parse_options_baset::main()
     // install signal catcher
     install_signal_catcher();
 
-    return doit();
+    start_run_reports(cmdline);
+
+    int exit_code;
+    {
+      trace_spant span("run");
+      exit_code = doit();
+    }
+
+    finish_run_reports(cmdline, ui_message_handler);
+
+    return exit_code;
   }
 
   // CPROVER style exceptions in order of decreasing happiness
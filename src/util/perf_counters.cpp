@@ -0,0 +1,68 @@
+/*******************************************************************\
+
+Module: Performance Counters
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Registry of named performance counters and timers
+
+#include "perf_counters.h"
+
+#include "json.h"
+
+perf_countert &perf_counterst::counter(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return counters[name];
+}
+
+perf_timert &perf_counterst::timer(const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return timers[name];
+}
+
+void perf_counterst::reset()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  for(auto &counter : counters)
+    counter.second.reset();
+
+  for(auto &timer : timers)
+    timer.second.reset();
+}
+
+json_objectt perf_counterst::to_json() const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  json_objectt json_counters;
+  for(const auto &counter : counters)
+  {
+    json_counters[counter.first] =
+      json_numbert(std::to_string(counter.second.get()));
+  }
+
+  json_objectt json_timers;
+  for(const auto &timer : timers)
+  {
+    json_timers[timer.first] = json_objectt{
+      {"calls", json_numbert(std::to_string(timer.second.get_calls()))},
+      {"seconds", json_numbert(std::to_string(timer.second.get_seconds()))}};
+  }
+
+  return json_objectt{{"counters", std::move(json_counters)},
+                      {"timers", std::move(json_timers)}};
+}
+
+std::atomic<bool> perf_counters_enabled_flag{false};
+
+perf_counterst &perf_counters()
+{
+  static perf_counterst registry;
+  return registry;
+}
@@ -0,0 +1,202 @@
+/*******************************************************************\
+
+Module: Performance Counters
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Registry of named performance counters and timers
+
+#ifndef CPROVER_UTIL_PERF_COUNTERS_H
+#define CPROVER_UTIL_PERF_COUNTERS_H
+
+#define OPT_PROFILE_REPORT "(profile-report)"
+
+#define HELP_PROFILE_REPORT                                                    \
+  " --profile-report             print performance counters and timers as\n"   \
+  "                              JSON at exit\n"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+class json_objectt;
+
+/// A counter that can be incremented concurrently
+class perf_countert
+{
+public:
+  void add(std::size_t n)
+  {
+    value.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  std::size_t get() const
+  {
+    return value.load(std::memory_order_relaxed);
+  }
+
+  void reset()
+  {
+    value.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::size_t> value{0};
+};
+
+/// Accumulates the time spent in, and the number of entries into, a section
+/// of code
+class perf_timert
+{
+public:
+  void add(std::chrono::steady_clock::duration duration)
+  {
+    nanoseconds.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+      std::memory_order_relaxed);
+    calls.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  double get_seconds() const
+  {
+    return nanoseconds.load(std::memory_order_relaxed) / 1e9;
+  }
+
+  std::uint64_t get_calls() const
+  {
+    return calls.load(std::memory_order_relaxed);
+  }
+
+  void reset()
+  {
+    nanoseconds.store(0, std::memory_order_relaxed);
+    calls.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::uint64_t> nanoseconds{0};
+  std::atomic<std::uint64_t> calls{0};
+};
+
+/// Registry of named counters and timers. Counters and timers are created on
+/// first use and keep their address for the lifetime of the registry, so call
+/// sites may cache references to them.
+class perf_counterst
+{
+public:
+  perf_countert &counter(const std::string &name);
+  perf_timert &timer(const std::string &name);
+
+  /// Reset all counters and timers to zero
+  void reset();
+
+  /// \return an object with members "counters", mapping counter names to
+  ///   their values, and "timers", mapping timer names to objects holding
+  ///   the number of calls and the accumulated time in seconds
+  json_objectt to_json() const;
+
+private:
+  mutable std::mutex mutex;
+  std::map<std::string, perf_countert> counters;
+  std::map<std::string, perf_timert> timers;
+};
+
+/// \return the process-wide registry of performance counters
+perf_counterst &perf_counters();
+
+/// Set once the process-wide registry has been enabled. The flag lives
+/// outside of the registry so that instrumentation sites can test it inline,
+/// which keeps the cost of disabled counters to a single load and branch.
+extern std::atomic<bool> perf_counters_enabled_flag;
+
+/// \return true if the process-wide registry records counters and timers;
+///   instrumentation sites are expected to test this before doing any work
+inline bool perf_counters_enabled()
+{
+  return perf_counters_enabled_flag.load(std::memory_order_relaxed);
+}
+
+/// Make the process-wide registry record counters and timers
+inline void enable_perf_counters()
+{
+  perf_counters_enabled_flag.store(true, std::memory_order_relaxed);
+}
+
+/// Adds the time from construction to destruction to a timer, unless the
+/// timer is null
+class perf_timer_scopet
+{
+public:
+  explicit perf_timer_scopet(perf_timert *_timer) : timer(_timer)
+  {
+    if(timer != nullptr)
+      start = std::chrono::steady_clock::now();
+  }
+
+  ~perf_timer_scopet()
+  {
+    if(timer != nullptr)
+      timer->add(std::chrono::steady_clock::now() - start);
+  }
+
+  perf_timer_scopet(const perf_timer_scopet &) = delete;
+  perf_timer_scopet &operator=(const perf_timer_scopet &) = delete;
+
+private:
+  perf_timert *timer;
+  std::chrono::steady_clock::time_point start;
+};
+
+// The macros below take counter names that are string literals; the counter
+// is looked up once per call site. Use perf_counters().counter(...) directly,
+// guarded by perf_counters_enabled(), for names computed at runtime.
+// Defining CPROVER_NO_PERF_COUNTERS removes all instrumentation.
+
+#ifdef CPROVER_NO_PERF_COUNTERS
+
+#define PERF_COUNT_N(name, n)                                                  \
+  do                                                                           \
+  {                                                                            \
+  } while(false)
+
+#define PERF_TIMER(name)
+
+#else
+
+/// Add \p n to the counter \p name
+#define PERF_COUNT_N(name, n)                                                  \
+  do                                                                           \
+  {                                                                            \
+    if(perf_counters_enabled())                                                \
+    {                                                                          \
+      static perf_countert &perf_counter = perf_counters().counter(name);      \
+      perf_counter.add(n);                                                     \
+    }                                                                          \
+  } while(false)
+
+#define PERF_TIMER_CONCAT_IMPL(a, b) a##b
+#define PERF_TIMER_CONCAT(a, b) PERF_TIMER_CONCAT_IMPL(a, b)
+
+/// Add the time until the end of the enclosing scope to the timer \p name.
+/// The scope object is named after the line so that several timers may be
+/// used in the same scope.
+#define PERF_TIMER(name)                                                       \
+  perf_timer_scopet PERF_TIMER_CONCAT(perf_timer_scope_, __LINE__)(            \
+    perf_counters_enabled() ? []() {                                           \
+      static perf_timert &perf_timer = perf_counters().timer(name);            \
+      return &perf_timer;                                                      \
+    }()                                                                        \
+                            : nullptr)
+
+#endif
+
+/// Increment the counter \p name
+#define PERF_COUNT(name) PERF_COUNT_N(name, 1)
+
+#endif // CPROVER_UTIL_PERF_COUNTERS_H
@@ -0,0 +1,244 @@
+/*******************************************************************\
+
+Module: Pool allocator for fixed-size objects
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Pool allocator for fixed-size objects
+
+#ifndef CPROVER_UTIL_POOL_ALLOCATOR_H
+#define CPROVER_UTIL_POOL_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+//#define _POOL_ALLOCATOR_STATS
+
+/// Allocator for objects of type \p T that carves them out of chunks of
+/// \p chunk_objects objects each. Deallocated objects are kept in a free list
+/// and are handed out again by subsequent allocations, which avoids a call to
+/// the system allocator for each object and keeps objects of the same type
+/// close together in memory. Memory is never returned to the system.
+///
+/// Each thread has its own free list. Objects may be deallocated by a thread
+/// other than the one that allocated them, in which case they are reused by
+/// the deallocating thread. When a thread exits, its free list is handed to a
+/// list shared by all threads, from which threads take objects before
+/// allocating new chunks, so that the objects of short-lived threads are not
+/// lost.
+///
+/// \tparam T: type of the objects to allocate
+/// \tparam chunk_objects: number of objects to allocate from the system at a
+///   time
+template <typename T, std::size_t chunk_objects = 1024>
+class pool_allocatort
+{
+public:
+  static void *allocate()
+  {
+    if(free_list == nullptr)
+      refill();
+
+    slott *slot = free_list;
+    free_list = slot->next;
+
+#ifdef _POOL_ALLOCATOR_STATS
+    ++allocations;
+#endif
+
+    return slot;
+  }
+
+  static void deallocate(void *ptr)
+  {
+    if(free_list == nullptr)
+      register_thread();
+
+    slott *slot = static_cast<slott *>(ptr);
+    slot->next = free_list;
+    free_list = slot;
+
+#ifdef _POOL_ALLOCATOR_STATS
+    ++deallocations;
+#endif
+  }
+
+  /// \return the number of objects that have been allocated from the system
+  ///   by all threads, which bounds the number of objects that have been
+  ///   alive at the same time
+  static std::size_t capacity()
+  {
+    return total_chunks.load(std::memory_order_relaxed) * chunk_objects;
+  }
+
+#ifdef _POOL_ALLOCATOR_STATS
+  static thread_local std::size_t allocations;
+  static thread_local std::size_t deallocations;
+  static thread_local std::size_t chunks;
+#endif
+
+private:
+  union slott {
+    slott *next;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+  };
+
+  static thread_local slott *free_list;
+  static std::atomic<std::size_t> total_chunks;
+
+  /// Free lists of threads that have exited, guarded by \ref shared_mutex
+  static slott *shared_free_list;
+  static std::mutex shared_mutex;
+
+  /// Hands the free list of a thread to \ref shared_free_list when the thread
+  /// exits
+  struct thread_releasert
+  {
+    ~thread_releasert()
+    {
+      if(free_list == nullptr)
+        return;
+
+      slott *last = free_list;
+      while(last->next != nullptr)
+        last = last->next;
+
+      std::lock_guard<std::mutex> lock(shared_mutex);
+      last->next = shared_free_list;
+      shared_free_list = free_list;
+      free_list = nullptr;
+    }
+  };
+
+  /// Make sure the free list of the calling thread is handed on when the
+  /// thread exits. This is called whenever the free list is empty, which is
+  /// the case before a thread first allocates or deallocates objects.
+  static void register_thread()
+  {
+    static thread_local thread_releasert releaser;
+    (void)releaser;
+  }
+
+  static void refill()
+  {
+    register_thread();
+
+    {
+      std::lock_guard<std::mutex> lock(shared_mutex);
+      if(shared_free_list != nullptr)
+      {
+        free_list = shared_free_list;
+        shared_free_list = nullptr;
+        return;
+      }
+    }
+
+    slott *chunk = static_cast<slott *>(
+      ::operator new(sizeof(slott) * chunk_objects));
+
+    for(std::size_t i = 0; i + 1 < chunk_objects; ++i)
+      chunk[i].next = &chunk[i + 1];
+    chunk[chunk_objects - 1].next = free_list;
+
+    free_list = chunk;
+    total_chunks.fetch_add(1, std::memory_order_relaxed);
+
+#ifdef _POOL_ALLOCATOR_STATS
+    ++chunks;
+#endif
+  }
+};
+
+template <typename T, std::size_t chunk_objects>
+thread_local typename pool_allocatort<T, chunk_objects>::slott
+  *pool_allocatort<T, chunk_objects>::free_list = nullptr;
+
+template <typename T, std::size_t chunk_objects>
+std::atomic<std::size_t> pool_allocatort<T, chunk_objects>::total_chunks{0};
+
+template <typename T, std::size_t chunk_objects>
+typename pool_allocatort<T, chunk_objects>::slott
+  *pool_allocatort<T, chunk_objects>::shared_free_list = nullptr;
+
+template <typename T, std::size_t chunk_objects>
+std::mutex pool_allocatort<T, chunk_objects>::shared_mutex;
+
+#ifdef _POOL_ALLOCATOR_STATS
+template <typename T, std::size_t chunk_objects>
+thread_local std::size_t pool_allocatort<T, chunk_objects>::allocations = 0;
+template <typename T, std::size_t chunk_objects>
+thread_local std::size_t pool_allocatort<T, chunk_objects>::deallocations = 0;
+template <typename T, std::size_t chunk_objects>
+thread_local std::size_t pool_allocatort<T, chunk_objects>::chunks = 0;
+#endif
+
+/// Standard-library allocator for node-based containers such as std::list
+/// that takes single objects from a \ref pool_allocatort. The nodes of all
+/// containers of the same type are thus packed into shared chunks, in the
+/// order in which they were created, rather than being interleaved with
+/// unrelated allocations. Requests for more than one object, which
+/// node-based containers do not make, are passed on to the system allocator.
+/// All instances compare equal, so that elements can be spliced between
+/// containers.
+template <typename T, std::size_t chunk_objects = 256>
+class pool_container_allocatort
+{
+public:
+  typedef T value_type;
+  typedef std::true_type is_always_equal;
+  typedef std::true_type propagate_on_container_move_assignment;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef pool_container_allocatort<U, chunk_objects> other;
+  };
+
+  pool_container_allocatort() = default;
+
+  template <typename U>
+  // NOLINTNEXTLINE(runtime/explicit)
+  pool_container_allocatort(const pool_container_allocatort<U, chunk_objects> &)
+  {
+  }
+
+  T *allocate(std::size_t n)
+  {
+    if(n == 1)
+      return static_cast<T *>(pool_allocatort<T, chunk_objects>::allocate());
+
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *ptr, std::size_t n)
+  {
+    if(n == 1)
+      pool_allocatort<T, chunk_objects>::deallocate(ptr);
+    else
+      ::operator delete(ptr);
+  }
+};
+
+template <typename T, typename U, std::size_t chunk_objects>
+bool operator==(
+  const pool_container_allocatort<T, chunk_objects> &,
+  const pool_container_allocatort<U, chunk_objects> &)
+{
+  return true;
+}
+
+template <typename T, typename U, std::size_t chunk_objects>
+bool operator!=(
+  const pool_container_allocatort<T, chunk_objects> &,
+  const pool_container_allocatort<U, chunk_objects> &)
+{
+  return false;
+}
+
+#endif // CPROVER_UTIL_POOL_ALLOCATOR_H
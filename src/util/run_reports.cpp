@@ -0,0 +1,69 @@
+/*******************************************************************\
+
+Module: Run Reports
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Command-line options for the reports about a tool run: performance
+/// counters, the trace timeline and the memory report
+
+#include "run_reports.h"
+
+#include <sstream>
+
+#include "cmdline.h"
+#include "json.h"
+#include "ui_message.h"
+
+void start_run_reports(const cmdlinet &cmdline)
+{
+  if(cmdline.isset("profile-report"))
+    enable_perf_counters();
+
+  if(cmdline.isset("memory-report"))
+    memory_report().enable();
+
+  if(cmdline.isset("trace-timeline"))
+    trace_timeline().open(cmdline.get_value("trace-timeline"));
+}
+
+void finish_run_reports(
+  const cmdlinet &cmdline,
+  ui_message_handlert &ui_message_handler)
+{
+  trace_timeline().close();
+
+  if(cmdline.isset("profile-report"))
+  {
+    output_json_report(
+      ui_message_handler, "profileReport", perf_counters().to_json());
+  }
+
+  if(cmdline.isset("memory-report"))
+  {
+    output_json_report(
+      ui_message_handler, "memoryReport", memory_report().to_json());
+  }
+}
+
+void output_json_report(
+  ui_message_handlert &ui_message_handler,
+  const std::string &key,
+  const json_objectt &report)
+{
+  messaget log(ui_message_handler);
+
+  if(ui_message_handler.get_ui() == ui_message_handlert::uit::JSON_UI)
+  {
+    log.result() << json_objectt{{key, report}};
+  }
+  else
+  {
+    std::ostringstream out;
+    out << report;
+    log.result() << out.str() << messaget::eom;
+  }
+}
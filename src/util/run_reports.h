@@ -0,0 +1,53 @@
+/*******************************************************************\
+
+Module: Run Reports
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Command-line options for the reports about a tool run: performance
+/// counters, the trace timeline and the memory report
+
+#ifndef CPROVER_UTIL_RUN_REPORTS_H
+#define CPROVER_UTIL_RUN_REPORTS_H
+
+#include <string>
+
+#include "memory_report.h"
+#include "perf_counters.h"
+#include "trace_timeline.h"
+
+class cmdlinet;
+class json_objectt;
+class ui_message_handlert;
+
+#define OPT_RUN_REPORTS                                                        \
+  OPT_PROFILE_REPORT                                                           \
+  OPT_TRACE_TIMELINE                                                           \
+  OPT_MEMORY_REPORT
+
+#define HELP_RUN_REPORTS                                                       \
+  HELP_PROFILE_REPORT                                                          \
+  HELP_TRACE_TIMELINE                                                          \
+  HELP_MEMORY_REPORT
+
+/// Enable the process-wide registries of the reports requested in
+/// \p cmdline
+/// \throws system_exceptiont if the trace timeline file cannot be opened
+void start_run_reports(const cmdlinet &cmdline);
+
+/// Close the trace timeline and print the reports requested in \p cmdline
+void finish_run_reports(
+  const cmdlinet &cmdline,
+  ui_message_handlert &ui_message_handler);
+
+/// Print \p report as JSON, either as a JSON message with the single member
+/// \p key when using the JSON user interface or as JSON text otherwise
+void output_json_report(
+  ui_message_handlert &ui_message_handler,
+  const std::string &key,
+  const json_objectt &report);
+
+#endif // CPROVER_UTIL_RUN_REPORTS_H
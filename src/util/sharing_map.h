@@ -16,6 +16,7 @@ Author: Daniel Poetzl
 #include <iostream>
 #endif
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <memory>
@@ -23,6 +24,7 @@ Author: Daniel Poetzl
 #include <stack>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -280,6 +282,24 @@ public:
   template <class valueU>
   void insert(const key_type &k, valueU &&m);
 
+  /// Insert all elements of a range into an empty map
+  ///
+  /// The elements are first ordered according to their position in the trie
+  /// and then placed in one pass, so that each internal node on the paths to
+  /// the leafs is visited only once rather than once per key. The order of
+  /// the elements in the range is thus irrelevant; in particular a range
+  /// sorted by key (such as a std::map) is fine.
+  ///
+  /// Complexity:
+  /// - Worst case: O(N * log(N) + N * H * S + N * M)
+  /// - Best case: O(N * log(N) + N)
+  ///
+  /// \param begin: begin iterator of a range of key-value pairs (accessible
+  ///   via `first` and `second`), keys must be pairwise distinct
+  /// \param end: end iterator
+  template <class Iterator>
+  void build(Iterator begin, Iterator end);
+
   /// Replace element, element must exist in map
   ///
   /// Complexity:
@@ -386,6 +406,8 @@ public:
     const key_type &k;
 
     const mapped_type &m;
+    // refers to m if the key is only in the map from which the view was
+    // obtained
     const mapped_type &other_m;
   };
 
@@ -405,6 +427,14 @@ public:
   /// \param [out] view: Empty view
   void get_view(viewt &view) const;
 
+  /// Get a view of the elements in the map, gathering the elements of the
+  /// subtrees of the root in up to \p jobs threads. The order of the elements
+  /// in the view may differ from the one obtained via \ref get_view.
+  ///
+  /// \param [out] view: Empty view
+  /// \param jobs: maximum number of threads to use
+  void get_view(viewt &view, std::size_t jobs) const;
+
   /// Get a delta view of the elements in the map
   ///
   /// Informally, a delta view of two maps is a view of the key-value pairs in
@@ -416,8 +446,8 @@ public:
   /// in the map. The first element indicates whether the key exists in both
   /// maps, the second element is the key, the third element is the mapped value
   /// of the first map, and the fourth element is the mapped value of the second
-  /// map, or a dummy element if the key exists only in the first map (in which
-  /// case `in_both` is false).
+  /// map. If the key exists only in the first map (in which case `in_both` is
+  /// false), the fourth element refers to the mapped value of the first map.
   ///
   /// Calling `A.delta_view(B, ...)` yields a view such that for each element in
   /// the view one of two things holds:
@@ -444,6 +474,67 @@ public:
     delta_viewt &delta_view,
     const bool only_common = true) const;
 
+  /// Get a delta view of the elements in the map, traversing the subtrees of
+  /// the root in up to \p jobs threads. Apart from the order of the elements
+  /// in the view the result is the same as that of the sequential version
+  /// above. As only a single thread is started per subtree of the root, this
+  /// pays off only for large maps with little sharing.
+  ///
+  /// \param other: other map
+  /// \param [out] delta_view: Empty delta view
+  /// \param only_common: Indicates if the returned delta view should only
+  ///   contain key-value pairs for keys that exist in both maps
+  /// \param jobs: maximum number of threads to use
+  void get_delta_view(
+    const sharing_mapt &other,
+    delta_viewt &delta_view,
+    const bool only_common,
+    std::size_t jobs) const;
+
+  /// Function to resolve a conflict in \ref sharing_mapt::merge. The
+  /// arguments are the key and its mapped value in the base map, in this map
+  /// and in the other map, with a null pointer indicating that the key does
+  /// not exist in the respective map. The function returns the mapped value
+  /// of the key in the merged map, or an empty optional if the key should not
+  /// be in the merged map.
+  typedef std::function<optionalt<mapped_type>(
+    const key_type &k,
+    const mapped_type *base_value,
+    const mapped_type *value,
+    const mapped_type *other_value)>
+    merge_functiont;
+
+  /// Three-way merge of this map and another map which have both been derived
+  /// from a common base map (via copying and subsequent modification)
+  ///
+  /// The maps are traversed in lockstep, descending only into subtrees that
+  /// are not shared between this map and \p other. A subtree that is shared
+  /// between the other map and \p base has not been changed in the other map
+  /// and this map keeps its own version. Conversely, a subtree that is shared
+  /// between this map and \p base is replaced by (and thus shared with) the
+  /// version of the other map. Only for keys that have been changed in both
+  /// maps the function \p f is called to compute the merged value.
+  ///
+  /// The result is correct for any three maps, but the traversal only skips
+  /// subtrees (and thus is only fast) if the maps actually share their
+  /// unchanged parts with \p base. With an empty \p base, this computes the
+  /// union of the two maps, sharing the subtrees that only \p other has and
+  /// calling \p f for the keys in both maps that are not shared.
+  ///
+  /// Complexity:
+  /// - Worst case: O(max(N1, N2, NB) * H * S * MB * M1 * M2) (no sharing)
+  /// - Best case: O(1) (maximum sharing)
+  ///
+  /// \param base: common base map of this map and \p other
+  /// \param other: other map
+  /// \param f: function to resolve keys that have been changed in both maps;
+  ///   its results are compared to the values in this map with `==`
+  /// \return true if this map has changed
+  bool merge(
+    const sharing_mapt &base,
+    const sharing_mapt &other,
+    merge_functiont f);
+
   /// Call a function for every key-value pair in the map.
   ///
   /// Complexity: as \ref sharing_mapt::get_view
@@ -532,14 +623,40 @@ protected:
   void gather_all(const baset &n, const unsigned depth, delta_viewt &delta_view)
     const;
 
+  void get_delta_view(
+    const innert &n1,
+    const innert &n2,
+    const unsigned depth,
+    delta_viewt &delta_view,
+    const bool only_common) const;
+
+  std::size_t count_leafs(const innert &n, const unsigned depth) const;
+
+  static bool is_empty_node(const innert &n, const unsigned depth);
+
+  /// Check if two (possibly absent) nodes are both absent or shared
+  template <class nodet>
+  static bool shares_or_absent(const nodet *p1, const nodet *p2)
+  {
+    if(p1 == nullptr)
+      return p2 == nullptr;
+
+    return p2 != nullptr && p1->shares_with(*p2);
+  }
+
+  std::ptrdiff_t merge(
+    innert &n,
+    const innert *bp,
+    const innert *op,
+    const unsigned depth,
+    merge_functiont &f,
+    bool &changed);
+
   std::size_t count_unmarked_nodes(
     bool leafs_only,
     std::set<const void *> &marked,
     bool mark = true) const;
 
-  // dummy element returned when no element was found
-  static mapped_type dummy;
-
   static const std::string not_found_msg;
 
   // config
@@ -773,7 +890,7 @@ SHARING_MAPT(void)
 ::gather_all(const baset &n, unsigned depth, delta_viewt &delta_view) const
 {
   auto f = [&delta_view](const key_type &k, const mapped_type &m) {
-    delta_view.push_back(delta_view_itemt(false, k, m, dummy));
+    delta_view.push_back(delta_view_itemt(false, k, m, m));
   };
 
   iterate(n, depth, f);
@@ -800,6 +917,17 @@ SHARING_MAPT(void)
     return;
   }
 
+  get_delta_view(map, other.map, 0, delta_view, only_common);
+}
+
+SHARING_MAPT(void)
+::get_delta_view(
+  const innert &n1,
+  const innert &n2,
+  const unsigned depth,
+  delta_viewt &delta_view,
+  const bool only_common) const
+{
   typedef std::tuple<unsigned, const baset *, const baset *> stack_itemt;
   std::stack<stack_itemt> stack;
 
@@ -810,7 +938,7 @@ SHARING_MAPT(void)
   // The stack contains the children of already visited nodes that we
   // still have to visit during the traversal.
 
-  stack.push(stack_itemt(0, &map, &other.map));
+  stack.push(stack_itemt(depth, &n1, &n2));
 
   do
   {
@@ -872,7 +1000,8 @@ SHARING_MAPT(void)
         }
         else if(!only_common)
         {
-          delta_view.push_back({false, l1.get_key(), l1.get_value(), dummy});
+          delta_view.push_back(
+            {false, l1.get_key(), l1.get_value(), l1.get_value()});
         }
       }
     }
@@ -880,6 +1009,381 @@ SHARING_MAPT(void)
   while(!stack.empty());
 }
 
+SHARING_MAPT(void)
+::get_view(viewt &view, std::size_t jobs) const
+{
+  if(jobs <= 1 || empty())
+  {
+    get_view(view);
+    return;
+  }
+
+  SM_ASSERT(view.empty());
+
+  std::vector<const innert *> subtrees;
+
+  for(const auto &item : map.get_to_map())
+    subtrees.push_back(&item.second);
+
+  jobs = std::min(jobs, subtrees.size());
+
+  std::vector<viewt> views(jobs);
+  std::vector<std::thread> threads;
+
+  for(std::size_t j = 0; j < jobs; j++)
+  {
+    threads.emplace_back([this, &subtrees, &views, jobs, j]() {
+      viewt &v = views[j];
+
+      auto f = [&v](const key_type &k, const mapped_type &m) {
+        v.push_back(view_itemt(k, m));
+      };
+
+      for(std::size_t i = j; i < subtrees.size(); i += jobs)
+        iterate(*subtrees[i], 1, f);
+    });
+  }
+
+  for(auto &t : threads)
+    t.join();
+
+  for(const auto &v : views)
+  {
+    for(const auto &item : v)
+      view.push_back(item);
+  }
+}
+
+SHARING_MAPT(void)
+::get_delta_view(
+  const sharing_mapt &other,
+  delta_viewt &delta_view,
+  const bool only_common,
+  std::size_t jobs) const
+{
+  if(jobs <= 1 || empty() || other.empty())
+  {
+    get_delta_view(other, delta_view, only_common);
+    return;
+  }
+
+  SM_ASSERT(delta_view.empty());
+
+  // pairs of corresponding subtrees of the roots of the two maps that are not
+  // shared, the second component is null if the other map has no such subtree
+  std::vector<std::pair<const innert *, const innert *>> subtrees;
+
+  for(const auto &item : map.get_to_map())
+  {
+    const innert *p = other.map.find_child(item.first);
+
+    if(p == nullptr)
+    {
+      if(!only_common)
+        subtrees.push_back({&item.second, nullptr});
+    }
+    else if(!item.second.shares_with(*p))
+    {
+      subtrees.push_back({&item.second, p});
+    }
+  }
+
+  jobs = std::min(jobs, subtrees.size());
+
+  std::vector<delta_viewt> delta_views(jobs);
+  std::vector<std::thread> threads;
+
+  // the traversals only read the maps, hence they can run concurrently
+  for(std::size_t j = 0; j < jobs; j++)
+  {
+    threads.emplace_back(
+      [this, &subtrees, &delta_views, only_common, jobs, j]() {
+        for(std::size_t i = j; i < subtrees.size(); i += jobs)
+        {
+          const auto &subtree = subtrees[i];
+
+          if(subtree.second == nullptr)
+            gather_all(*subtree.first, 1, delta_views[j]);
+          else
+          {
+            get_delta_view(
+              *subtree.first, *subtree.second, 1, delta_views[j], only_common);
+          }
+        }
+      });
+  }
+
+  for(auto &t : threads)
+    t.join();
+
+  for(const auto &v : delta_views)
+  {
+    for(const auto &item : v)
+      delta_view.push_back(item);
+  }
+}
+
+SHARING_MAPT(std::size_t)
+::count_leafs(const innert &n, const unsigned depth) const
+{
+  std::size_t count = 0;
+
+  iterate(n, depth, [&count](const key_type &, const mapped_type &) {
+    count++;
+  });
+
+  return count;
+}
+
+SHARING_MAPT(bool)::is_empty_node(const innert &n, const unsigned depth)
+{
+  if(n.empty())
+    return true;
+
+  if(depth < steps)
+    return n.get_to_map().empty();
+
+  return n.get_container().empty();
+}
+
+SHARING_MAPT(bool)
+::merge(
+  const sharing_mapt &base,
+  const sharing_mapt &other,
+  merge_functiont f)
+{
+  const innert *bp = base.empty() ? nullptr : &base.map;
+  const innert *op = other.empty() ? nullptr : &other.map;
+  const innert *p = empty() ? nullptr : &map;
+
+  // other map unchanged, or both maps the same
+  if(shares_or_absent(op, bp) || shares_or_absent(p, op))
+    return false;
+
+  // this map unchanged
+  if(shares_or_absent(p, bp))
+  {
+    *this = other;
+    return true;
+  }
+
+  bool changed = false;
+  num += merge(map, bp, op, 0, f, changed);
+
+  if(num == 0)
+    map.clear();
+
+  return changed;
+}
+
+SHARING_MAPT(std::ptrdiff_t)
+::merge(
+  innert &n,
+  const innert *bp,
+  const innert *op,
+  const unsigned depth,
+  merge_functiont &f,
+  bool &changed)
+{
+  // change of the number of elements in the subtree
+  std::ptrdiff_t delta = 0;
+
+  if(depth < steps) // internal
+  {
+    std::set<std::size_t> indices;
+
+    if(!n.empty())
+    {
+      for(const auto &item : as_const(&n)->get_to_map())
+        indices.insert(item.first);
+    }
+
+    if(op != nullptr)
+    {
+      for(const auto &item : op->get_to_map())
+        indices.insert(item.first);
+    }
+
+    for(const std::size_t i : indices)
+    {
+      const innert *c = n.empty() ? nullptr : as_const(&n)->find_child(i);
+      const innert *bc = bp == nullptr ? nullptr : bp->find_child(i);
+      const innert *oc = op == nullptr ? nullptr : op->find_child(i);
+
+      if(shares_or_absent(c, oc) || shares_or_absent(oc, bc))
+        continue;
+
+      if(shares_or_absent(c, bc))
+      {
+        // only changed in the other map, share its subtree
+        changed = true;
+
+        if(c != nullptr)
+          delta -= count_leafs(*c, depth + 1);
+
+        if(oc != nullptr)
+        {
+          *n.add_child(i) = *oc;
+          delta += count_leafs(*oc, depth + 1);
+        }
+        else
+        {
+          n.remove_child(i);
+        }
+
+        continue;
+      }
+
+      // changed in both maps
+      innert &child = *n.add_child(i);
+      delta += merge(child, bc, oc, depth + 1, f, changed);
+
+      if(is_empty_node(child, depth + 1))
+        n.remove_child(i);
+    }
+  }
+  else // container
+  {
+    SM_ASSERT(depth == steps);
+
+    std::vector<key_type> keys;
+
+    if(!n.empty())
+    {
+      for(const auto &l : as_const(&n)->get_container())
+        keys.push_back(l.get_key());
+    }
+
+    if(op != nullptr)
+    {
+      for(const auto &l : op->get_container())
+      {
+        if(n.empty() || as_const(&n)->find_leaf(l.get_key()) == nullptr)
+          keys.push_back(l.get_key());
+      }
+    }
+
+    for(const key_type &k : keys)
+    {
+      const leaft *l = n.empty() ? nullptr : as_const(&n)->find_leaf(k);
+      const leaft *bl = bp == nullptr ? nullptr : bp->find_leaf(k);
+      const leaft *ol = op == nullptr ? nullptr : op->find_leaf(k);
+
+      if(shares_or_absent(l, ol) || shares_or_absent(ol, bl))
+        continue;
+
+      if(shares_or_absent(l, bl))
+      {
+        // only changed in the other map, share its leaf
+        changed = true;
+
+        if(l != nullptr)
+        {
+          n.remove_leaf(k);
+          delta--;
+        }
+
+        if(ol != nullptr)
+        {
+          n.get_container().push_front(*ol);
+          delta++;
+        }
+
+        continue;
+      }
+
+      // changed in both maps
+      optionalt<mapped_type> m = f(
+        k,
+        bl == nullptr ? nullptr : &bl->get_value(),
+        l == nullptr ? nullptr : &l->get_value(),
+        ol == nullptr ? nullptr : &ol->get_value());
+
+      if(!m.has_value())
+      {
+        if(l != nullptr)
+        {
+          n.remove_leaf(k);
+          delta--;
+          changed = true;
+        }
+      }
+      else if(l == nullptr)
+      {
+        n.place_leaf(k, std::move(*m));
+        delta++;
+        changed = true;
+      }
+      else if(!(l->get_value() == *m))
+      {
+        n.find_leaf(k)->set_value(std::move(*m));
+        changed = true;
+      }
+    }
+  }
+
+  return delta;
+}
+
+SHARING_MAPT4(Iterator, void)::build(Iterator begin, Iterator end)
+{
+  PRECONDITION(empty());
+
+  // pairs of the path to the container of a key in the trie (with the child
+  // index of the root in the most significant bits) and the element
+  typedef std::pair<std::size_t, Iterator> itemt;
+  std::vector<itemt> items;
+
+  for(Iterator it = begin; it != end; it++)
+  {
+    std::size_t key = hash()(it->first);
+    std::size_t path = 0;
+
+    for(std::size_t i = 0; i < steps; i++)
+    {
+      path = (path << chunk) | (key & mask);
+      key >>= chunk;
+    }
+
+    items.push_back(itemt(path, it));
+  }
+
+  std::sort(
+    items.begin(), items.end(), [](const itemt &a, const itemt &b) {
+      return a.first < b.first;
+    });
+
+  // nodes on the path to the container of the previous element
+  std::vector<innert *> path_nodes(steps + 1, nullptr);
+  path_nodes[0] = &map;
+
+  for(std::size_t j = 0; j < items.size(); j++)
+  {
+    const std::size_t path = items[j].first;
+
+    // skip the prefix shared with the path of the previous element
+    std::size_t i = 0;
+
+    if(j > 0)
+    {
+      const std::size_t previous = items[j - 1].first;
+
+      while(i < steps && ((path ^ previous) >> (chunk * (steps - 1 - i))) == 0)
+        i++;
+    }
+
+    for(; i < steps; i++)
+    {
+      std::size_t bit = (path >> (chunk * (steps - 1 - i))) & mask;
+      path_nodes[i + 1] = path_nodes[i]->add_child(bit);
+    }
+
+    const Iterator &it = items[j].second;
+    path_nodes[steps]->place_leaf(it->first, it->second);
+    num++;
+  }
+}
+
 SHARING_MAPT2(, innert *)::get_container_node(const key_type &k)
 {
   std::size_t key = hash()(k);
@@ -1022,8 +1526,6 @@ SHARING_MAPT2(optionalt<std::reference_wrapper<const, mapped_type>>)::find(
 
 SHARING_MAPT(const std::string)::not_found_msg="key not found";
 
-SHARING_MAPT2(, mapped_type)::dummy;
-
 SHARING_MAPT(const std::size_t)::bits = 18;
 SHARING_MAPT(const std::size_t)::chunk = 3;
 
@@ -9,6 +9,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "simplify_expr.h"
 
 #include <algorithm>
+#include <list>
+#include <unordered_map>
 
 #include "arith_tools.h"
 #include "byte_operators.h"
@@ -18,8 +20,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "expr_util.h"
 #include "fixedbv.h"
 #include "invariant.h"
+#include "make_unique.h"
 #include "mathematical_expr.h"
 #include "namespace.h"
+#include "perf_counters.h"
 #include "pointer_offset_size.h"
 #include "pointer_offset_sum.h"
 #include "rational.h"
@@ -39,29 +43,110 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "simplify_expr_class.h"
 
-// #define USE_CACHE
-
-#ifdef USE_CACHE
-struct simplify_expr_cachet
+/// Memoization of \ref simplify_exprt::simplify_rec, holding at most a given
+/// number of entries and evicting the least recently used one when full.
+/// Expressions are looked up including their comments, but hashed ignoring
+/// them, which makes use of the hash codes cached in shared ireps.
+class simplify_expr_cachet
 {
 public:
-  #if 1
-  typedef std::unordered_map<
-    exprt, exprt, irep_full_hash, irep_full_eq> containert;
-  #else
-  typedef std::unordered_map<exprt, exprt, irep_hash> containert;
-  #endif
+  explicit simplify_expr_cachet(std::size_t max_size) : max_size(max_size)
+  {
+  }
+
+  /// Look up the result of simplifying \p expr
+  /// \return nullptr if \p expr is not in the cache, otherwise the simplified
+  ///   expression, which is nil if simplification did not change \p expr
+  const exprt *find(const exprt &expr)
+  {
+    auto entry = index.find(expr);
+
+    if(entry == index.end())
+    {
+      ++misses;
+      return nullptr;
+    }
+
+    ++hits;
+    // move to the front of the recently-used list
+    entries.splice(entries.begin(), entries, entry->second);
+    return &entry->second->second;
+  }
+
+  void insert(const exprt &expr, const exprt &result)
+  {
+    entries.emplace_front(expr, result);
+    if(!index.emplace(expr, entries.begin()).second)
+    {
+      entries.pop_front();
+      return;
+    }
 
-  containert container_normal;
+    if(entries.size() > max_size)
+    {
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+  }
 
-  containert &container()
+  void clear()
   {
-    return container_normal;
+    index.clear();
+    entries.clear();
   }
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+
+protected:
+  const std::size_t max_size;
+
+  typedef std::list<std::pair<exprt, exprt>> entriest;
+  entriest entries;
+
+  std::unordered_map<exprt, entriest::iterator, irep_hash, irep_full_eq>
+    index;
 };
 
-simplify_expr_cachet simplify_expr_cache;
+simplify_exprt::simplify_exprt(const namespacet &_ns)
+  : do_simplify_if(true),
+    ns(_ns)
+#ifdef DEBUG_ON_DEMAND
+    ,
+    debug_on(false)
+#endif
+{
+#ifdef DEBUG_ON_DEMAND
+  struct stat f;
+  debug_on = stat("SIMP_DEBUG", &f) == 0;
 #endif
+}
+
+simplify_exprt::~simplify_exprt()
+{
+}
+
+void simplify_exprt::enable_cache(std::size_t max_size)
+{
+  PRECONDITION(max_size != 0);
+  cache = util_make_unique<simplify_expr_cachet>(max_size);
+}
+
+void simplify_exprt::clear_cache()
+{
+  if(cache)
+    cache->clear();
+}
+
+std::size_t simplify_exprt::cache_hits() const
+{
+  return cache ? cache->hits : 0;
+}
+
+std::size_t simplify_exprt::cache_misses() const
+{
+  return cache ? cache->misses : 0;
+}
 
 bool simplify_exprt::simplify_abs(exprt &expr)
 {
@@ -2541,24 +2626,25 @@ bool simplify_exprt::simplify_node(exprt &expr)
 /// \return returns true if expression unchanged; returns false if changed
 bool simplify_exprt::simplify_rec(exprt &expr)
 {
-  // look up in cache
+  // Only expressions with operands are worth caching, all others are
+  // simplified (or not) without any recursion.
+  const bool use_cache = cache && expr.has_operands();
 
-  #ifdef USE_CACHE
-  std::pair<simplify_expr_cachet::containert::iterator, bool>
-    cache_result=simplify_expr_cache.container().
-      insert(std::pair<exprt, exprt>(expr, exprt()));
-
-  if(!cache_result.second) // found!
+  if(use_cache)
   {
-    const exprt &new_expr=cache_result.first->second;
+    const exprt *cached = cache->find(expr);
 
-    if(new_expr.id().empty())
-      return true; // no change
+    if(cached != nullptr)
+    {
+      PERF_COUNT("simplify.cache_hits");
 
-    expr=new_expr;
-    return false;
+      if(cached->is_nil())
+        return true; // no change
+
+      expr = *cached;
+      return false;
+    }
   }
-  #endif
 
   // We work on a copy to prevent unnecessary destruction of sharing.
   exprt tmp=expr;
@@ -2588,19 +2674,21 @@ bool simplify_exprt::simplify_rec(exprt &expr)
   if(!result)
   {
     POSTCONDITION(tmp.type() == expr.type());
-    expr.swap(tmp);
+    if(use_cache)
+      cache->insert(expr, tmp);
 
-    #ifdef USE_CACHE
-    // save in cache
-    cache_result.first->second=expr;
-    #endif
+    expr.swap(tmp);
   }
+  else if(use_cache)
+    cache->insert(expr, nil_exprt());
 
   return result;
 }
 
 bool simplify_exprt::simplify(exprt &expr)
 {
+  PERF_COUNT("simplify.calls");
+
 #ifdef DEBUG_ON_DEMAND
   if(debug_on)
     std::cout << "TO-SIMP " << format(expr) << "\n";
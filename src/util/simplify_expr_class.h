@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <sys/stat.h>
 #endif
 
+#include <memory>
 #include <set>
 
 #include "type.h"
@@ -34,6 +35,7 @@ class index_exprt;
 class member_exprt;
 class namespacet;
 class popcount_exprt;
+class simplify_expr_cachet;
 class tvt;
 
 #define forall_value_list(it, value_list) \
@@ -43,25 +45,26 @@ class tvt;
 class simplify_exprt
 {
 public:
-  explicit simplify_exprt(const namespacet &_ns):
-    do_simplify_if(true),
-    ns(_ns)
-#ifdef DEBUG_ON_DEMAND
-    , debug_on(false)
-#endif
-  {
-#ifdef DEBUG_ON_DEMAND
-    struct stat f;
-    debug_on=stat("SIMP_DEBUG", &f)==0;
-#endif
-  }
+  explicit simplify_exprt(const namespacet &_ns);
 
-  virtual ~simplify_exprt()
-  {
-  }
+  virtual ~simplify_exprt();
 
   bool do_simplify_if;
 
+  /// Memoize the results of simplifying expressions, keeping at most
+  /// \p max_size of them. Results depend on the namespace passed to the
+  /// constructor: use \ref clear_cache when it changes.
+  void enable_cache(std::size_t max_size);
+
+  /// Drop all memoized results, if any
+  void clear_cache();
+
+  /// Number of expressions found in the cache (0 when it is not enabled)
+  std::size_t cache_hits() const;
+
+  /// Number of expressions not found in the cache (0 when it is not enabled)
+  std::size_t cache_misses() const;
+
   // These below all return 'true' if the simplification wasn't applicable.
   // If false is returned, the expression has changed.
 
@@ -161,6 +164,7 @@ public:
 
 protected:
   const namespacet &ns;
+  std::unique_ptr<simplify_expr_cachet> cache;
 #ifdef DEBUG_ON_DEMAND
   bool debug_on;
 #endif
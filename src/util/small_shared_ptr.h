@@ -9,9 +9,12 @@ Author: Reuben Thomas, reuben.thomas@diffblue.com
 #ifndef CPROVER_UTIL_SMALL_SHARED_PTR_H
 #define CPROVER_UTIL_SMALL_SHARED_PTR_H
 
+#include <atomic>
 #include <iosfwd>  // ostream
 #include <utility> // swap
 
+#include "irep.h"
+
 // TODO We should liberally scatter `constexpr`s and `noexcept`s on platforms
 // that support them.
 
@@ -66,12 +69,12 @@ public:
     {
       return;
     }
-    if(pointee_use_count(*t_) == 1)
+    // with concurrent owners, the last one to decrement deletes
+    if(
+      pointee_use_count(*t_) == 1 || pointee_decrement_use_count(*t_) == 0)
     {
       delete t_;
-      return;
     }
-    pointee_decrement_use_count(*t_);
   }
 
   void swap(small_shared_ptrt &rhs)
@@ -200,17 +203,30 @@ public:
     return *this;
   }
 
+  /// Like the reference counts of ireps, the use count is updated atomically
+  /// only while an \ref irep_concurrency_scopet is active.
   void increment_use_count()
   {
-    ++use_count_;
+    if(irep_concurrency_scopet::is_active())
+      use_count_.fetch_add(1, std::memory_order_relaxed);
+    else
+      use_count_.store(
+        use_count_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
   }
-  void decrement_use_count()
+  /// \return the use count after decrementing it
+  Num decrement_use_count()
   {
-    --use_count_;
+    if(irep_concurrency_scopet::is_active())
+      return use_count_.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+    const Num result = use_count_.load(std::memory_order_relaxed) - 1;
+    use_count_.store(result, std::memory_order_relaxed);
+    return result;
   }
   Num use_count() const
   {
-    return use_count_;
+    return use_count_.load(std::memory_order_acquire);
   }
 
 protected:
@@ -218,7 +234,7 @@ protected:
   ~small_shared_pointeet() = default;
 
 private:
-  Num use_count_ = 0;
+  std::atomic<Num> use_count_{0};
 };
 
 /// The following functions are required by small_shared_ptrt, and by
@@ -236,9 +252,9 @@ inline void pointee_increment_use_count(small_shared_pointeet<Num> &p)
 }
 
 template <typename Num>
-inline void pointee_decrement_use_count(small_shared_pointeet<Num> &p)
+inline Num pointee_decrement_use_count(small_shared_pointeet<Num> &p)
 {
-  p.decrement_use_count();
+  return p.decrement_use_count();
 }
 
 template <typename Num>
@@ -9,11 +9,13 @@ Author: Daniel Poetzl
 #ifndef CPROVER_UTIL_SMALL_SHARED_TWO_WAY_PTR_H
 #define CPROVER_UTIL_SMALL_SHARED_TWO_WAY_PTR_H
 
+#include <atomic>
 #include <type_traits>
 #include <limits>
 #include <utility>
 
 #include "invariant.h"
+#include "irep.h"
 
 template <typename Num>
 class small_shared_two_way_pointeet;
@@ -176,9 +178,8 @@ private:
       return;
     }
 
-    auto use_count = p->use_count();
-
-    if(use_count == 1)
+    // with concurrent owners, the last one to decrement deletes
+    if(p->use_count() == 1 || p->decrement_use_count() == 0)
     {
       if(p->is_derived_u())
       {
@@ -191,10 +192,6 @@ private:
         delete v;
       }
     }
-    else
-    {
-      p->decrement_use_count();
-    }
   }
 
   pointeet *p = nullptr;
@@ -253,50 +250,70 @@ public:
 
   Num use_count() const
   {
-    return use_count_ & mask;
+    return use_count_.load(std::memory_order_acquire) & mask;
   }
 
+  /// Like the reference counts of ireps, the use count is updated atomically
+  /// only while an \ref irep_concurrency_scopet is active.
   void increment_use_count()
   {
-    PRECONDITION((use_count_ & mask) < mask);
+    PRECONDITION(use_count() < mask);
 
-    use_count_++;
+    if(irep_concurrency_scopet::is_active())
+      use_count_.fetch_add(1, std::memory_order_relaxed);
+    else
+      use_count_.store(
+        use_count_.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
   }
 
-  void decrement_use_count()
+  /// \return the use count after decrementing it
+  Num decrement_use_count()
   {
-    PRECONDITION((use_count_ & mask) > 0);
+    PRECONDITION(use_count() > 0);
+
+    if(irep_concurrency_scopet::is_active())
+      return (use_count_.fetch_sub(1, std::memory_order_acq_rel) - 1) & mask;
 
-    use_count_--;
+    const Num result = use_count_.load(std::memory_order_relaxed) - 1;
+    use_count_.store(result, std::memory_order_relaxed);
+    return result & mask;
   }
 
   void set_derived_u()
   {
-    use_count_ &= mask;
+    use_count_.store(
+      use_count_.load(std::memory_order_relaxed) & mask,
+      std::memory_order_relaxed);
   }
 
   void set_derived_v()
   {
-    use_count_ |= ~mask;
+    use_count_.store(
+      use_count_.load(std::memory_order_relaxed) | ~mask,
+      std::memory_order_relaxed);
   }
 
   bool is_derived_u() const
   {
-    return !(use_count_ & ~mask);
+    return !(use_count_.load(std::memory_order_relaxed) & ~mask);
   }
 
   bool is_derived_v() const
   {
-    return (use_count_ & ~mask) != 0;
+    return (use_count_.load(std::memory_order_relaxed) & ~mask) != 0;
   }
 
   bool is_same_type(const small_shared_two_way_pointeet &other) const
   {
-    return !((use_count_ ^ other.use_count_) & ~mask);
+    return !(
+      (use_count_.load(std::memory_order_relaxed) ^
+       other.use_count_.load(std::memory_order_relaxed)) &
+      ~mask);
   }
 
 private:
-  Num use_count_ = 0;
+  std::atomic<Num> use_count_{0};
 };
 
 #endif
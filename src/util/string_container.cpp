@@ -12,11 +12,28 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "string_container.h"
 
 #include <cstring>
+#include <limits>
+
+#include "invariant.h"
 
 string_ptrt::string_ptrt(const char *_s):s(_s), len(strlen(_s))
 {
 }
 
+/// The strings the current thread interns provisionally, if any
+static thread_local deferred_stringst *deferred_strings = nullptr;
+
+deferred_interningt::deferred_interningt(deferred_stringst *strings)
+  : previous(deferred_strings)
+{
+  deferred_strings = strings;
+}
+
+deferred_interningt::~deferred_interningt()
+{
+  deferred_strings = previous;
+}
+
 bool string_ptrt::operator==(const string_ptrt &other) const
 {
   if(len!=other.len)
@@ -27,50 +44,113 @@ bool string_ptrt::operator==(const string_ptrt &other) const
 
 string_containert::~string_containert()
 {
+  auto destroy = [this](std::size_t first, std::size_t last) {
+    for(std::size_t no = first; no < last; ++no)
+    {
+      std::string &str =
+        segments[no >> segment_bits].load()[no & segment_mask];
+      str.~basic_string();
+    }
+  };
+
+  destroy(0, number_of_strings);
+  destroy(first_provisional_number, next_provisional_number);
+
+  for(auto &segment : segments)
+  {
+    std::string *ptr = segment.load();
+    if(ptr != nullptr)
+      ::operator delete(ptr);
+  }
 }
 
-unsigned string_containert::get(const char *s)
+/// Get the segment with the given number, allocating it if needed.
+std::string *string_containert::get_segment(std::size_t segment_no)
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  std::atomic<std::string *> &segment = segments[segment_no];
 
-  if(it!=hash_table.end())
-    return it->second;
+  std::string *ptr = segment.load(std::memory_order_acquire);
+  if(ptr != nullptr)
+    return ptr;
 
-  size_t r=hash_table.size();
+  // Strings are constructed on insertion only, hence raw storage.
+  std::string *new_segment = static_cast<std::string *>(
+    ::operator new(sizeof(std::string) * segment_size));
 
-  // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
+  if(segment.compare_exchange_strong(
+       ptr, new_segment, std::memory_order_acq_rel))
+  {
+    return new_segment;
+  }
 
-  hash_table[result]=r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
+  // another thread allocated it first
+  ::operator delete(new_segment);
+  return ptr;
+}
 
-  return r;
+/// Construct the string with number \p no, which is stable.
+std::string *
+string_containert::new_string(unsigned no, const string_ptrt &string_ptr)
+{
+  std::string *segment = get_segment(no >> segment_bits);
+  return new(&segment[no & segment_mask])
+    std::string(string_ptr.s, string_ptr.len);
 }
 
-unsigned string_containert::get(const std::string &s)
+unsigned string_containert::get(const string_ptrt &string_ptr)
 {
-  string_ptrt string_ptr(s);
+  // a thread keeps the provisional number of a string even if another
+  // thread interns the string meanwhile, for the numbers of a thread to
+  // stay consistent
+  if(deferred_strings != nullptr)
+  {
+    const auto it = deferred_strings->hash_table.find(string_ptr);
+    if(it != deferred_strings->hash_table.end())
+      return it->second;
+  }
+
+  shardt &shard = shards[string_ptr_hash()(string_ptr) % number_of_shards];
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
 
-  if(it!=hash_table.end())
-    return it->second;
+    hash_tablet::iterator it = shard.hash_table.find(string_ptr);
 
-  size_t r=hash_table.size();
+    if(it != shard.hash_table.end())
+      return it->second;
 
-  // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
+    if(deferred_strings == nullptr)
+    {
+      const unsigned r = number_of_strings++;
+      PRECONDITION(r < first_provisional_number);
 
-  hash_table[result]=r;
+      std::string *str = new_string(r, string_ptr);
+      shard.hash_table.emplace(string_ptrt(*str), r);
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+      return r;
+    }
+  }
+
+  const unsigned r = next_provisional_number++;
+  PRECONDITION(r != std::numeric_limits<unsigned>::max());
+
+  std::string *str = new_string(r, string_ptr);
+  deferred_strings->hash_table.emplace(string_ptrt(*str), r);
+  deferred_strings->numbers.push_back(r);
 
   return r;
 }
+
+std::unordered_map<unsigned, unsigned>
+string_containert::intern(const deferred_stringst &deferred)
+{
+  const deferred_interningt intern_now(nullptr);
+
+  std::unordered_map<unsigned, unsigned> result;
+  result.reserve(deferred.numbers.size());
+
+  for(const unsigned no : deferred.numbers)
+    result.emplace(no, get(string_ptrt(get_string(no))));
+
+  return result;
+}
@@ -12,7 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
-#include <list>
+#include <array>
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -44,49 +46,124 @@ public:
   size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
 };
 
+/// Strings that a thread has interned provisionally, see
+/// \ref deferred_interningt
+struct deferred_stringst
+{
+  /// Provisional numbers, in the order in which the strings were interned
+  std::vector<unsigned> numbers;
+
+  std::unordered_map<string_ptrt, unsigned, string_ptr_hash> hash_table;
+};
+
+/// Table of all strings represented by \ref dstringt, numbering each string
+/// by the order of insertion. The table may be used by multiple threads
+/// concurrently: looking up the string for a number does not take any locks,
+/// and insertions only lock one of several shards of the hash table. Numbers,
+/// and references to strings, are stable once handed out.
+///
+/// As the order of insertion by concurrent threads varies between runs, so
+/// would the numbers. Threads can thus defer the insertion of new strings,
+/// see \ref deferred_interningt, and have them interned in a fixed order
+/// later on by \ref string_containert::intern.
 class string_containert
 {
 public:
   unsigned operator[](const char *s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   unsigned operator[](const std::string &s)
   {
-    return get(s);
+    return get(string_ptrt(s));
   }
 
   // constructor and destructor
   string_containert();
   ~string_containert();
 
+  string_containert(const string_containert &) = delete;
+  string_containert &operator=(const string_containert &) = delete;
+
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    return *string_vector[no];
+    return segments[no >> segment_bits].load(
+      std::memory_order_acquire)[no & segment_mask];
   }
 
+  /// Numbers from this one onwards are provisional, see
+  /// \ref deferred_interningt
+  static const unsigned first_provisional_number = 1u << 31;
+
+  static bool is_provisional(unsigned no)
+  {
+    return no >= first_provisional_number;
+  }
+
+  /// Intern the strings of \p deferred in the order in which they were
+  /// interned provisionally
+  /// \return the number in this table of each provisional number
+  std::unordered_map<unsigned, unsigned> intern(const deferred_stringst &);
+
 protected:
   // the 'unsigned' ought to be size_t
   typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
     hash_tablet;
-  hash_tablet hash_table;
 
-  unsigned get(const char *s);
-  unsigned get(const std::string &s);
+  struct shardt
+  {
+    std::mutex mutex;
+    hash_tablet hash_table;
+  };
+
+  static const std::size_t number_of_shards = 16;
+  std::array<shardt, number_of_shards> shards;
+
+  unsigned get(const string_ptrt &);
+
+  // Strings are stored in segments of fixed size, which are never moved.
+  static const std::size_t segment_bits = 16;
+  static const std::size_t segment_size = std::size_t(1) << segment_bits;
+  static const std::size_t segment_mask = segment_size - 1;
+  static const std::size_t number_of_segments =
+    (std::size_t(1) << (sizeof(unsigned) * 8 - segment_bits));
+
+  std::atomic<std::string *> segments[number_of_segments];
+  std::atomic<unsigned> number_of_strings;
+  std::atomic<unsigned> next_provisional_number;
+
+  std::string *get_segment(std::size_t segment_no);
+  std::string *new_string(unsigned no, const string_ptrt &);
+};
+
+/// While an object of this class is alive, strings that the current thread
+/// interns and that are not in the string table yet get a provisional number,
+/// which is recorded in \p strings, rather than the next number of the table.
+/// Provisional numbers stand for their string like any other number, except
+/// that the same string may have a different provisional number in another
+/// thread; they must be replaced by the numbers that
+/// \ref string_containert::intern returns before the strings are compared
+/// with those of other threads. Passing nullptr interns strings right away
+/// again, as is needed for strings that are kept forever.
+class deferred_interningt
+{
+public:
+  explicit deferred_interningt(deferred_stringst *strings);
+  ~deferred_interningt();
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  deferred_interningt(const deferred_interningt &) = delete;
+  deferred_interningt &operator=(const deferred_interningt &) = delete;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+private:
+  deferred_stringst *previous;
 };
 
 /// Get a reference to the global string container.
@@ -37,14 +37,16 @@ timestampert::make(timestampert::clockt clock_type)
 #endif
 }
 
+std::chrono::microseconds timestampert::monotonic_now()
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch());
+}
+
 #ifndef _WIN32
 std::string monotonic_timestampert::stamp() const
 {
-  std::chrono::time_point<std::chrono::steady_clock, std::chrono::microseconds>
-    time_stamp = std::chrono::time_point_cast<std::chrono::microseconds>(
-      std::chrono::steady_clock::now());
-
-  auto cnt = time_stamp.time_since_epoch().count();
+  auto cnt = monotonic_now().count();
   std::lldiv_t divmod = lldiv(cnt, 1000000);
 
   std::stringstream ss;
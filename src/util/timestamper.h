@@ -17,6 +17,7 @@
   "                              wall: ISO-8601 wall clock timestamps.\n"
 #endif
 
+#include <chrono>
 #include <memory>
 #include <string>
 
@@ -61,6 +62,10 @@ public:
 
   /// \brief Factory method to build timestampert subclasses
   static std::unique_ptr<const timestampert> make(clockt clock_type);
+
+  /// \brief Time elapsed since an unspecified, fixed point in time, as used
+  /// by monotonic timestamps
+  static std::chrono::microseconds monotonic_now();
 };
 
 #ifndef _WIN32
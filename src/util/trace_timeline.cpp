@@ -0,0 +1,144 @@
+/*******************************************************************\
+
+Module: Trace Timeline
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Record the phases of a tool run in Chrome trace-event format
+
+#include "trace_timeline.h"
+
+#include "exception_utils.h"
+#include "json.h"
+#include "json_stream.h"
+#include "timestamper.h"
+
+#ifdef _MSC_VER
+#include <util/unicode.h>
+#endif
+
+/// \return a small number identifying the calling thread
+static std::size_t thread_number()
+{
+  static std::atomic<std::size_t> next_thread_number{0};
+  thread_local const std::size_t number = next_thread_number++;
+  return number;
+}
+
+trace_timelinet::trace_timelinet() = default;
+
+trace_timelinet::~trace_timelinet()
+{
+  close();
+}
+
+void trace_timelinet::open(const std::string &filename)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  PRECONDITION(!events);
+
+#ifdef _MSC_VER
+  out.open(widen(filename));
+#else
+  out.open(filename);
+#endif
+
+  if(!out)
+    throw system_exceptiont("failed to open trace timeline file " + filename);
+
+  events = std::unique_ptr<json_stream_arrayt>(new json_stream_arrayt(out));
+  out.flush();
+  unflushed_events = 0;
+  last_flush = now();
+  enabled = true;
+}
+
+void trace_timelinet::close()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if(!events)
+    return;
+
+  enabled = false;
+  events.reset();
+  out << '\n';
+  out.close();
+}
+
+/// \return a trace event of phase \p phase for the calling thread
+static json_objectt make_event(
+  const std::string &name,
+  const std::string &category,
+  const char *phase,
+  std::chrono::microseconds timestamp)
+{
+  return json_objectt{
+    {"name", json_stringt(name)},
+    {"cat", json_stringt(category)},
+    {"ph", json_stringt(phase)},
+    {"ts", json_numbert(std::to_string(timestamp.count()))},
+    {"pid", json_numbert("1")},
+    {"tid", json_numbert(std::to_string(thread_number()))}};
+}
+
+void trace_timelinet::begin(
+  const std::string &name,
+  const std::string &category)
+{
+  write_event(make_event(name, category, "B", now()));
+}
+
+void trace_timelinet::end(const std::string &name, const std::string &category)
+{
+  write_event(make_event(name, category, "E", now()));
+}
+
+void trace_timelinet::complete(
+  const std::string &name,
+  const std::string &category,
+  std::chrono::microseconds start,
+  std::chrono::microseconds duration)
+{
+  json_objectt event = make_event(name, category, "X", start);
+  event["dur"] = json_numbert(std::to_string(duration.count()));
+  write_event(event);
+}
+
+std::chrono::microseconds trace_timelinet::now()
+{
+  return timestampert::monotonic_now();
+}
+
+void trace_timelinet::write_event(const json_objectt &event)
+{
+  const std::chrono::microseconds time = now();
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // the timeline may have been closed since the caller checked is_enabled
+  if(!events)
+    return;
+
+  events->push_back(event);
+
+  // flushing on every event would make each span pay for a system call
+  if(
+    ++unflushed_events >= flush_interval ||
+    time - last_flush >= std::chrono::seconds(1))
+  {
+    out.flush();
+    unflushed_events = 0;
+    last_flush = time;
+  }
+}
+
+trace_timelinet &trace_timeline()
+{
+  static trace_timelinet timeline;
+  return timeline;
+}
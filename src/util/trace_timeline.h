@@ -0,0 +1,126 @@
+/*******************************************************************\
+
+Module: Trace Timeline
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Record the phases of a tool run in Chrome trace-event format
+
+#ifndef CPROVER_UTIL_TRACE_TIMELINE_H
+#define CPROVER_UTIL_TRACE_TIMELINE_H
+
+#define OPT_TRACE_TIMELINE "(trace-timeline):"
+
+#define HELP_TRACE_TIMELINE                                                    \
+  " --trace-timeline file        write the timeline of phases in Chrome\n"    \
+  "                              trace-event format to file\n"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+class json_objectt;
+class json_stream_arrayt;
+
+/// Writes spans of time, such as the phases of a verification run, as trace
+/// events that can be loaded into chrome://tracing, Perfetto or speedscope.
+/// Events are streamed to the file as they are recorded. The file is flushed
+/// every \ref flush_interval events, and on the first event after a second
+/// without a flush, so that a timeline survives runs that are killed; the
+/// trace-event format accepts an array that lacks its closing bracket.
+/// Timestamps are taken from the same clock as
+/// \ref monotonic_timestampert. Nothing is recorded unless a file has been
+/// opened.
+class trace_timelinet
+{
+public:
+  trace_timelinet();
+  ~trace_timelinet();
+
+  /// Start recording events, which will be written to \p filename
+  /// \throws system_exceptiont if the file cannot be opened
+  void open(const std::string &filename);
+
+  /// Terminate the JSON array of events and close the file
+  void close();
+
+  bool is_enabled() const
+  {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /// Record the beginning of a span named \p name. Spans of the same thread
+  /// must be properly nested.
+  void begin(const std::string &name, const std::string &category);
+
+  /// Record the end of the innermost span of this thread named \p name
+  void end(const std::string &name, const std::string &category);
+
+  /// Record a span of \p duration that began at \p start, which need not
+  /// nest with other spans
+  void complete(
+    const std::string &name,
+    const std::string &category,
+    std::chrono::microseconds start,
+    std::chrono::microseconds duration);
+
+  /// \return the current time of the clock used for all events
+  static std::chrono::microseconds now();
+
+  /// number of events after which the file is flushed
+  static const std::size_t flush_interval = 256;
+
+private:
+  std::atomic<bool> enabled{false};
+
+  std::mutex mutex;
+  std::ofstream out;
+  std::unique_ptr<json_stream_arrayt> events;
+
+  /// number of events written since the file was last flushed
+  std::size_t unflushed_events = 0;
+  std::chrono::microseconds last_flush{0};
+
+  void write_event(const json_objectt &event);
+};
+
+/// \return the process-wide trace timeline
+trace_timelinet &trace_timeline();
+
+/// Records a span from construction to destruction in the process-wide
+/// trace timeline, if it is enabled
+class trace_spant
+{
+public:
+  explicit trace_spant(std::string _name, std::string _category = "phase")
+    : enabled(trace_timeline().is_enabled()),
+      name(std::move(_name)),
+      category(std::move(_category))
+  {
+    if(enabled)
+      trace_timeline().begin(name, category);
+  }
+
+  ~trace_spant()
+  {
+    if(enabled)
+      trace_timeline().end(name, category);
+  }
+
+  trace_spant(const trace_spant &) = delete;
+  trace_spant &operator=(const trace_spant &) = delete;
+
+private:
+  const bool enabled;
+  const std::string name;
+  const std::string category;
+};
+
+#endif // CPROVER_UTIL_TRACE_TIMELINE_H
@@ -97,7 +97,7 @@ ui_message_handlert::~ui_message_handlert()
   switch(get_ui())
   {
   case uit::XML_UI:
-
+    close_xml_stream();
     out << "</cprover>"
         << "\n";
     break;
@@ -168,7 +168,7 @@ void ui_message_handlert::print(
       INVARIANT(false, "Cannot print xml data on PLAIN UI");
       break;
     case uit::XML_UI:
-      out << data << '\n';
+      output_xml(data);
       flush(level);
       break;
     case uit::JSON_UI:
@@ -272,8 +272,7 @@ void ui_message_handlert::xml_ui_msg(
   if(!timestamp.empty())
     result.set_attribute("timestamp", timestamp);
 
-  out << result;
-  out << '\n';
+  output_xml(result);
 }
 
 void ui_message_handlert::json_ui_msg(
@@ -295,6 +294,49 @@ void ui_message_handlert::json_ui_msg(
     result["timestamp"] = json_stringt(timestamp);
 }
 
+xml_streamt &ui_message_handlert::new_xml_stream(
+  unsigned level,
+  const std::string &name,
+  const xmlt::attributest &attributes)
+{
+  PRECONDITION(get_ui() == uit::XML_UI);
+  close_xml_stream();
+
+  xml_stream_output = verbosity >= level;
+  if(!xml_stream_output && !discarded_output)
+    discarded_output = util_make_unique<std::ostream>(nullptr);
+
+  xml_stream = util_make_unique<xml_streamt>(
+    xml_stream_output ? out : *discarded_output, name, attributes);
+  return *xml_stream;
+}
+
+void ui_message_handlert::close_xml_stream()
+{
+  if(!xml_stream)
+    return;
+
+  xml_stream->close();
+  xml_stream = nullptr;
+
+  // followed by an empty line as for other XML data
+  if(xml_stream_output)
+    out << '\n';
+
+  for(const auto &xml : deferred_xml)
+    out << xml << '\n';
+  deferred_xml.clear();
+}
+
+/// Print \p xml, or defer it until the current XML stream has been closed
+void ui_message_handlert::output_xml(const xmlt &xml)
+{
+  if(xml_stream && xml_stream_output)
+    deferred_xml.push_back(xml);
+  else
+    out << xml << '\n';
+}
+
 void ui_message_handlert::flush(unsigned level)
 {
   switch(get_ui())
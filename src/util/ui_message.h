@@ -11,10 +11,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_UTIL_UI_MESSAGE_H
 
 #include <memory>
+#include <vector>
 
 #include "cout_message.h"
 #include "json_stream.h"
 #include "timestamper.h"
+#include "xml_stream.h"
 
 class ui_message_handlert : public message_handlert
 {
@@ -41,6 +43,25 @@ public:
     return *json_stream;
   }
 
+  /// Start a top-level element of the XML output that is written
+  /// incrementally. The stream stays valid until the element is closed by
+  /// \ref close_xml_stream, by starting the next such element, or by
+  /// destroying the handler. Messages printed in the meantime are output
+  /// once the element has been closed.
+  /// \param level: level of the element; it is discarded if this exceeds
+  ///   the verbosity
+  /// \param name: tag of the element
+  /// \param attributes: attributes of the element
+  /// \return the stream for the element
+  virtual xml_streamt &new_xml_stream(
+    unsigned level,
+    const std::string &name,
+    const xmlt::attributest &attributes = {});
+
+  /// Close the element started by \ref new_xml_stream, if any, and output
+  /// the messages that were printed while it was open
+  void close_xml_stream();
+
 protected:
   std::unique_ptr<console_message_handlert> console_message_handler;
   message_handlert *message_handler;
@@ -49,6 +70,13 @@ protected:
   std::unique_ptr<const timestampert> time;
   std::ostream &out;
   std::unique_ptr<json_stream_arrayt> json_stream;
+  std::unique_ptr<xml_streamt> xml_stream;
+  /// Whether the element of \ref xml_stream is written to \ref out
+  bool xml_stream_output = false;
+  /// Sink for the elements whose level exceeds the verbosity
+  std::unique_ptr<std::ostream> discarded_output;
+  /// XML messages printed while \ref xml_stream was open
+  std::vector<xmlt> deferred_xml;
 
   ui_message_handlert(
     message_handlert *,
@@ -91,6 +119,8 @@ protected:
 
   const char *level_string(unsigned level);
 
+  void output_xml(const xmlt &xml);
+
   std::string command(unsigned c) const override
   {
     if(message_handler)
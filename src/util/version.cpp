@@ -0,0 +1 @@
+const char *CBMC_VERSION="5.12 (e6f0e3e-dirty)";
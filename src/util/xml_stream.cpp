@@ -0,0 +1,95 @@
+/*******************************************************************\
+
+Module: Streaming XML Output
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Streaming XML Output
+
+#include "xml_stream.h"
+
+#include <ostream>
+
+xml_streamt::xml_streamt(
+  std::ostream &_out,
+  const std::string &_name,
+  const xmlt::attributest &attributes,
+  unsigned _indent)
+  : open(true), out(_out), name(_name), indent(_indent), empty(true)
+{
+  PRECONDITION(!name.empty());
+
+  out << std::string(indent, ' ') << '<' << name;
+
+  for(const auto &attribute : attributes)
+  {
+    if(attribute.first.empty())
+      continue;
+    out << ' ' << attribute.first << '=' << '"';
+    xmlt::escape_attribute(attribute.second, out);
+    out << '"';
+  }
+}
+
+void xml_streamt::output_content_start()
+{
+  if(empty)
+  {
+    out << '>' << '\n';
+    empty = false;
+  }
+}
+
+void xml_streamt::output_child_stream()
+{
+  if(!element.name.empty())
+  {
+    output_content_start();
+    element.output(out, indent + 2);
+    element.clear();
+  }
+
+  if(child_stream)
+  {
+    child_stream->close();
+    child_stream = nullptr;
+  }
+}
+
+void xml_streamt::push_back(const xmlt &xml)
+{
+  PRECONDITION(open);
+  output_child_stream();
+  output_content_start();
+  xml.output(out, indent + 2);
+}
+
+xml_streamt &xml_streamt::push_back_stream(
+  const std::string &key,
+  const xmlt::attributest &attributes)
+{
+  PRECONDITION(open);
+  output_child_stream();
+  output_content_start();
+  child_stream = std::unique_ptr<xml_streamt>(
+    new xml_streamt(out, key, attributes, indent + 2));
+  return *child_stream;
+}
+
+void xml_streamt::close()
+{
+  if(!open)
+    return;
+
+  output_child_stream();
+
+  if(empty)
+    out << "/>" << '\n';
+  else
+    out << std::string(indent, ' ') << '<' << '/' << name << '>' << '\n';
+
+  open = false;
+}
@@ -0,0 +1,103 @@
+/*******************************************************************\
+
+Module: Streaming XML Output
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Streaming XML Output
+
+#ifndef CPROVER_UTIL_XML_STREAM_H
+#define CPROVER_UTIL_XML_STREAM_H
+
+#include <iosfwd>
+#include <memory>
+
+#include "invariant.h"
+#include "xml.h"
+
+/// This class provides a facility for streaming an XML element directly to
+/// the output instead of waiting for the whole tree to be formed in memory
+/// and then printing it (as done using `xmlt`), in the same way as
+/// `json_stream_arrayt` does for JSON. The output is identical to that of
+/// `xmlt::output` for an element with the same attributes and children.
+///
+/// The start tag is written when the stream is created. Children are either
+/// non-streaming `xmlt` elements, which are printed as a whole, or child
+/// streams. As for JSON streams, there is at most one child stream at any
+/// time: adding a child flushes and closes the current child stream.
+class xml_streamt
+{
+public:
+  /// Write the start of the element
+  /// \param out: output stream
+  /// \param name: tag of the element, which must not be empty
+  /// \param attributes: attributes of the element
+  /// \param indent: indentation, in spaces, as for `xmlt::output`
+  xml_streamt(
+    std::ostream &out,
+    const std::string &name,
+    const xmlt::attributest &attributes = {},
+    unsigned indent = 0);
+
+  /// Flushes and closes the stream on destruction
+  ~xml_streamt()
+  {
+    close();
+  }
+
+  /// Print a non-streaming child element
+  /// \param xml: the child element
+  void push_back(const xmlt &xml);
+
+  /// Add a new non-streaming child element, which is printed once the next
+  /// child is added or the stream is closed.
+  /// Provided for compatibility with `xmlt`.
+  /// \param key: tag of the new element
+  /// \return the new element
+  xmlt &new_element(const std::string &key)
+  {
+    PRECONDITION(open);
+    output_child_stream();
+    element = xmlt(key);
+    return element;
+  }
+
+  /// Add a child element that is itself written incrementally
+  /// \param key: tag of the new element
+  /// \param attributes: attributes of the new element
+  /// \return the stream for the new element
+  xml_streamt &push_back_stream(
+    const std::string &key,
+    const xmlt::attributest &attributes = {});
+
+  /// Outputs the current child and writes the end of the element
+  void close();
+
+protected:
+  /// Denotes whether the current stream is open or has been closed
+  bool open;
+  std::ostream &out;
+  const std::string name;
+  const unsigned indent;
+
+  /// Has anything been written inside the element? If not, it is closed as
+  /// an empty-element tag.
+  bool empty;
+
+  /// The non-streaming child added by `new_element`, if its name is set
+  xmlt element;
+
+  /// The current child stream
+  std::unique_ptr<xml_streamt> child_stream;
+
+  /// Finish the start tag before writing the first child
+  void output_content_start();
+
+  /// Outputs the non-streaming child and closes the current child stream
+  void output_child_stream();
+};
+
+#endif // CPROVER_UTIL_XML_STREAM_H
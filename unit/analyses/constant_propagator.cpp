@@ -94,6 +94,21 @@ SCENARIO("constant_propagator", "[core][analyses][constant_propagator]")
       }
     }
 
+    WHEN("We apply constant propagation using a simplifier cache")
+    {
+      constant_propagator_ait constant_propagator(main_function);
+      constant_propagator.enable_simplify_cache(ns, 100);
+      constant_propagator(main_function_symbol.name, main_function, ns);
+
+      THEN("The propagator should discover values for both 'x' and 'y'")
+      {
+        const auto &final_domain = constant_propagator[test_instruction];
+
+        REQUIRE(final_domain.values.is_constant(local_x.symbol_expr()));
+        REQUIRE(final_domain.values.is_constant(local_y.symbol_expr()));
+      }
+    }
+
     WHEN("We apply constant propagation for symbols beginning with 'x'")
     {
       constant_propagator_ait constant_propagator(main_function, starts_with_x);
@@ -8,7 +8,9 @@ Author: Daniel Kroening
 
 #include <testing-utils/use_catch.h>
 
+#include <limits>
 #include <string>
+#include <utility>
 
 #include <big-int/bigint.hh>
 
@@ -254,3 +256,87 @@ TEST_CASE("arbitrary precision integers", "[core][big-int][bigint]")
     REQUIRE(N.floorPow2() == 1);
   }
 }
+
+TEST_CASE(
+  "arbitrary precision integers near the machine word boundary",
+  "[core][big-int][bigint]")
+{
+  SECTION("overflow of small values")
+  {
+    BigInt max(std::numeric_limits<long long>::max());
+    BigInt min(std::numeric_limits<long long>::min());
+
+    REQUIRE(to_string(max + 1) == "9223372036854775808");
+    REQUIRE(to_string(min - 1) == "-9223372036854775809");
+    REQUIRE(to_string(min) == "-9223372036854775808");
+    REQUIRE(to_string(max * max) == "85070591730234615847396907784232501249");
+    REQUIRE(to_string(min * -1) == "9223372036854775808");
+    REQUIRE(to_string(max * 2 - max) == "9223372036854775807");
+    REQUIRE((min + max).is_negative());
+    REQUIRE(BigInt(-5) * 0 == 0);
+    REQUIRE((BigInt(-5) * 0).is_positive());
+  }
+
+  SECTION("swapping and moving small and large values")
+  {
+    BigInt small(42);
+    BigInt large("123456789012345678901234567890");
+
+    small.swap(large);
+    REQUIRE(to_string(small) == "123456789012345678901234567890");
+    REQUIRE(large == 42);
+
+    large.swap(small);
+    REQUIRE(small == 42);
+    REQUIRE(to_string(large) == "123456789012345678901234567890");
+
+    BigInt other(-7);
+    small.swap(other);
+    REQUIRE(small == -7);
+    REQUIRE(other == 42);
+
+    BigInt moved(std::move(large));
+    REQUIRE(to_string(moved) == "123456789012345678901234567890");
+
+    moved = std::move(other);
+    REQUIRE(moved == 42);
+
+    BigInt copy(moved);
+    copy += 1;
+    REQUIRE(copy == 43);
+    REQUIRE(moved == 42);
+  }
+}
+
+// Not run by default; use `unit "[benchmark]"` to measure.
+TEST_CASE("arbitrary precision integer benchmarks", "[.][benchmark][big-int]")
+{
+  // The pattern of pointer_offset_bits: sizes of (nested) struct members
+  // multiplied by array lengths and summed up.
+  BENCHMARK("pointer offsets")
+  {
+    BigInt result = 0;
+    for(int i = 0; i < 100000; ++i)
+    {
+      BigInt member_bits(32);
+      member_bits *= BigInt(i % 16 + 1);
+      result += member_bits;
+    }
+    REQUIRE(result == 27200000);
+  }
+
+  // The pattern of to_integer/numeric_cast on constants of bit-vector type:
+  // construct from an elementary type, compare, convert back.
+  BENCHMARK("constant conversion")
+  {
+    long long sum = 0;
+    for(int i = 0; i < 100000; ++i)
+    {
+      BigInt value(i);
+      value -= 1;
+      if(value.is_long() && value < BigInt(1000000))
+        sum += value.to_long();
+    }
+    REQUIRE(sum == 4999850000);
+  }
+}
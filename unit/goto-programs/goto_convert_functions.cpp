@@ -0,0 +1,158 @@
+/*******************************************************************\
+
+Module: Unit tests for goto_convert_functionst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/require_goto_model.h>
+#include <testing-utils/use_catch.h>
+
+#include <goto-programs/goto_convert_functions.h>
+
+#include <util/c_types.h>
+#include <util/std_code.h>
+
+#include <algorithm>
+#include <set>
+
+/// Add functions whose conversion introduces temporary symbols, with names
+/// starting with \p prefix, and with \p repetitions of their statements
+static void add_functions(
+  symbol_tablet &symbol_table,
+  const std::string &prefix = "f",
+  std::size_t repetitions = 1)
+{
+  for(std::size_t i = 0; i < 20; ++i)
+  {
+    const std::string function_name = prefix + std::to_string(i);
+
+    symbolt x;
+    x.name = function_name + "::x";
+    x.base_name = "x";
+    x.type = signed_int_type();
+    x.mode = ID_C;
+
+    symbolt y;
+    y.name = function_name + "::y";
+    y.base_name = "y";
+    y.type = signed_int_type();
+    y.mode = ID_C;
+
+    // y = x++; x = y++; ...
+    side_effect_exprt x_increment(
+      ID_postincrement, x.type, source_locationt());
+    x_increment.add_to_operands(x.symbol_expr());
+    side_effect_exprt y_increment(
+      ID_postincrement, y.type, source_locationt());
+    y_increment.add_to_operands(y.symbol_expr());
+
+    symbolt function;
+    function.name = function_name;
+    function.base_name = function_name;
+    function.type = code_typet({}, empty_typet());
+    function.mode = ID_C;
+    code_blockt body{
+      {code_declt(x.symbol_expr()), code_declt(y.symbol_expr())}};
+    for(std::size_t r = 0; r < repetitions; ++r)
+    {
+      body.add(code_assignt(y.symbol_expr(), x_increment));
+      body.add(code_assignt(x.symbol_expr(), y_increment));
+    }
+    function.value = std::move(body);
+
+    symbol_table.add(x);
+    symbol_table.add(y);
+    symbol_table.add(function);
+  }
+}
+
+SCENARIO("goto_convert_functions", "[core][goto-programs][goto_convert]")
+{
+  GIVEN("A symbol table with functions that need temporaries")
+  {
+    symbol_tablet sequential_symbol_table;
+    add_functions(sequential_symbol_table);
+    symbol_tablet parallel_symbol_table = sequential_symbol_table;
+
+    WHEN("Converting the functions sequentially and in parallel")
+    {
+      goto_functionst sequential_functions;
+      goto_convert(
+        sequential_symbol_table, sequential_functions, null_message_handler);
+
+      goto_functionst parallel_functions;
+      goto_convert(
+        parallel_symbol_table, parallel_functions, null_message_handler, 4);
+
+      THEN("Temporaries have been added")
+      {
+        REQUIRE(sequential_symbol_table.symbols.size() > 60);
+      }
+
+      THEN("The goto programs are the same")
+      {
+        require_same_goto_functions(parallel_functions, sequential_functions);
+      }
+
+      THEN("The symbol tables are the same, in the same order")
+      {
+        REQUIRE(
+          symbol_names(parallel_symbol_table) ==
+          symbol_names(sequential_symbol_table));
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "goto_convert_functions interns names in function order",
+  "[core][goto-programs][goto_convert]")
+{
+  GIVEN("Functions whose names have not been interned by another test")
+  {
+    // long enough for the conversions to run concurrently
+    symbol_tablet symbol_table;
+    add_functions(symbol_table, "goto_convert_functions_interning_f", 200);
+    const symbol_tablet original_symbol_table = symbol_table;
+
+    WHEN("Converting the functions in parallel first")
+    {
+      goto_functionst functions;
+      goto_convert(symbol_table, functions, null_message_handler, 4);
+
+      THEN("The names of the temporaries are numbered function by function")
+      {
+        std::vector<irep_idt> added_names;
+        for(const auto &symbol_pair : symbol_table.symbols)
+        {
+          if(!original_symbol_table.has_symbol(symbol_pair.first))
+            added_names.push_back(symbol_pair.first);
+        }
+        REQUIRE(added_names.size() > 20);
+
+        // dstringt orders by the number of the string
+        std::sort(added_names.begin(), added_names.end());
+
+        std::vector<std::string> functions_in_number_order;
+        for(const auto &name : added_names)
+        {
+          const std::string function =
+            id2string(name).substr(0, id2string(name).find("::"));
+          if(
+            functions_in_number_order.empty() ||
+            functions_in_number_order.back() != function)
+          {
+            functions_in_number_order.push_back(function);
+          }
+        }
+
+        const std::set<std::string> distinct_functions(
+          functions_in_number_order.begin(), functions_in_number_order.end());
+        REQUIRE(distinct_functions.size() == functions_in_number_order.size());
+      }
+    }
+  }
+}
@@ -0,0 +1,274 @@
+/*******************************************************************\
+
+Module: Unit tests for indexed goto binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/std_types.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/indexed_goto_binary.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+static void add_function(goto_modelt &goto_model, const irep_idt &name)
+{
+  const signedbv_typet int_type(32);
+
+  symbolt fun_symbol;
+  fun_symbol.name = name;
+  fun_symbol.base_name = name;
+  fun_symbol.type = code_typet({}, empty_typet());
+  goto_model.symbol_table.insert(fun_symbol);
+
+  symbolt var_symbol;
+  var_symbol.name = id2string(name) + "::x";
+  var_symbol.type = int_type;
+  goto_model.symbol_table.insert(var_symbol);
+
+  const symbol_exprt x = var_symbol.symbol_expr();
+
+  goto_functiont &function = goto_model.goto_functions.function_map[name];
+  function.type = to_code_type(fun_symbol.type);
+
+  goto_programt &body = function.body;
+  auto loop = body.add(goto_programt::make_assignment(
+    code_assignt(x, from_integer(1, int_type))));
+  body.add(goto_programt::make_assertion(
+    binary_relation_exprt(x, ID_le, from_integer(10, int_type))));
+  body.add(goto_programt::make_goto(loop, true_exprt()));
+  body.add(goto_programt::make_end_function());
+  body.update();
+}
+
+static void require_same_function(
+  const goto_functiont &function,
+  const goto_functiont &expected)
+{
+  REQUIRE(function.type == expected.type);
+  REQUIRE(
+    function.body.instructions.size() == expected.body.instructions.size());
+
+  auto it = function.body.instructions.begin();
+  for(const auto &instruction : expected.body.instructions)
+  {
+    REQUIRE(it->type == instruction.type);
+    REQUIRE(it->code == instruction.code);
+    REQUIRE(it->guard == instruction.guard);
+    REQUIRE(it->targets.size() == instruction.targets.size());
+    if(instruction.is_goto())
+      REQUIRE(it->get_target() == function.body.instructions.begin());
+    ++it;
+  }
+}
+
+SCENARIO(
+  "Reading and writing indexed goto binaries",
+  "[core][goto-programs][indexed_goto_binary]")
+{
+  GIVEN("A goto model with two functions")
+  {
+    goto_modelt goto_model;
+    add_function(goto_model, "f");
+    add_function(goto_model, "g");
+
+    // a function without body
+    symbolt h_symbol;
+    h_symbol.name = "h";
+    h_symbol.type = code_typet({}, empty_typet());
+    goto_model.symbol_table.insert(h_symbol);
+
+    std::ostringstream out;
+    REQUIRE_FALSE(write_indexed_goto_binary(
+      out, goto_model.symbol_table, goto_model.goto_functions));
+    const std::string contents = out.str();
+
+    WHEN("The binary is loaded from memory")
+    {
+      indexed_goto_binaryt goto_binary;
+      goto_binary.load(std::vector<char>(contents.begin(), contents.end()));
+
+      THEN("Only functions with body are indexed")
+      {
+        REQUIRE(goto_binary.has_function("f"));
+        REQUIRE(goto_binary.has_function("g"));
+        REQUIRE_FALSE(goto_binary.has_function("h"));
+      }
+
+      THEN("Functions can be read individually")
+      {
+        symbol_tablet symbol_table;
+        goto_binary.read_symbol_table(symbol_table);
+        REQUIRE(symbol_table.symbols.size() == 5);
+
+        goto_functiont g;
+        goto_binary.read_function("g", symbol_table, g);
+        require_same_function(g, goto_model.goto_functions.function_map["g"]);
+      }
+
+      THEN("Reading an unknown function fails")
+      {
+        symbol_tablet symbol_table;
+        goto_binary.read_symbol_table(symbol_table);
+
+        goto_functiont h;
+        REQUIRE_THROWS_AS(
+          goto_binary.read_function("h", symbol_table, h),
+          deserialization_exceptiont);
+      }
+
+      THEN("Reading a function without symbol fails")
+      {
+        symbol_tablet symbol_table;
+        goto_functiont f;
+        REQUIRE_THROWS_AS(
+          goto_binary.read_function("f", symbol_table, f),
+          deserialization_exceptiont);
+      }
+
+      THEN("The whole model can be read")
+      {
+        goto_modelt result;
+        goto_binary.read(result.symbol_table, result.goto_functions);
+
+        REQUIRE(result.goto_functions.function_map.size() == 3);
+        REQUIRE_FALSE(result.goto_functions.function_map["h"].body_available());
+        require_same_function(
+          result.goto_functions.function_map["f"],
+          goto_model.goto_functions.function_map["f"]);
+      }
+    }
+
+    WHEN("The binary is read as a goto object")
+    {
+      std::istringstream in(contents);
+      goto_modelt result;
+      null_message_handlert message_handler;
+
+      REQUIRE_FALSE(read_bin_goto_object(
+        in, "", result.symbol_table, result.goto_functions, message_handler));
+
+      THEN("All functions are read")
+      {
+        REQUIRE(result.symbol_table.symbols.size() == 5);
+        require_same_function(
+          result.goto_functions.function_map["g"],
+          goto_model.goto_functions.function_map["g"]);
+      }
+    }
+
+    WHEN("The binary is mapped from a file")
+    {
+      temporary_filet file("indexed_goto_binary", ".gb");
+      {
+        std::ofstream file_out(file(), std::ios::binary);
+        file_out << contents;
+      }
+
+      REQUIRE(indexed_goto_binaryt::is_indexed_goto_binary(file()));
+
+      indexed_goto_binaryt goto_binary;
+      goto_binary.open(file());
+
+      THEN("Functions can be read individually")
+      {
+        symbol_tablet symbol_table;
+        goto_binary.read_symbol_table(symbol_table);
+
+        goto_functiont f;
+        goto_binary.read_function("f", symbol_table, f);
+        require_same_function(f, goto_model.goto_functions.function_map["f"]);
+      }
+    }
+
+    WHEN("The binary is written with compressed sections")
+    {
+      std::ostringstream compressed_out;
+      REQUIRE_FALSE(write_indexed_goto_binary(
+        compressed_out,
+        goto_model.symbol_table,
+        goto_model.goto_functions,
+        true));
+      const std::string compressed = compressed_out.str();
+
+      indexed_goto_binaryt goto_binary;
+      goto_binary.load(std::vector<char>(compressed.begin(), compressed.end()));
+
+      THEN("Functions can be read individually")
+      {
+        symbol_tablet symbol_table;
+        goto_binary.read_symbol_table(symbol_table);
+        REQUIRE(symbol_table.symbols.size() == 5);
+
+        goto_functiont f;
+        goto_binary.read_function("f", symbol_table, f);
+        require_same_function(f, goto_model.goto_functions.function_map["f"]);
+      }
+
+      THEN("A corrupted section is rejected")
+      {
+        std::vector<char> corrupted(compressed.begin(), compressed.end());
+        // flip a bit in the checksum of the last section
+        corrupted.back() ^= 1;
+        indexed_goto_binaryt corrupted_binary;
+        corrupted_binary.load(corrupted);
+
+        goto_modelt result;
+        REQUIRE_THROWS_AS(
+          corrupted_binary.read(result.symbol_table, result.goto_functions),
+          deserialization_exceptiont);
+      }
+    }
+
+    WHEN("A compressed block claims an implausible uncompressed size")
+    {
+      std::ostringstream bogus_out;
+      bogus_out << char(0x7f) << "GBI";
+      write_gb_word(bogus_out, GOTO_BINARY_VERSION);
+      write_gb_word(bogus_out, indexed_goto_binaryt::compressed_flag);
+      // symbol table block of one byte expanding to a gigabyte
+      write_gb_word(bogus_out, 0);
+      write_gb_word(bogus_out, 1);
+      write_gb_word(bogus_out, std::size_t(1) << 30);
+      // no functions
+      write_gb_word(bogus_out, 0);
+      bogus_out << char(0);
+      const std::string bogus = bogus_out.str();
+
+      indexed_goto_binaryt goto_binary;
+
+      THEN("Loading fails")
+      {
+        REQUIRE_THROWS_AS(
+          goto_binary.load(std::vector<char>(bogus.begin(), bogus.end())),
+          deserialization_exceptiont);
+      }
+    }
+
+    WHEN("The binary is truncated")
+    {
+      const std::string truncated = contents.substr(0, contents.size() / 2);
+      indexed_goto_binaryt goto_binary;
+
+      THEN("Loading fails")
+      {
+        REQUIRE_THROWS_AS(
+          goto_binary.load(
+            std::vector<char>(truncated.begin(), truncated.end())),
+          deserialization_exceptiont);
+      }
+    }
+  }
+}
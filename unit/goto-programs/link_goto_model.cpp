@@ -0,0 +1,199 @@
+/*******************************************************************\
+
+Module: Unit tests for link_goto_model
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/require_goto_model.h>
+#include <testing-utils/require_vectors_equal_unordered.h>
+#include <testing-utils/use_catch.h>
+
+#include <goto-programs/goto_convert_functions.h>
+#include <goto-programs/link_goto_model.h>
+#include <goto-programs/read_goto_binary.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/prefix.h>
+#include <util/std_code.h>
+#include <util/tempfile.h>
+
+#include <set>
+
+/// Build a goto model like one compiled from a file with a static function
+/// `helper` returning \p i, a function `f<i>` calling `helper` and `common`,
+/// and a declaration of `common`, which only the last of \p number_of_models
+/// models defines
+static goto_modelt build_goto_model(std::size_t i, std::size_t number_of_models)
+{
+  goto_modelt goto_model;
+  symbol_tablet &symbol_table = goto_model.symbol_table;
+  const code_typet int_function_type({}, signed_int_type());
+  const std::string module = "object" + std::to_string(i);
+
+  symbolt helper;
+  helper.name = "helper";
+  helper.base_name = "helper";
+  helper.module = module;
+  helper.type = int_function_type;
+  helper.mode = ID_C;
+  helper.is_file_local = true;
+  helper.value =
+    code_blockt{{code_returnt(from_integer(i, signed_int_type()))}};
+  symbol_table.add(helper);
+
+  symbolt common;
+  common.name = "common";
+  common.base_name = "common";
+  common.module = module;
+  common.type = int_function_type;
+  common.mode = ID_C;
+  if(i + 1 == number_of_models)
+  {
+    common.value =
+      code_blockt{{code_returnt(from_integer(0, signed_int_type()))}};
+  }
+  symbol_table.add(common);
+
+  symbolt function;
+  function.name = "f" + std::to_string(i);
+  function.base_name = function.name;
+  function.module = module;
+  function.type = int_function_type;
+  function.mode = ID_C;
+  function.value = code_blockt{
+    {code_function_callt(common.symbol_expr()),
+     code_returnt(side_effect_expr_function_callt(
+       helper.symbol_expr(), {}, signed_int_type(), source_locationt()))}};
+  symbol_table.add(function);
+
+  goto_convert(goto_model, null_message_handler);
+
+  return goto_model;
+}
+
+static std::vector<goto_modelt> build_goto_models(std::size_t n)
+{
+  std::vector<goto_modelt> goto_models;
+  goto_models.reserve(n);
+  for(std::size_t i = 0; i < n; ++i)
+    goto_models.push_back(build_goto_model(i, n));
+  return goto_models;
+}
+
+SCENARIO("read_objects_and_link", "[core][goto-programs][link_goto_model]")
+{
+  GIVEN("Goto binaries of several objects with conflicting static functions")
+  {
+    const std::size_t n = 11;
+    std::vector<goto_modelt> goto_models = build_goto_models(n);
+    std::vector<temporary_filet> files;
+    std::vector<std::string> file_names;
+    for(const auto &goto_model : goto_models)
+    {
+      files.emplace_back("link_goto_model", ".gb");
+      file_names.push_back(files.back()());
+      REQUIRE_FALSE(write_goto_binary(
+        file_names.back(), goto_model, null_message_handler));
+    }
+
+    WHEN("Reading and linking them with one and with several jobs")
+    {
+      goto_modelt sequential_dest;
+      REQUIRE_FALSE(read_objects_and_link(
+        file_names, sequential_dest, null_message_handler, 1));
+      goto_modelt parallel_dest;
+      REQUIRE_FALSE(read_objects_and_link(
+        file_names, parallel_dest, null_message_handler, 4));
+
+      THEN("All functions are linked and the static ones are renamed")
+      {
+        const auto &function_map = sequential_dest.goto_functions.function_map;
+        std::set<irep_idt> called_helpers;
+
+        for(std::size_t i = 0; i < n; ++i)
+        {
+          const auto f_it = function_map.find("f" + std::to_string(i));
+          REQUIRE(f_it != function_map.end());
+
+          for(const auto &instruction : f_it->second.body.instructions)
+          {
+            if(!instruction.is_function_call())
+              continue;
+
+            const irep_idt &callee =
+              to_symbol_expr(instruction.get_function_call().function())
+                .get_identifier();
+            if(has_prefix(id2string(callee), "helper"))
+            {
+              REQUIRE(function_map.at(callee).body_available());
+              called_helpers.insert(callee);
+            }
+          }
+        }
+
+        REQUIRE(called_helpers.size() == n);
+        REQUIRE(function_map.at("common").body_available());
+      }
+
+      THEN("The result does not depend on the number of jobs")
+      {
+        require_vectors_equal_unordered(
+          symbol_names(parallel_dest.symbol_table),
+          symbol_names(sequential_dest.symbol_table));
+        require_same_goto_functions(
+          parallel_dest.goto_functions, sequential_dest.goto_functions);
+      }
+    }
+
+    WHEN("One of the files cannot be read")
+    {
+      file_names[n / 2] += ".missing";
+
+      THEN("Reading and linking fails with one and with several jobs")
+      {
+        goto_modelt sequential_dest;
+        REQUIRE(read_objects_and_link(
+          file_names, sequential_dest, null_message_handler, 1));
+        goto_modelt parallel_dest;
+        REQUIRE(read_objects_and_link(
+          file_names, parallel_dest, null_message_handler, 4));
+      }
+    }
+  }
+}
+
+// Not run by default; use `unit "[benchmark]"` to measure.
+TEST_CASE("link_goto_models benchmarks", "[.][benchmark][link_goto_model]")
+{
+  const std::size_t n = 5000;
+  std::vector<goto_modelt> one_by_one = build_goto_models(n);
+  std::vector<goto_modelt> tree = build_goto_models(n);
+  std::vector<goto_modelt> parallel_tree = build_goto_models(n);
+
+  BENCHMARK("link 5000 objects one by one")
+  {
+    goto_modelt dest;
+    for(auto &goto_model : one_by_one)
+      link_goto_model(dest, goto_model, null_message_handler);
+    REQUIRE(dest.goto_functions.function_map.size() == 2 * n + 1);
+  }
+
+  BENCHMARK("link 5000 objects in a tree")
+  {
+    goto_modelt dest;
+    link_goto_models(dest, tree, null_message_handler);
+    REQUIRE(dest.goto_functions.function_map.size() == 2 * n + 1);
+  }
+
+  BENCHMARK("link 5000 objects in a tree using 4 jobs")
+  {
+    goto_modelt dest;
+    link_goto_models(dest, parallel_tree, null_message_handler, 4);
+    REQUIRE(dest.goto_functions.function_map.size() == 2 * n + 1);
+  }
+}
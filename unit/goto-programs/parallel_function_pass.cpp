@@ -0,0 +1,191 @@
+/*******************************************************************\
+
+Module: Unit tests for running passes over goto functions in parallel
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/require_goto_model.h>
+#include <testing-utils/use_catch.h>
+
+#include <goto-programs/adjust_float_expressions.h>
+#include <goto-programs/goto_convert_functions.h>
+#include <goto-programs/parallel_function_pass.h>
+#include <goto-programs/remove_complex.h>
+#include <goto-programs/remove_returns.h>
+#include <goto-programs/remove_skip.h>
+#include <goto-programs/remove_vector.h>
+#include <goto-programs/rewrite_union.h>
+#include <goto-programs/set_properties.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_code.h>
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+
+/// Build functions f0, f1, ... that call a function g with a body and a
+/// function h without one, and then assert and return the results
+static void build_goto_model(goto_modelt &goto_model)
+{
+  symbol_tablet &symbol_table = goto_model.symbol_table;
+  const code_typet int_function_type({}, signed_int_type());
+
+  symbolt g;
+  g.name = "g";
+  g.base_name = "g";
+  g.type = int_function_type;
+  g.mode = ID_C;
+  g.value = code_blockt{{code_returnt(from_integer(1, signed_int_type()))}};
+  symbol_table.add(g);
+
+  symbolt h;
+  h.name = "h";
+  h.base_name = "h";
+  h.type = int_function_type;
+  h.mode = ID_C;
+  symbol_table.add(h);
+
+  for(int i = 0; i < 20; ++i)
+  {
+    const std::string function_name = "f" + std::to_string(i);
+
+    symbolt x;
+    x.name = function_name + "::x";
+    x.base_name = "x";
+    x.type = signed_int_type();
+    x.mode = ID_C;
+    symbol_table.add(x);
+
+    // x = g(); assert(x != i); x = h(); assert(x != i); return x;
+    source_locationt assertion_location;
+    assertion_location.set_function(function_name);
+    assertion_location.set_property_class("assertion");
+    code_assertt assert_x_is_not_i(
+      notequal_exprt(x.symbol_expr(), from_integer(i, signed_int_type())));
+    assert_x_is_not_i.add_source_location() = assertion_location;
+
+    symbolt function;
+    function.name = function_name;
+    function.base_name = function_name;
+    function.type = int_function_type;
+    function.mode = ID_C;
+    function.value = code_blockt{
+      {code_declt(x.symbol_expr()),
+       code_function_callt(x.symbol_expr(), g.symbol_expr(), {}),
+       assert_x_is_not_i,
+       code_skipt(),
+       code_function_callt(x.symbol_expr(), h.symbol_expr(), {}),
+       assert_x_is_not_i,
+       code_returnt(x.symbol_expr())}};
+    symbol_table.add(function);
+  }
+
+  goto_convert(goto_model, null_message_handler);
+}
+
+static void process_goto_model(goto_modelt &goto_model, std::size_t jobs)
+{
+  remove_returns(goto_model, jobs);
+  remove_vector(goto_model, jobs);
+  remove_complex(goto_model, jobs);
+  rewrite_union(goto_model, jobs);
+  adjust_float_expressions(goto_model, jobs);
+  goto_model.goto_functions.update();
+  remove_skip(goto_model, jobs);
+  label_properties(goto_model);
+}
+
+static std::set<irep_idt> property_ids(const goto_functionst &goto_functions)
+{
+  std::set<irep_idt> ids;
+  for(const auto &function : goto_functions.function_map)
+  {
+    for(const auto &instruction : function.second.body.instructions)
+    {
+      if(instruction.is_assert())
+        ids.insert(instruction.source_location.get_property_id());
+    }
+  }
+  return ids;
+}
+
+SCENARIO("parallel_function_pass", "[core][goto-programs][parallel]")
+{
+  GIVEN("A goto model with many functions")
+  {
+    goto_modelt goto_model;
+    build_goto_model(goto_model);
+
+    WHEN("Running a pass over all functions")
+    {
+      std::vector<irep_idt> visited(
+        goto_model.goto_functions.function_map.size());
+      std::atomic<std::size_t> next{0};
+
+      parallel_function_pass(
+        goto_model.goto_functions,
+        4,
+        [&visited, &next](
+          const irep_idt &function_id, goto_functionst::goto_functiont &) {
+          visited[next++] = function_id;
+        });
+
+      THEN("Each function is visited exactly once")
+      {
+        std::sort(visited.begin(), visited.end());
+        std::vector<irep_idt> expected;
+        for(const auto &function : goto_model.goto_functions.function_map)
+          expected.push_back(function.first);
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(visited == expected);
+      }
+    }
+  }
+
+  GIVEN("Two copies of a goto model")
+  {
+    goto_modelt sequential_model;
+    build_goto_model(sequential_model);
+    goto_modelt parallel_model;
+    build_goto_model(parallel_model);
+
+    WHEN("Processing one sequentially and one with several jobs")
+    {
+      process_goto_model(sequential_model, 1);
+      process_goto_model(parallel_model, 4);
+
+      THEN("Return values have been removed")
+      {
+        REQUIRE(sequential_model.symbol_table.has_symbol("g#return_value"));
+        REQUIRE(sequential_model.symbol_table.has_symbol("f0#return_value"));
+      }
+
+      THEN("The symbol tables and goto programs are the same")
+      {
+        REQUIRE(
+          symbol_names(parallel_model.symbol_table) ==
+          symbol_names(sequential_model.symbol_table));
+        require_same_goto_functions(
+          parallel_model.goto_functions, sequential_model.goto_functions);
+      }
+
+      THEN("Each assertion is labelled with a property id of its own")
+      {
+        std::set<irep_idt> expected;
+        for(int i = 0; i < 20; ++i)
+        {
+          const std::string function_name = "f" + std::to_string(i);
+          expected.insert(function_name + ".assertion.1");
+          expected.insert(function_name + ".assertion.2");
+        }
+
+        REQUIRE(property_ids(parallel_model.goto_functions) == expected);
+      }
+    }
+  }
+}
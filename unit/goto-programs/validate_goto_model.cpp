@@ -0,0 +1,164 @@
+/*******************************************************************\
+
+Module: Unit tests for parallel and incremental goto model validation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <testing-utils/message.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_types.h>
+#include <util/std_code.h>
+#include <util/validate.h>
+
+#include <goto-programs/goto_convert_functions.h>
+#include <goto-programs/goto_model.h>
+#include <goto-programs/validate_goto_model.h>
+
+/// Add a function `name` declaring a local `name_x`, assigning to it and
+/// asserting its value
+static void add_function(symbol_tablet &symbol_table, const std::string &name)
+{
+  symbolt x;
+  x.name = name + "_x";
+  x.mode = ID_C;
+  x.type = signed_int_type();
+  symbol_table.add(x);
+
+  symbolt f;
+  f.name = name;
+  f.mode = ID_C;
+  f.type = code_typet({}, empty_typet());
+  f.value = code_blockt{
+    {code_declt(x.symbol_expr()),
+     code_assignt(x.symbol_expr(), from_integer(1, signed_int_type())),
+     code_assertt(
+       equal_exprt(x.symbol_expr(), from_integer(1, signed_int_type())))}};
+  symbol_table.add(f);
+}
+
+SCENARIO(
+  "Parallel and incremental goto model validation",
+  "[core][goto-programs][validate]")
+{
+  goto_modelt goto_model;
+  for(const std::string name : {"f", "g", "h", "i"})
+    add_function(goto_model.symbol_table, name);
+  goto_convert(goto_model, null_message_handler);
+
+  goto_model_validation_optionst validation_options{
+    goto_model_validation_optionst::set_optionst::all_false};
+  validation_options.jobs = 4;
+
+  // Make the type of the local of `h` inconsistent with its uses
+  auto break_h = [&goto_model]() {
+    symbolt &h_x = goto_model.symbol_table.get_writeable_ref("h_x");
+    h_x.type = signedbv_typet(64);
+  };
+
+  GIVEN("A well-formed goto model")
+  {
+    THEN("It passes validation using several threads")
+    {
+      REQUIRE_NOTHROW(
+        goto_model.validate(validation_modet::EXCEPTION, validation_options));
+    }
+  }
+
+  GIVEN("A goto model with an ill-formed function")
+  {
+    break_h();
+
+    THEN("Validation using several threads fails")
+    {
+      REQUIRE_THROWS_AS(
+        goto_model.validate(validation_modet::EXCEPTION, validation_options),
+        incorrect_goto_program_exceptiont);
+    }
+  }
+
+  GIVEN("A goto model that passed incremental validation")
+  {
+    incremental_goto_model_validatort validate_incrementally;
+    validate_incrementally(
+      goto_model, validation_modet::EXCEPTION, validation_options);
+
+    WHEN("A symbol that an unchanged function refers to is changed")
+    {
+      break_h();
+
+      THEN("Only a full validation checks that function again")
+      {
+        REQUIRE_NOTHROW(validate_incrementally(
+          goto_model, validation_modet::EXCEPTION, validation_options));
+        REQUIRE_THROWS_AS(
+          goto_model.validate(validation_modet::EXCEPTION, validation_options),
+          incorrect_goto_program_exceptiont);
+      }
+
+      THEN("Incremental validation checks it again once it is changed")
+      {
+        goto_programt &body = goto_model.goto_functions.function_map["h"].body;
+        body.insert_before(
+          body.instructions.begin(), goto_programt::make_skip());
+
+        REQUIRE_THROWS_AS(
+          validate_incrementally(
+            goto_model, validation_modet::EXCEPTION, validation_options),
+          incorrect_goto_program_exceptiont);
+      }
+
+      THEN("Incremental validation checks it again once it is cleared")
+      {
+        validate_incrementally.clear();
+
+        REQUIRE_THROWS_AS(
+          validate_incrementally(
+            goto_model, validation_modet::EXCEPTION, validation_options),
+          incorrect_goto_program_exceptiont);
+      }
+    }
+
+    WHEN("An unchanged function calls another function")
+    {
+      goto_programt &body = goto_model.goto_functions.function_map["f"].body;
+      body.insert_before(
+        body.instructions.begin(),
+        goto_programt::make_function_call(code_function_callt(
+          goto_model.symbol_table.lookup_ref("g").symbol_expr())));
+      validate_incrementally(
+        goto_model, validation_modet::EXCEPTION, validation_options);
+
+      THEN("Its calls are checked once that check is selected")
+      {
+        goto_model.goto_functions.function_map.erase("g");
+        REQUIRE_NOTHROW(validate_incrementally(
+          goto_model, validation_modet::EXCEPTION, validation_options));
+
+        validation_options.check_called_functions = true;
+        REQUIRE_THROWS_AS(
+          validate_incrementally(
+            goto_model, validation_modet::EXCEPTION, validation_options),
+          incorrect_goto_program_exceptiont);
+      }
+
+      THEN("Its calls are checked again once the callee is removed")
+      {
+        validation_options.check_called_functions = true;
+        REQUIRE_NOTHROW(validate_incrementally(
+          goto_model, validation_modet::EXCEPTION, validation_options));
+
+        goto_model.goto_functions.function_map.erase("g");
+        REQUIRE_THROWS_AS(
+          validate_incrementally(
+            goto_model, validation_modet::EXCEPTION, validation_options),
+          incorrect_goto_program_exceptiont);
+      }
+    }
+  }
+}
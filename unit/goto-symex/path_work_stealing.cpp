@@ -0,0 +1,90 @@
+/*******************************************************************\
+
+Module: Unit tests for path_work_poolt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/make_unique.h>
+
+#include <goto-symex/path_work_stealing.h>
+
+#include <thread>
+
+SCENARIO(
+  "Paths are taken from the own deque first and stolen otherwise",
+  "[core][goto-symex][path_work_stealing]")
+{
+  goto_programt goto_program;
+  const auto a = goto_program.add(goto_programt::make_skip());
+  const auto b = goto_program.add(goto_programt::make_skip());
+  const auto c = goto_program.add(goto_programt::make_skip());
+  const auto d = goto_program.add(goto_programt::make_end_function());
+
+  symex_target_equationt equation(null_message_handler);
+  guard_managert guard_manager;
+  const auto make_path = [&](goto_programt::const_targett pc) {
+    goto_symex_statet state(
+      symex_targett::sourcet("main", pc),
+      guard_manager,
+      [](const irep_idt &) { return 1; });
+    return util_make_unique<path_storaget::patht>(equation, state);
+  };
+
+  GIVEN("A pool of two workers in which the first one saved three paths")
+  {
+    path_work_poolt pool(2, true);
+    pool.push(0, *make_path(a));
+    pool.push(0, *make_path(b));
+    pool.push(0, *make_path(c));
+    REQUIRE(pool.size() == 3);
+
+    THEN("The first worker takes its newest path, the second one the oldest")
+    {
+      auto first = pool.take(0);
+      REQUIRE(first);
+      REQUIRE(first->state.source.pc == c);
+
+      auto second = pool.take(1);
+      REQUIRE(second);
+      REQUIRE(second->state.source.pc == a);
+
+      first = pool.take(0);
+      REQUIRE(first);
+      REQUIRE(first->state.source.pc == b);
+      REQUIRE(pool.size() == 0);
+
+      WHEN("The second worker saves a path")
+      {
+        pool.push(1, *make_path(d));
+        second = pool.take(1);
+        REQUIRE(second);
+        REQUIRE(second->state.source.pc == d);
+
+        THEN("Exploration finishes once both workers ask for more paths")
+        {
+          std::unique_ptr<path_storaget::patht> first_result;
+          std::thread first_worker(
+            [&pool, &first_result] { first_result = pool.take(0); });
+          second = pool.take(1);
+          first_worker.join();
+
+          REQUIRE_FALSE(first_result);
+          REQUIRE_FALSE(second);
+        }
+      }
+    }
+
+    THEN("No paths are taken once the pool is stopped")
+    {
+      pool.stop();
+      REQUIRE(pool.is_stopped());
+      REQUIRE_FALSE(pool.take(0));
+      REQUIRE_FALSE(pool.take(1));
+    }
+  }
+}
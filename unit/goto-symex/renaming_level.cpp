@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unit tests for renaming levels
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/std_types.h>
+
+#include <goto-symex/renaming_level.h>
+
+SCENARIO(
+  "Level 1 renaming is restored from a saved map",
+  "[core][goto-symex][renaming_level]")
+{
+  const signedbv_typet int_type(32);
+  const ssa_exprt x{symbol_exprt{"x", int_type}};
+  const ssa_exprt y{symbol_exprt{"y", int_type}};
+  const ssa_exprt z{symbol_exprt{"z", int_type}};
+
+  symex_level1t level1;
+  level1.current_names.insert("x", std::make_pair(x, 1u));
+  level1.current_names.insert("y", std::make_pair(y, 2u));
+
+  GIVEN("A saved map that shares most of its entries with the current one")
+  {
+    symex_renaming_levelt::current_namest old_level1 = level1.current_names;
+
+    level1.current_names.replace("x", std::make_pair(x, 5u));
+    level1.current_names.insert("z", std::make_pair(z, 3u));
+
+    WHEN("Restoring from the saved map")
+    {
+      level1.restore_from(old_level1);
+
+      THEN("Changed entries are reset and other entries are kept")
+      {
+        REQUIRE(level1.current_count("x") == 1);
+        REQUIRE(level1.current_count("y") == 2);
+        REQUIRE(level1.current_count("z") == 3);
+        REQUIRE(level1.current_names.size() == 3);
+      }
+    }
+  }
+
+  GIVEN("A saved map with an entry that is no longer in the current one")
+  {
+    symex_renaming_levelt::current_namest old_level1;
+    old_level1.insert("z", std::make_pair(z, 7u));
+
+    WHEN("Restoring from the saved map")
+    {
+      level1.restore_from(old_level1);
+
+      THEN("The entry is added back")
+      {
+        REQUIRE(level1.current_count("x") == 1);
+        REQUIRE(level1.current_count("z") == 7);
+        REQUIRE(level1.current_count("w") == 0);
+      }
+    }
+  }
+}
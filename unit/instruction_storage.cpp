@@ -0,0 +1,150 @@
+/*******************************************************************\
+
+Module: Benchmarks for the storage of goto program instructions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/config.h>
+#include <util/options.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+#include <analyses/constant_propagator.h>
+
+#include <goto-instrument/full_slicer.h>
+
+#include <goto-programs/goto_convert_functions.h>
+#include <goto-programs/goto_model.h>
+
+#include <goto-symex/goto_symex.h>
+#include <goto-symex/path_storage.h>
+#include <goto-symex/symex_target_equation.h>
+
+/// Build a model in the style of a driver harness: the entry point calls
+/// each of \p functions functions, every one of which runs \p blocks
+/// conditional updates of a local followed by an assertion. The functions are
+/// converted by goto_convert, so their instructions are allocated in between
+/// the expressions of the program, as they are for programs read from source.
+static goto_modelt make_harness(std::size_t functions, std::size_t blocks)
+{
+  goto_modelt goto_model;
+  const code_typet void_function_type({}, empty_typet());
+  const typet int_type = signed_int_type();
+  code_blockt entry_point_body;
+
+  for(std::size_t i = 0; i < functions; ++i)
+  {
+    const std::string name = "f" + std::to_string(i);
+
+    symbolt x;
+    x.name = name + "::x";
+    x.base_name = "x";
+    x.mode = ID_C;
+    x.type = int_type;
+    x.is_lvalue = true;
+    x.is_thread_local = true;
+    x.is_file_local = true;
+    goto_model.symbol_table.add(x);
+
+    code_blockt body{{code_declt(x.symbol_expr()),
+                      code_assignt(x.symbol_expr(), from_integer(0, int_type))}};
+    for(std::size_t b = 0; b < blocks; ++b)
+    {
+      body.add(code_ifthenelset(
+        binary_relation_exprt(
+          x.symbol_expr(), ID_le, from_integer(b, int_type)),
+        code_assignt(
+          x.symbol_expr(),
+          plus_exprt(x.symbol_expr(), from_integer(1, int_type)))));
+      body.add(code_assertt(notequal_exprt(
+        x.symbol_expr(), from_integer(-1, int_type))));
+    }
+
+    symbolt f;
+    f.name = name;
+    f.base_name = name;
+    f.mode = ID_C;
+    f.type = void_function_type;
+    f.value = body;
+    goto_model.symbol_table.add(f);
+
+    entry_point_body.add(code_function_callt(f.symbol_expr()));
+  }
+
+  symbolt entry_point;
+  entry_point.name = goto_functionst::entry_point();
+  entry_point.base_name = goto_functionst::entry_point();
+  entry_point.mode = ID_C;
+  entry_point.type = void_function_type;
+  entry_point.value = entry_point_body;
+  goto_model.symbol_table.add(entry_point);
+
+  goto_convert(goto_model, null_message_handler);
+  return goto_model;
+}
+
+// Not run by default; use `unit "[benchmark]"` to measure.
+TEST_CASE(
+  "goto program instruction storage benchmarks",
+  "[.][benchmark][goto-programs]")
+{
+  config.ansi_c.set_LP64();
+  const std::size_t functions = 2000;
+  const std::size_t blocks = 50;
+
+  SECTION("Abstract interpretation")
+  {
+    goto_modelt goto_model = make_harness(functions, blocks);
+    const namespacet ns(goto_model.symbol_table);
+
+    BENCHMARK("constant propagation over all functions")
+    {
+      constant_propagator_ait constant_propagator(goto_model.goto_functions);
+      constant_propagator(goto_model.goto_functions, ns);
+    }
+  }
+
+  SECTION("Symbolic execution")
+  {
+    goto_modelt goto_model = make_harness(functions, blocks);
+    optionst options;
+    options.set_option("propagation", true);
+    options.set_option("simplify", true);
+
+    BENCHMARK("symbolic execution from the entry point")
+    {
+      symex_target_equationt equation(null_message_handler);
+      path_lifot path_storage;
+      guard_managert guard_manager;
+      goto_symext symex(
+        null_message_handler,
+        goto_model.symbol_table,
+        equation,
+        options,
+        path_storage,
+        guard_manager);
+      symbol_tablet new_symbol_table;
+      symex.symex_from_entry_point_of(
+        goto_symext::get_goto_function(goto_model), new_symbol_table);
+      REQUIRE(equation.SSA_steps.size() > functions * blocks);
+    }
+  }
+
+  SECTION("Full slicer")
+  {
+    goto_modelt goto_model = make_harness(functions, blocks);
+
+    BENCHMARK("full slicing with respect to all assertions")
+    {
+      full_slicer(goto_model);
+    }
+  }
+}
@@ -10,6 +10,7 @@ Author: Diffblue Ltd.
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/interpreter_class.h>
+#include <util/arith_tools.h>
 #include <util/message.h>
 #include <util/mp_arith.h>
 #include <util/namespace.h>
@@ -35,8 +36,39 @@ public:
     interpreter.evaluate(expression, result);
     return result;
   }
+
+  mp_integer evaluate_compiled(const interpreter_bytecodet &bytecode)
+  {
+    return interpreter.execute(bytecode);
+  }
 };
 
+/// Build `((i + 3) * 5 - 2) / 3 > 20 ? (i << 2) : (i ^ 7)` for each i from
+/// 0 to \p n - 1 and combine the results with `+`
+static exprt make_expression(int n)
+{
+  const signedbv_typet int_type(32);
+  exprt::operandst summands;
+
+  for(int i = 0; i < n; ++i)
+  {
+    const constant_exprt value = from_integer(i, int_type);
+    const exprt arithmetic = div_exprt(
+      minus_exprt(
+        mult_exprt(
+          plus_exprt(value, from_integer(3, int_type)),
+          from_integer(5, int_type)),
+        from_integer(2, int_type)),
+      from_integer(3, int_type));
+    summands.push_back(if_exprt(
+      binary_relation_exprt(arithmetic, ID_gt, from_integer(20, int_type)),
+      shl_exprt(value, from_integer(2, int_type)),
+      bitxor_exprt(value, from_integer(7, int_type))));
+  }
+
+  return plus_exprt(summands, int_type);
+}
+
 SCENARIO("interpreter evaluation null pointer expressions")
 {
   interpreter_testt interpreter_test;
@@ -68,3 +100,44 @@ SCENARIO("interpreter evaluation null pointer expressions")
     REQUIRE_THAT(mp_vector, Catch::Equals(null_vector));
   }
 }
+
+SCENARIO("interpreter bytecode agrees with evaluation")
+{
+  interpreter_testt interpreter_test;
+
+  GIVEN("An expression without overflows")
+  {
+    const exprt expression = make_expression(20);
+    const auto bytecode = compile_interpreter_bytecode(expression);
+    REQUIRE(bytecode.has_value());
+
+    THEN("Its bytecode computes the same value")
+    {
+      const mp_vectort expected = interpreter_test.evaluate(expression);
+      REQUIRE(expected.size() == 1);
+      REQUIRE(interpreter_test.evaluate_compiled(*bytecode) == expected[0]);
+    }
+  }
+}
+
+// Not run by default; use `unit "[benchmark]"` to measure.
+TEST_CASE("interpreter bytecode benchmarks", "[.][benchmark][interpreter]")
+{
+  interpreter_testt interpreter_test;
+  const exprt expression = make_expression(50);
+  const auto bytecode = compile_interpreter_bytecode(expression);
+  REQUIRE(bytecode.has_value());
+  const mp_integer expected = interpreter_test.evaluate(expression).front();
+
+  BENCHMARK("evaluate an expression 10000 times by walking it")
+  {
+    for(int i = 0; i < 10000; ++i)
+      REQUIRE(interpreter_test.evaluate(expression).front() == expected);
+  }
+
+  BENCHMARK("evaluate an expression 10000 times using bytecode")
+  {
+    for(int i = 0; i < 10000; ++i)
+      REQUIRE(interpreter_test.evaluate_compiled(*bytecode) == expected);
+  }
+}
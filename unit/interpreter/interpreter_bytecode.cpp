@@ -0,0 +1,145 @@
+/*******************************************************************\
+
+Module: Unit tests for interpreter_bytecodet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <goto-programs/interpreter_bytecode.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/ieee_float.h>
+#include <util/std_types.h>
+
+#include <map>
+
+/// Compile and run \p expr, reading symbols from \p values
+static mp_integer
+run(const exprt &expr, const std::map<irep_idt, mp_integer> &values)
+{
+  const auto bytecode = compile_interpreter_bytecode(expr);
+  REQUIRE(bytecode.has_value());
+
+  std::vector<interpreter_bytecodet::valuet> registers;
+  return bytecode->execute(registers, [&values](const symbol_exprt &symbol) {
+    return values.at(symbol.get_identifier());
+  });
+}
+
+SCENARIO("interpreter_bytecode", "[core][interpreter][interpreter_bytecode]")
+{
+  const signedbv_typet int_type(32);
+  const unsignedbv_typet uchar_type(8);
+  const symbol_exprt x("x", int_type);
+  const symbol_exprt y("y", int_type);
+  const symbol_exprt c("c", uchar_type);
+  const std::map<irep_idt, mp_integer> values = {
+    {"x", 7}, {"y", -3}, {"c", 200}};
+
+  GIVEN("Arithmetic over symbols")
+  {
+    THEN("It is evaluated")
+    {
+      REQUIRE(
+        run(mult_exprt(plus_exprt(x, y), from_integer(2, int_type)), values) ==
+        8);
+      REQUIRE(run(div_exprt(x, y), values) == -2);
+      REQUIRE(run(minus_exprt(y, x), values) == -10);
+      REQUIRE(run(unary_minus_exprt(y), values) == 3);
+      REQUIRE(run(bitnot_exprt(c), values) == 55);
+    }
+
+    THEN("Results wrap around at the width of their type")
+    {
+      REQUIRE(run(plus_exprt(c, from_integer(100, uchar_type)), values) == 44);
+      REQUIRE(
+        run(
+          plus_exprt(
+            from_integer(2147483647, int_type), from_integer(1, int_type)),
+          values) == -2147483648LL);
+    }
+  }
+
+  GIVEN("Comparisons and shifts")
+  {
+    THEN("They respect the signedness of their operands")
+    {
+      const unsignedbv_typet uint_type(32);
+      REQUIRE(
+        run(
+          binary_relation_exprt(
+            from_integer(4294967295LL, uint_type),
+            ID_gt,
+            from_integer(1, uint_type)),
+          values) == 1);
+      const binary_relation_exprt y_lt_one(
+        y, ID_lt, from_integer(1, int_type));
+      REQUIRE(run(y_lt_one, values) == 1);
+
+      const signedbv_typet schar_type(8);
+      const constant_exprt minus_eight = from_integer(-8, schar_type);
+      const constant_exprt one = from_integer(1, schar_type);
+      REQUIRE(run(ashr_exprt(minus_eight, one), values) == -4);
+      REQUIRE(run(lshr_exprt(minus_eight, one), values) == 124);
+      REQUIRE(run(shl_exprt(minus_eight, one), values) == -16);
+    }
+  }
+
+  GIVEN("Operators that skip evaluating some of their operands")
+  {
+    const constant_exprt zero = from_integer(0, int_type);
+    const symbol_exprt z("z", int_type);
+    const std::map<irep_idt, mp_integer> zero_values = {{"z", 0}, {"x", 7}};
+
+    THEN("Operands that are not needed are not evaluated")
+    {
+      const and_exprt guarded_division(
+        notequal_exprt(z, zero),
+        binary_relation_exprt(div_exprt(x, z), ID_gt, zero));
+      REQUIRE(run(guarded_division, zero_values) == 0);
+
+      const or_exprt short_or(
+        equal_exprt(z, zero),
+        binary_relation_exprt(div_exprt(x, z), ID_gt, zero));
+      REQUIRE(run(short_or, zero_values) == 1);
+
+      const if_exprt guarded_if(equal_exprt(z, zero), x, div_exprt(x, z));
+      REQUIRE(run(guarded_if, zero_values) == 7);
+    }
+
+    THEN("Division by zero is an error when it is evaluated")
+    {
+      REQUIRE_THROWS(run(div_exprt(x, z), zero_values));
+    }
+  }
+
+  GIVEN("Type casts")
+  {
+    THEN("Values are truncated or converted to Booleans")
+    {
+      REQUIRE(run(typecast_exprt(y, uchar_type), values) == 253);
+      REQUIRE(run(typecast_exprt(c, signedbv_typet(8)), values) == -56);
+      REQUIRE(run(typecast_exprt(y, bool_typet()), values) == 1);
+      REQUIRE(run(not_exprt(typecast_exprt(y, bool_typet())), values) == 0);
+    }
+  }
+
+  GIVEN("Expressions the bytecode does not support")
+  {
+    THEN("They are not compiled")
+    {
+      const pointer_typet pointer_type(int_type, 64);
+      REQUIRE_FALSE(compile_interpreter_bytecode(
+        dereference_exprt(symbol_exprt("p", pointer_type), int_type)));
+      const symbol_exprt f(
+        "f", ieee_float_spect::single_precision().to_type());
+      REQUIRE_FALSE(compile_interpreter_bytecode(plus_exprt(x, f)));
+      REQUIRE_FALSE(
+        compile_interpreter_bytecode(symbol_exprt("w", signedbv_typet(128))));
+    }
+  }
+}
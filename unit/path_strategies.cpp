@@ -95,6 +95,26 @@ SCENARIO("path strategies")
        symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
        symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
        symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+    // Both branches are uncovered, so the last one saved is resumed first
+    check_with_strategy(
+      "coverage-guided",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+    // There are no assertions, so all paths are equally far from one
+    check_with_strategy(
+      "shortest-distance",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
   }
 
   GIVEN("a program with nested conditionals")
@@ -244,6 +264,40 @@ SCENARIO("path strategies")
         symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
         symex_eventt::result(symex_eventt::enumt::FAILURE),
 
+        // Overall we fail.
+        symex_eventt::result(symex_eventt::enumt::FAILURE),
+      });
+
+    check_with_strategy(
+      "shortest-distance",
+      opts_callback,
+      c,
+      {
+        // Entry state is line 0
+        symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+
+        // The if-block contains the assertion, so enter it before the path
+        // where x != 1, from which no assertion can be reached.
+        symex_eventt::resume(symex_eventt::enumt::NEXT, 6),
+
+        // Skipping the loop body leads straight to the assertion. Successful
+        // because the path is implausible.
+        symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+        symex_eventt::result(symex_eventt::enumt::SUCCESS),
+
+        // Enter the loop body once, then leave the loop for the assertion,
+        // which fails.
+        symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+        symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+        symex_eventt::result(symex_eventt::enumt::FAILURE),
+
+        // Enter the loop body twice. Successful because infeasible.
+        symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+        symex_eventt::result(symex_eventt::enumt::SUCCESS),
+
+        // Only now the path where x != 1 and we have nothing to check.
+        symex_eventt::resume(symex_eventt::enumt::JUMP, 11),
+
         // Overall we fail.
         symex_eventt::result(symex_eventt::enumt::FAILURE),
       });
@@ -404,7 +458,8 @@ void _check_with_strategy(
   symbol_tablet symex_symbol_table;
   namespacet ns(goto_model.get_symbol_table(), symex_symbol_table);
   propertiest properties(initialize_properties(goto_model));
-  std::unique_ptr<path_storaget> worklist = get_path_strategy(strategy);
+  std::unique_ptr<path_storaget> worklist =
+    get_path_strategy(strategy, goto_model);
   guard_managert guard_manager;
 
   {
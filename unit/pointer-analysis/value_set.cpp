@@ -305,5 +305,64 @@ SCENARIO(
             *index_of_arr_result.begin(), i1.symbol_expr()));
       }
     }
+
+    WHEN("We merge value sets that assign different objects to pointers")
+    {
+      symbolt p;
+      p.name = "p";
+      p.base_name = "p";
+      p.pretty_name = "p";
+      p.type = int32_ptr;
+      p.is_static_lifetime = true;
+      symbol_table.add(p);
+
+      symbolt q = p;
+      q.name = "q";
+      q.base_name = "q";
+      q.pretty_name = "q";
+      symbol_table.add(q);
+
+      value_set.assign(
+        p.symbol_expr(), address_of_exprt(i1.symbol_expr()), ns, false, false);
+
+      value_sett other_value_set = value_set;
+      other_value_set.assign(
+        p.symbol_expr(), address_of_exprt(i2.symbol_expr()), ns, false, false);
+      other_value_set.assign(
+        q.symbol_expr(), address_of_exprt(i3.symbol_expr()), ns, false, false);
+
+      const bool changed = value_set.make_union(other_value_set);
+
+      THEN("The pointers may point to the objects of either value set")
+      {
+        REQUIRE(changed);
+
+        std::list<exprt> p_result;
+        value_set.get_value_set(p.symbol_expr(), p_result, ns);
+        REQUIRE(p_result.size() == 2);
+
+        bool found_i1 = false, found_i2 = false;
+        for(const exprt &result : p_result)
+        {
+          if(object_descriptor_matches(result, i1.symbol_expr()))
+            found_i1 = true;
+          else if(object_descriptor_matches(result, i2.symbol_expr()))
+            found_i2 = true;
+        }
+
+        REQUIRE(found_i1);
+        REQUIRE(found_i2);
+
+        std::list<exprt> q_result;
+        value_set.get_value_set(q.symbol_expr(), q_result, ns);
+        REQUIRE(q_result.size() == 1);
+        REQUIRE(object_descriptor_matches(*q_result.begin(), i3.symbol_expr()));
+      }
+
+      THEN("Merging the same values again does not change the value set")
+      {
+        REQUIRE(!value_set.make_union(other_value_set));
+      }
+    }
   }
 }
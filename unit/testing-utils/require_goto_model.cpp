@@ -0,0 +1,34 @@
+/*******************************************************************\
+
+Module: Unit test utilities
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "require_goto_model.h"
+#include "use_catch.h"
+
+std::vector<irep_idt> symbol_names(const symbol_tablet &symbol_table)
+{
+  std::vector<irep_idt> names;
+  names.reserve(symbol_table.symbols.size());
+  for(const auto &symbol_pair : symbol_table.symbols)
+    names.push_back(symbol_pair.first);
+  return names;
+}
+
+void require_same_goto_functions(
+  const goto_functionst &actual,
+  const goto_functionst &expected)
+{
+  REQUIRE(actual.function_map.size() == expected.function_map.size());
+
+  for(const auto &function : expected.function_map)
+  {
+    INFO("Comparing function: " + id2string(function.first));
+    const auto actual_function = actual.function_map.find(function.first);
+    REQUIRE(actual_function != actual.function_map.end());
+    REQUIRE(actual_function->second.body.equals(function.second.body));
+  }
+}
@@ -0,0 +1,32 @@
+/*******************************************************************\
+
+Module: Unit test utilities
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Helper functions for comparing goto models built in different ways, such
+/// as sequentially and with several jobs
+
+#ifndef CPROVER_TESTING_UTILS_REQUIRE_GOTO_MODEL_H
+#define CPROVER_TESTING_UTILS_REQUIRE_GOTO_MODEL_H
+
+#include <goto-programs/goto_functions.h>
+
+#include <util/symbol_table.h>
+
+#include <vector>
+
+/// \return the names of the symbols of \p symbol_table in the order in which
+///   the symbol table lists them
+std::vector<irep_idt> symbol_names(const symbol_tablet &symbol_table);
+
+/// Verify that \p actual has the same functions as \p expected, with bodies
+/// that are equal according to \ref goto_programt::equals
+void require_same_goto_functions(
+  const goto_functionst &actual,
+  const goto_functionst &expected);
+
+#endif // CPROVER_TESTING_UTILS_REQUIRE_GOTO_MODEL_H
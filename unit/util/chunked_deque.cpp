@@ -0,0 +1,124 @@
+/*******************************************************************\
+
+Module: Unit tests for chunked_dequet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/chunked_deque.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+SCENARIO("chunked_dequet stores elements in order", "[core][util][chunked]")
+{
+  GIVEN("A deque with elements added at both ends across several chunks")
+  {
+    chunked_dequet<std::string, 4> deque;
+    for(int i = 0; i < 10; ++i)
+      deque.push_back(std::to_string(i));
+    for(int i = 1; i <= 6; ++i)
+      deque.emplace_front(std::to_string(-i));
+
+    THEN("Elements are accessed by index in order")
+    {
+      REQUIRE(deque.size() == 16);
+      REQUIRE(deque.front() == "-6");
+      REQUIRE(deque.back() == "9");
+      for(std::size_t i = 0; i < deque.size(); ++i)
+        REQUIRE(deque[i] == std::to_string(static_cast<int>(i) - 6));
+    }
+
+    THEN("Iterators visit the elements in order, forwards and backwards")
+    {
+      REQUIRE(std::distance(deque.begin(), deque.end()) == 16);
+      REQUIRE(std::is_sorted(
+        deque.rbegin(),
+        deque.rend(),
+        [](const std::string &a, const std::string &b) {
+          return std::stoi(a) > std::stoi(b);
+        }));
+      REQUIRE(*(deque.begin() + 6) == "0");
+      REQUIRE(deque.end() - deque.begin() == 16);
+    }
+
+    WHEN("The deque is copied")
+    {
+      const chunked_dequet<std::string, 4> copy = deque;
+      deque.front() = "changed";
+
+      THEN("The copy has its own elements")
+      {
+        REQUIRE(copy.size() == 16);
+        REQUIRE(copy.front() == "-6");
+      }
+    }
+
+    WHEN("The deque is cleared")
+    {
+      deque.clear();
+
+      THEN("It is empty and can be used again")
+      {
+        REQUIRE(deque.empty());
+        REQUIRE(deque.begin() == deque.end());
+        deque.push_back("x");
+        REQUIRE(deque.size() == 1);
+        REQUIRE(deque[0] == "x");
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "chunked_dequet keeps references and iterators valid",
+  "[core][util][chunked]")
+{
+  GIVEN("References and iterators to elements of a deque")
+  {
+    chunked_dequet<int, 2> deque;
+    deque.push_back(1);
+    deque.push_back(2);
+    int &first = deque.front();
+    chunked_dequet<int, 2>::iterator second = deque.begin() + 1;
+    chunked_dequet<int, 2>::const_iterator end = deque.end();
+
+    std::map<chunked_dequet<int, 2>::const_iterator, int> ordered;
+    ordered[second] = 2;
+    ordered[deque.begin()] = 1;
+
+    WHEN("Elements are added at both ends")
+    {
+      for(int i = 3; i < 20; ++i)
+        deque.push_back(i);
+      for(int i = 0; i > -20; --i)
+        deque.push_front(i);
+
+      THEN("They still refer to the same elements")
+      {
+        REQUIRE(first == 1);
+        REQUIRE(&first == &deque[20]);
+        REQUIRE(*second == 2);
+        REQUIRE(*end == 3);
+        REQUIRE(deque.begin() < second);
+        REQUIRE(ordered.begin()->second == 1);
+      }
+    }
+
+    WHEN("The deque is moved")
+    {
+      chunked_dequet<int, 2> moved(std::move(deque));
+
+      THEN("They refer to the elements of the new deque")
+      {
+        REQUIRE(&first == &moved.front());
+        REQUIRE(*second == 2);
+        REQUIRE(second + 1 == moved.end());
+      }
+    }
+  }
+}
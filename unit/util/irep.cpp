@@ -5,6 +5,10 @@
 #include <testing-utils/use_catch.h>
 #include <util/irep.h>
 
+#include <string>
+#include <unordered_set>
+#include <vector>
+
 SCENARIO("irept_memory", "[core][utils][irept]")
 {
   GIVEN("Always")
@@ -300,5 +304,115 @@ SCENARIO("irept_memory", "[core][utils][irept]")
       REQUIRE(irep1 == irep2);
       REQUIRE(!irep1.full_eq(irep2));
     }
+
+    THEN("Cached hash codes follow modifications")
+    {
+      irep1.id("id1");
+      irep1.get_sub().push_back(irept("op"));
+      irep2 = irep1;
+      const std::size_t hash_before = irep1.hash();
+      REQUIRE(irep2.hash() == hash_before);
+
+      irep2.get_sub().back().id("other_op");
+      REQUIRE(irep1.hash() == hash_before);
+      REQUIRE(irep2.hash() != hash_before);
+      REQUIRE(irep1 != irep2);
+
+      irept &op = irep1.get_sub().back();
+      REQUIRE(irep1.hash() == hash_before);
+      op.id("other_op");
+      REQUIRE(irep1.hash() == irep2.hash());
+      REQUIRE(irep1 == irep2);
+    }
+
+    THEN("Hash codes computed before modifying a child are not reused")
+    {
+      irep1.id("id1");
+      irep1.get_sub().push_back(irept("op"));
+      irept &op = irep1.get_sub().back();
+      const std::size_t hash_before = irep1.hash();
+      op.id("other_op");
+
+      const irept copy = irep1;
+      irep2.id("id1");
+      irep2.get_sub().push_back(irept("other_op"));
+      const irept copy2 = irep2;
+      REQUIRE(copy.hash() != hash_before);
+      REQUIRE(copy == irep2);
+    }
+
+    THEN("Hash codes are reset when a node ceases to be shared")
+    {
+      irep1.id("id1");
+      irep1.get_sub().push_back(irept("op"));
+      irept &op = irep1.get_sub().back();
+      std::size_t hash_before;
+      {
+        const irept copy = irep1;
+        hash_before = copy.hash();
+      }
+      op.id("other_op");
+
+      const irept copy = irep1;
+      REQUIRE(copy.hash() != hash_before);
+      irep2.id("id1");
+      irep2.get_sub().push_back(irept("other_op"));
+      REQUIRE(copy.hash() == irep2.hash());
+    }
+  }
+}
+
+// Not run by default; use `unit "[benchmark]"` to measure.
+TEST_CASE("irept hash code benchmarks", "[.][benchmark][irept]")
+{
+  // Expressions with a large first operand that is equal, but not shared,
+  // between them, and a distinct second operand. As the expressions are also
+  // held in the sets below their nodes are shared, so hash codes are cached.
+  const std::size_t n = 100;
+  std::vector<irept> expressions;
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    irept common(ID_symbol);
+    for(int depth = 0; depth < 12; ++depth)
+      common = irept(ID_plus, {}, {common, common});
+    expressions.push_back(
+      irept(ID_mult, {}, {common, irept(std::to_string(i))}));
+  }
+
+  const std::unordered_set<irept, irep_hash> set(
+    expressions.begin(), expressions.end());
+  const std::unordered_set<irept, irep_full_hash, irep_full_eq> full_set(
+    expressions.begin(), expressions.end());
+
+  BENCHMARK("look up expressions using cached hash codes")
+  {
+    std::size_t found = 0;
+    for(const irept &expression : expressions)
+      found += set.count(expression);
+    REQUIRE(found == n);
+  }
+
+  BENCHMARK("look up expressions without cached hash codes")
+  {
+    std::size_t found = 0;
+    for(const irept &expression : expressions)
+      found += full_set.count(expression);
+    REQUIRE(found == n);
+  }
+
+  BENCHMARK("compare unequal expressions using cached hash codes")
+  {
+    std::size_t equal = 0;
+    for(std::size_t i = 0; i < n; ++i)
+      equal += expressions[i] == expressions[(i + 1) % n];
+    REQUIRE(equal == 0);
+  }
+
+  BENCHMARK("compare unequal expressions without cached hash codes")
+  {
+    std::size_t equal = 0;
+    for(std::size_t i = 0; i < n; ++i)
+      equal += expressions[i].full_eq(expressions[(i + 1) % n]);
+    REQUIRE(equal == 0);
   }
 }
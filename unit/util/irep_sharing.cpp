@@ -219,4 +219,180 @@ SCENARIO("exprt_sharing", "[core][utils][exprt]")
   }
 }
 
+#include <util/merge_irep.h>
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+SCENARIO("hash_consing_irep", "[core][utils][irept]")
+{
+  GIVEN("Two structurally equal ireps built independently")
+  {
+    irept irep1(ID_1);
+    irep1.get_sub().push_back(irept(ID_0));
+    irep1.add(ID_type, irept(ID_bool));
+    irept irep2(ID_1);
+    irep2.get_sub().push_back(irept(ID_0));
+    irep2.add(ID_type, irept(ID_bool));
+    REQUIRE(&irep1.read() != &irep2.read());
+
+    hash_consing_irept hash_consing;
+
+    THEN("Nothing is shared while hash-consing is disabled")
+    {
+      hash_consing(irep1);
+      hash_consing(irep2);
+      REQUIRE(&irep1.read() != &irep2.read());
+      REQUIRE(hash_consing.size() == 0);
+    }
+    THEN("Enabling hash-consing makes them share their nodes")
+    {
+      hash_consing.enable();
+      hash_consing(irep1);
+      hash_consing(irep2);
+      REQUIRE(&irep1.read() == &irep2.read());
+      REQUIRE(irep1 == irep2);
+    }
+    THEN("Modifying one of them after hash-consing breaks sharing")
+    {
+      hash_consing.enable();
+      hash_consing(irep1);
+      hash_consing(irep2);
+      irep2.get_sub()[0].id(ID_1);
+      REQUIRE(irep1.get_sub()[0].id() == ID_0);
+      REQUIRE(irep1 != irep2);
+    }
+    THEN("Disabling hash-consing releases the unique table")
+    {
+      hash_consing.enable();
+      hash_consing(irep1);
+      REQUIRE(hash_consing.size() != 0);
+      hash_consing.disable();
+      REQUIRE(hash_consing.size() == 0);
+      REQUIRE(!hash_consing.is_enabled());
+    }
+  }
+}
+
+/// Number of distinct nodes reachable from the ireps in \p equations
+static std::size_t
+count_nodes(const std::vector<std::vector<irept>> &equations)
+{
+  std::unordered_set<const void *> nodes;
+  std::vector<const irept *> stack;
+  for(const auto &equation : equations)
+    for(const irept &irep : equation)
+      stack.push_back(&irep);
+
+  while(!stack.empty())
+  {
+    const irept &irep = *stack.back();
+    stack.pop_back();
+    if(!nodes.insert(&irep.read()).second)
+      continue;
+    for(const irept &op : irep.get_sub())
+      stack.push_back(&op);
+    for(const auto &named_op : irep.get_named_sub())
+      stack.push_back(&named_op.second);
+  }
+
+  return nodes.size();
+}
+
+// Not run by default; use `unit "[benchmark]"` to measure.
+TEST_CASE("hash_consing_irep benchmarks", "[.][benchmark][irept]")
+{
+  // Path exploration records one equation per path, and the steps of these
+  // largely repeat the same expressions, which each path builds anew.
+  const std::size_t paths = 100;
+  const std::size_t steps = 200;
+  const auto build_step = [](std::size_t step) {
+    irept expression(ID_symbol);
+    expression.set(ID_identifier, "x" + std::to_string(step % 50));
+    for(int depth = 0; depth < 8; ++depth)
+    {
+      irept operand(ID_constant);
+      operand.set(ID_value, depth);
+      operand.add(ID_type, irept(ID_signedbv)).set(ID_width, 32);
+      expression = irept(ID_plus, {}, {expression, operand});
+    }
+    return expression;
+  };
+
+  std::vector<std::vector<irept>> merged_per_equation(paths);
+  std::vector<std::vector<irept>> hash_consed(paths);
+  hash_consing_irept hash_consing;
+  hash_consing.enable();
+  std::size_t entries_per_equation = 0;
+  for(std::size_t path = 0; path < paths; ++path)
+  {
+    merge_irept merge;
+    for(std::size_t step = 0; step < steps; ++step)
+    {
+      merged_per_equation[path].push_back(build_step(step));
+      merge(merged_per_equation[path].back());
+      hash_consed[path].push_back(build_step(step));
+      hash_consing(hash_consed[path].back());
+    }
+    entries_per_equation = merge.size();
+  }
+
+  // The unique table is not freed while hash-consing is enabled; the nodes it
+  // holds are those of the expressions themselves, plus one table entry each.
+  WARN(
+    "merged per equation: " << count_nodes(merged_per_equation) << " nodes, "
+                            << entries_per_equation
+                            << " table entries per equation");
+  WARN(
+    "hash-consed: " << count_nodes(hash_consed) << " nodes, "
+                    << hash_consing.size() << " table entries");
+
+  BENCHMARK("merge the steps of each equation separately")
+  {
+    for(std::size_t path = 0; path < paths; ++path)
+    {
+      merge_irept merge;
+      for(std::size_t step = 0; step < steps; ++step)
+      {
+        irept expression = build_step(step);
+        merge(expression);
+      }
+    }
+  }
+
+  BENCHMARK("hash-cons the steps of all equations")
+  {
+    for(std::size_t path = 0; path < paths; ++path)
+    {
+      for(std::size_t step = 0; step < steps; ++step)
+      {
+        irept expression = build_step(step);
+        hash_consing(expression);
+      }
+    }
+  }
+
+  BENCHMARK("compare the steps of all equations, merged per equation")
+  {
+    std::size_t equal = 0;
+    for(std::size_t path = 1; path < paths; ++path)
+      for(std::size_t step = 0; step < steps; ++step)
+      {
+        equal +=
+          merged_per_equation[path][step] == merged_per_equation[0][step];
+      }
+    REQUIRE(equal == (paths - 1) * steps);
+  }
+
+  BENCHMARK("compare the steps of all equations, hash-consed")
+  {
+    std::size_t equal = 0;
+    for(std::size_t path = 1; path < paths; ++path)
+      for(std::size_t step = 0; step < steps; ++step)
+        equal += hash_consed[path][step] == hash_consed[0][step];
+    REQUIRE(equal == (paths - 1) * steps);
+  }
+}
+
 #endif
@@ -0,0 +1,69 @@
+/*******************************************************************\
+
+Module: Unit tests for memory_reportt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/json.h>
+#include <util/memory_report.h>
+
+SCENARIO("memory_report", "[core][util][memory_report]")
+{
+  GIVEN("A memory report")
+  {
+    memory_reportt report;
+
+    WHEN("It has not been enabled")
+    {
+      report.snapshot("phase");
+      report.record_size("structure", 1);
+
+      THEN("Nothing is recorded")
+      {
+        const json_objectt json = report.to_json();
+        REQUIRE(to_json_array(json["phases"]).empty());
+        const json_objectt &structures = to_json_object(json["structures"]);
+        REQUIRE(structures.begin() == structures.end());
+      }
+    }
+
+    WHEN("It has been enabled")
+    {
+      report.enable();
+      report.snapshot("first");
+      report.record_size("structure", 3);
+      report.snapshot("second");
+      report.record_size("structure", 7);
+      report.record_size("structure", 5);
+
+      THEN("Snapshots are reported in order")
+      {
+        const json_objectt json = report.to_json();
+        const json_arrayt &phases = to_json_array(json["phases"]);
+        REQUIRE(phases.size() == 2);
+        auto phase = phases.begin();
+        REQUIRE((*phase)["phase"].value == "first");
+        ++phase;
+        REQUIRE((*phase)["phase"].value == "second");
+      }
+
+      THEN("The latest and largest sizes are reported")
+      {
+        const json_objectt json = report.to_json();
+        REQUIRE(json["structures"]["structure"]["latest"].value == "5");
+        REQUIRE(json["structures"]["structure"]["largest"].value == "7");
+      }
+
+      THEN("The memory usage at exit is reported")
+      {
+        const json_objectt json = report.to_json();
+        REQUIRE(json["exit"]["residentBytes"].is_number());
+        REQUIRE(json["exit"]["heapBytesInUse"].is_number());
+      }
+    }
+  }
+}
@@ -0,0 +1,94 @@
+/*******************************************************************\
+
+Module: Unit tests for perf_counterst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/json.h>
+#include <util/perf_counters.h>
+
+SCENARIO("perf_counters", "[core][util][perf_counters]")
+{
+  GIVEN("A registry of performance counters")
+  {
+    perf_counterst registry;
+
+    WHEN("Counters and timers are looked up by name")
+    {
+      perf_countert &counter = registry.counter("a");
+      counter.add(2);
+      registry.counter("a").add(3);
+      registry.counter("b").add(1);
+
+      {
+        perf_timer_scopet scope(&registry.timer("t"));
+      }
+
+      THEN("The same counter is returned for the same name")
+      {
+        REQUIRE(&registry.counter("a") == &counter);
+        REQUIRE(counter.get() == 5);
+        REQUIRE(registry.counter("b").get() == 1);
+        REQUIRE(registry.timer("t").get_calls() == 1);
+      }
+
+      THEN("The registry can be printed as JSON")
+      {
+        const json_objectt json = registry.to_json();
+        REQUIRE(json["counters"]["a"].value == "5");
+        REQUIRE(json["counters"]["b"].value == "1");
+        REQUIRE(json["timers"]["t"]["calls"].value == "1");
+      }
+
+      THEN("Resetting keeps the names but clears the values")
+      {
+        registry.reset();
+        REQUIRE(counter.get() == 0);
+        REQUIRE(registry.timer("t").get_calls() == 0);
+        REQUIRE(registry.to_json()["counters"]["a"].value == "0");
+      }
+    }
+  }
+
+  GIVEN("The process-wide registry")
+  {
+    WHEN("It has not been enabled")
+    {
+      REQUIRE_FALSE(perf_counters_enabled());
+      PERF_COUNT("perf_counters.unit.disabled");
+
+      THEN("Nothing is recorded")
+      {
+        REQUIRE(
+          perf_counters().counter("perf_counters.unit.disabled").get() == 0);
+      }
+    }
+
+    WHEN("It has been enabled")
+    {
+      enable_perf_counters();
+      for(int i = 0; i < 3; ++i)
+        PERF_COUNT("perf_counters.unit.enabled");
+
+      {
+        PERF_TIMER("perf_counters.unit.timer");
+        PERF_TIMER("perf_counters.unit.other_timer");
+      }
+
+      THEN("Macros record into it")
+      {
+        REQUIRE(
+          perf_counters().counter("perf_counters.unit.enabled").get() == 3);
+        REQUIRE(
+          perf_counters().timer("perf_counters.unit.timer").get_calls() == 1);
+        REQUIRE(
+          perf_counters().timer("perf_counters.unit.other_timer").get_calls() ==
+          1);
+      }
+    }
+  }
+}
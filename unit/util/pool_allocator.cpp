@@ -0,0 +1,130 @@
+/// Author: Diffblue Ltd.
+
+/// \file Tests for pool allocator
+
+#include <testing-utils/use_catch.h>
+#include <util/pool_allocator.h>
+
+#include <list>
+#include <set>
+#include <thread>
+#include <vector>
+
+struct pooled_objectt
+{
+  std::size_t a;
+  std::size_t b;
+};
+
+SCENARIO("pool_allocator", "[core][utils][pool_allocator]")
+{
+  using allocatort = pool_allocatort<pooled_objectt, 4>;
+
+  GIVEN("More allocations than fit in a single chunk")
+  {
+    std::set<void *> pointers;
+    for(std::size_t i = 0; i < 10; ++i)
+      pointers.insert(allocatort::allocate());
+
+    THEN("All allocated objects are distinct")
+    {
+      REQUIRE(pointers.size() == 10);
+    }
+
+    THEN("Deallocated objects are reused")
+    {
+      void *ptr = *pointers.begin();
+      allocatort::deallocate(ptr);
+      REQUIRE(allocatort::allocate() == ptr);
+    }
+
+    THEN("Allocated objects are usable")
+    {
+      for(void *ptr : pointers)
+        new(ptr) pooled_objectt{1, 2};
+      for(void *ptr : pointers)
+        REQUIRE(static_cast<pooled_objectt *>(ptr)->b == 2);
+    }
+
+    for(void *ptr : pointers)
+      allocatort::deallocate(ptr);
+  }
+}
+
+struct thread_pooled_objectt
+{
+  std::size_t a;
+};
+
+SCENARIO(
+  "pool_allocator reuses the objects of exited threads",
+  "[core][utils][pool_allocator]")
+{
+  using allocatort = pool_allocatort<thread_pooled_objectt, 4>;
+  const auto allocate_and_deallocate = [] {
+    std::vector<void *> pointers;
+    for(std::size_t i = 0; i < 100; ++i)
+      pointers.push_back(allocatort::allocate());
+    for(void *ptr : pointers)
+      allocatort::deallocate(ptr);
+  };
+
+  GIVEN("A thread that allocated and deallocated objects and exited")
+  {
+    std::thread(allocate_and_deallocate).join();
+    const std::size_t capacity = allocatort::capacity();
+    REQUIRE(capacity >= 100);
+
+    THEN("Other threads reuse its objects rather than allocating new chunks")
+    {
+      for(std::size_t i = 0; i < 10; ++i)
+        std::thread(allocate_and_deallocate).join();
+      REQUIRE(allocatort::capacity() == capacity);
+    }
+  }
+}
+
+SCENARIO("pool_container_allocator", "[core][utils][pool_allocator]")
+{
+  using listt =
+    std::list<pooled_objectt, pool_container_allocatort<pooled_objectt>>;
+
+  GIVEN("Two lists using the pool")
+  {
+    listt first;
+    listt second;
+    for(std::size_t i = 0; i < 10; ++i)
+    {
+      first.push_back({i, 0});
+      second.push_back({i, 1});
+    }
+
+    THEN("Iterators remain valid when elements are inserted and erased")
+    {
+      const auto it = std::next(first.begin(), 5);
+      first.insert(it, {42, 0});
+      first.erase(first.begin());
+      first.push_front({43, 0});
+      REQUIRE(it->a == 5);
+      REQUIRE(std::prev(it)->a == 42);
+    }
+
+    THEN("Elements can be spliced between lists")
+    {
+      const auto it = second.begin();
+      first.splice(first.end(), second, it);
+      REQUIRE(first.size() == 11);
+      REQUIRE(second.size() == 9);
+      REQUIRE(&first.back() == &*it);
+      REQUIRE(it->b == 1);
+    }
+
+    THEN("Lists can be moved")
+    {
+      const auto it = second.begin();
+      first = std::move(second);
+      REQUIRE(first.begin() == it);
+      REQUIRE(first.size() == 10);
+    }
+  }
+}
@@ -10,6 +10,7 @@ Author: Daniel Poetzl
 #define SN_INTERNAL_CHECKS
 
 #include <climits>
+#include <map>
 #include <random>
 #include <set>
 
@@ -650,3 +651,213 @@ TEST_CASE("Sharing map sharing stats", "[core][util]")
   }
 #endif
 }
+
+TEST_CASE("Sharing map bulk build", "[core][util]")
+{
+  std::map<irep_idt, std::string> m;
+
+  for(std::size_t i = 0; i < 1000; i++)
+    m[std::to_string(i)] = std::to_string(i * 2);
+
+  sharing_map_standardt sm;
+  sm.build(m.begin(), m.end());
+
+  REQUIRE(sm.size() == m.size());
+
+  for(const auto &item : m)
+  {
+    REQUIRE(sm.has_key(item.first));
+    REQUIRE(sm.find(item.first)->get() == item.second);
+  }
+
+  sharing_map_standardt sm2;
+  sm2.build(m.begin(), m.begin());
+  REQUIRE(sm2.empty());
+
+  sharing_map_standardt::delta_viewt delta_view;
+  sm.get_delta_view(sm2, delta_view, false);
+  REQUIRE(delta_view.size() == m.size());
+}
+
+TEST_CASE("Sharing map three-way merge", "[core][util]")
+{
+  sharing_map_standardt base;
+  fill(base);
+
+  std::size_t calls = 0;
+
+  auto f = [&calls](
+             const irep_idt &k,
+             const std::string *base_value,
+             const std::string *value,
+             const std::string *other_value) -> optionalt<std::string> {
+    calls++;
+
+    if(value == nullptr || other_value == nullptr)
+      return {};
+
+    return *value + *other_value;
+  };
+
+  SECTION("Changed in one map only")
+  {
+    sharing_map_standardt sm1(base);
+    sm1.replace("i", "a");
+    sm1.insert("x", "b");
+
+    sharing_map_standardt sm2(base);
+    sm2.replace("j", "c");
+    sm2.erase("k");
+    sm2.insert("y", "d");
+
+    REQUIRE(sm1.merge(base, sm2, f));
+
+    REQUIRE(calls == 0);
+    REQUIRE(sm1.size() == 4);
+    REQUIRE(sm1.find("i")->get() == "a");
+    REQUIRE(sm1.find("j")->get() == "c");
+    REQUIRE(!sm1.has_key("k"));
+    REQUIRE(sm1.find("x")->get() == "b");
+    REQUIRE(sm1.find("y")->get() == "d");
+  }
+
+  SECTION("Changed in both maps")
+  {
+    sharing_map_standardt sm1(base);
+    sm1.replace("i", "a");
+    sm1.erase("j");
+
+    sharing_map_standardt sm2(base);
+    sm2.replace("i", "b");
+    sm2.replace("j", "c");
+
+    REQUIRE(sm1.merge(base, sm2, f));
+
+    REQUIRE(calls == 2);
+    REQUIRE(sm1.size() == 2);
+    REQUIRE(sm1.find("i")->get() == "ab");
+    REQUIRE(!sm1.has_key("j"));
+    REQUIRE(sm1.find("k")->get() == "2");
+  }
+
+  SECTION("Unchanged maps")
+  {
+    sharing_map_standardt sm1(base);
+    sharing_map_standardt sm2(base);
+    sm2.insert("l", "3");
+
+    REQUIRE(sm1.merge(base, sm2, f));
+
+    REQUIRE(calls == 0);
+    REQUIRE(sm1.size() == 4);
+
+    sharing_map_standardt::delta_viewt delta_view;
+    sm1.get_delta_view(sm2, delta_view, false);
+    REQUIRE(delta_view.empty());
+
+    sharing_map_standardt sm3(base);
+    REQUIRE(!sm1.merge(base, sm3, f));
+    REQUIRE(calls == 0);
+    REQUIRE(sm1.size() == 4);
+  }
+
+  SECTION("Merge with empty maps")
+  {
+    sharing_map_standardt empty;
+
+    sharing_map_standardt sm1(base);
+    REQUIRE(sm1.merge(base, empty, f));
+    REQUIRE(sm1.empty());
+
+    sharing_map_standardt sm2;
+    REQUIRE(sm2.merge(empty, base, f));
+    REQUIRE(sm2.size() == 3);
+  }
+
+  SECTION("Union via an empty base")
+  {
+    sharing_map_standardt empty;
+
+    sharing_map_standardt sm1(base);
+    sm1.replace("i", "a");
+    sm1.insert("x", "b");
+
+    sharing_map_standardt sm2(base);
+    sm2.replace("i", "c");
+    sm2.insert("y", "d");
+
+    REQUIRE(sm1.merge(empty, sm2, f));
+
+    // only "i" differs between the maps, the other common keys are shared
+    REQUIRE(calls == 1);
+    REQUIRE(sm1.size() == 5);
+    REQUIRE(sm1.find("i")->get() == "ac");
+    REQUIRE(sm1.find("j")->get() == "1");
+    REQUIRE(sm1.find("x")->get() == "b");
+    REQUIRE(sm1.find("y")->get() == "d");
+
+    auto keep = [](
+                  const irep_idt &,
+                  const std::string *,
+                  const std::string *value,
+                  const std::string *) -> optionalt<std::string> {
+      return *value;
+    };
+
+    sharing_map_standardt sm3(base);
+    sm3.insert("y", "d");
+    REQUIRE(!sm1.merge(empty, sm3, keep));
+    REQUIRE(sm1.size() == 5);
+  }
+}
+
+TEST_CASE("Sharing map parallel views", "[core][util]")
+{
+  sharing_map_standardt sm1;
+
+  for(std::size_t i = 0; i < 1000; i++)
+    sm1.insert(std::to_string(i), std::to_string(i));
+
+  sharing_map_standardt sm2(sm1);
+
+  for(std::size_t i = 0; i < 1000; i += 10)
+    sm2.replace(std::to_string(i), "x");
+
+  for(std::size_t i = 1000; i < 1100; i++)
+    sm2.insert(std::to_string(i), std::to_string(i));
+
+  SECTION("View")
+  {
+    sharing_map_standardt::viewt view;
+    sm2.get_view(view, 4);
+
+    REQUIRE(view.size() == sm2.size());
+
+    std::set<irep_idt> keys;
+    for(const auto &item : view)
+      keys.insert(item.first);
+
+    REQUIRE(keys.size() == sm2.size());
+  }
+
+  SECTION("Delta view")
+  {
+    for(const bool only_common : {true, false})
+    {
+      sharing_map_standardt::delta_viewt delta_view;
+      sm2.get_delta_view(sm1, delta_view, only_common);
+
+      sharing_map_standardt::delta_viewt parallel_delta_view;
+      sm2.get_delta_view(sm1, parallel_delta_view, only_common, 4);
+
+      REQUIRE(parallel_delta_view.size() == delta_view.size());
+
+      std::set<irep_idt> keys;
+      for(const auto &item : delta_view)
+        keys.insert(item.k);
+
+      for(const auto &item : parallel_delta_view)
+        REQUIRE(keys.count(item.k) == 1);
+    }
+  }
+}
@@ -216,3 +216,40 @@ TEST_CASE("Simplify dynamic object comparison", "[core][util]")
 
   REQUIRE(simplify_expr(compare_pointer_objects, ns) == false_exprt());
 }
+
+TEST_CASE("Simplify with cache", "[core][util]")
+{
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  simplify_exprt simplifier(ns);
+  simplifier.enable_cache(2);
+
+  const symbol_exprt x("x", signedbv_typet(32));
+  const plus_exprt x_plus_zero(x, from_integer(0, x.type()));
+  const plus_exprt x_plus_x(x, x);
+
+  exprt simp1 = x_plus_zero;
+  REQUIRE(!simplifier.simplify(simp1));
+  REQUIRE(simp1 == x);
+  REQUIRE(simplifier.cache_hits() == 0);
+
+  exprt simp2 = x_plus_zero;
+  REQUIRE(!simplifier.simplify(simp2));
+  REQUIRE(simp2 == x);
+  REQUIRE(simplifier.cache_hits() == 1);
+
+  // unchanged expressions are cached as well
+  exprt simp3 = x_plus_x;
+  REQUIRE(simplifier.simplify(simp3));
+  exprt simp4 = x_plus_x;
+  REQUIRE(simplifier.simplify(simp4));
+  REQUIRE(simp4 == x_plus_x);
+  REQUIRE(simplifier.cache_hits() == 2);
+
+  simplifier.clear_cache();
+  exprt simp5 = x_plus_zero;
+  REQUIRE(!simplifier.simplify(simp5));
+  REQUIRE(simp5 == x);
+  REQUIRE(simplifier.cache_hits() == 2);
+}
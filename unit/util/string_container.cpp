@@ -0,0 +1,144 @@
+/// Author: Diffblue Ltd.
+
+/// \file Tests for concurrent use of the string container
+
+#include <testing-utils/use_catch.h>
+#include <util/string_container.h>
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+SCENARIO("string_container_concurrency", "[core][utils][string_container]")
+{
+  GIVEN("Many threads interning overlapping sets of strings")
+  {
+    string_containert &container = get_string_container();
+    const std::size_t number_of_threads = 8;
+    const std::size_t strings_per_thread = 20000;
+
+    std::vector<std::vector<unsigned>> numbers(number_of_threads);
+    std::vector<std::thread> threads;
+
+    for(std::size_t t = 0; t < number_of_threads; ++t)
+    {
+      threads.emplace_back([&container, &numbers, t, strings_per_thread] {
+        numbers[t].reserve(strings_per_thread);
+        for(std::size_t i = 0; i < strings_per_thread; ++i)
+        {
+          // every thread interns the same strings, in a different order
+          const std::size_t n = (i * (2 * t + 1)) % strings_per_thread;
+          const std::string s = "string_container_test_" + std::to_string(n);
+          const unsigned no = container[s];
+          // lookups happen while other threads keep inserting
+          if(container.get_string(no) != s)
+            return;
+          numbers[t].push_back(no);
+        }
+      });
+    }
+
+    for(auto &thread : threads)
+      thread.join();
+
+    THEN("All threads obtain the same number for the same string")
+    {
+      for(std::size_t t = 0; t < number_of_threads; ++t)
+      {
+        REQUIRE(numbers[t].size() == strings_per_thread);
+        for(std::size_t i = 0; i < strings_per_thread; ++i)
+        {
+          const std::size_t n = (i * (2 * t + 1)) % strings_per_thread;
+          REQUIRE(
+            container.get_string(numbers[t][i]) ==
+            "string_container_test_" + std::to_string(n));
+          REQUIRE(
+            numbers[t][i] ==
+            container["string_container_test_" + std::to_string(n)]);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO(
+  "string_container_deferred_interning",
+  "[core][utils][string_container]")
+{
+  GIVEN("Threads that intern new strings provisionally")
+  {
+    string_containert &container = get_string_container();
+    const unsigned existing = container["string_container_deferred_existing"];
+    const std::size_t number_of_threads = 4;
+
+    std::vector<deferred_stringst> deferred(number_of_threads);
+    std::vector<std::vector<unsigned>> numbers(number_of_threads);
+    std::vector<std::thread> threads;
+
+    for(std::size_t t = 0; t < number_of_threads; ++t)
+    {
+      threads.emplace_back([&container, &deferred, &numbers, t] {
+        const deferred_interningt deferred_interning(&deferred[t]);
+        for(std::size_t i = 0; i < 100; ++i)
+        {
+          const std::string s = "string_container_deferred_" +
+                                std::to_string(t) + "_" + std::to_string(i);
+          numbers[t].push_back(container[s]);
+        }
+        numbers[t].push_back(container["string_container_deferred_existing"]);
+        // interned by every thread
+        numbers[t].push_back(container["string_container_deferred_shared"]);
+      });
+    }
+
+    for(auto &thread : threads)
+      thread.join();
+
+    // only the new strings get provisional numbers
+    for(std::size_t t = 0; t < number_of_threads; ++t)
+    {
+      REQUIRE(numbers[t].size() == 102);
+      REQUIRE(numbers[t][100] == existing);
+      for(std::size_t i = 0; i < 100; ++i)
+      {
+        REQUIRE(string_containert::is_provisional(numbers[t][i]));
+        REQUIRE(
+          container.get_string(numbers[t][i]) ==
+          "string_container_deferred_" + std::to_string(t) + "_" +
+            std::to_string(i));
+      }
+      REQUIRE(deferred[t].numbers.size() == 101);
+    }
+
+    WHEN("Interning the strings thread by thread")
+    {
+      std::vector<std::unordered_map<unsigned, unsigned>> real_numbers;
+      for(const auto &strings : deferred)
+        real_numbers.push_back(container.intern(strings));
+
+      THEN("The strings are numbered in that order, each string once")
+      {
+        unsigned previous = existing;
+        for(std::size_t t = 0; t < number_of_threads; ++t)
+        {
+          for(std::size_t i = 0; i < 100; ++i)
+          {
+            const unsigned no = real_numbers[t].at(numbers[t][i]);
+            REQUIRE(!string_containert::is_provisional(no));
+            REQUIRE(no > previous);
+            REQUIRE(
+              container.get_string(no) ==
+              container.get_string(numbers[t][i]));
+            previous = no;
+          }
+        }
+
+        // a string that several threads interned has one number
+        const unsigned shared = container["string_container_deferred_shared"];
+        for(std::size_t t = 0; t < number_of_threads; ++t)
+          REQUIRE(real_numbers[t].at(numbers[t][101]) == shared);
+      }
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/*******************************************************************\
+
+Module: Unit tests for trace_timelinet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <util/tempfile.h>
+#include <util/trace_timeline.h>
+
+static std::string read_file(const std::string &filename)
+{
+  std::ifstream in(filename);
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+SCENARIO("trace_timeline", "[core][util][trace_timeline]")
+{
+  temporary_filet file("trace_timeline", ".json");
+
+  GIVEN("A trace timeline that has not been opened")
+  {
+    trace_timelinet timeline;
+
+    THEN("It is disabled")
+    {
+      REQUIRE_FALSE(timeline.is_enabled());
+    }
+  }
+
+  GIVEN("A trace timeline writing to a file")
+  {
+    trace_timelinet timeline;
+    timeline.open(file());
+    REQUIRE(timeline.is_enabled());
+
+    timeline.begin("outer", "phase");
+    timeline.complete(
+      "inner",
+      "symex",
+      std::chrono::microseconds(10),
+      std::chrono::microseconds(5));
+    timeline.end("outer", "phase");
+
+    WHEN("Enough events have been recorded")
+    {
+      for(std::size_t i = 0; i < trace_timelinet::flush_interval; ++i)
+        timeline.end("outer", "phase");
+
+      THEN("They are written before the timeline is closed")
+      {
+        const std::string contents = read_file(file());
+        REQUIRE(contents.front() == '[');
+        REQUIRE(contents.find("\"name\": \"outer\"") != std::string::npos);
+        REQUIRE(contents.find("\"ph\": \"X\"") != std::string::npos);
+      }
+    }
+
+    timeline.close();
+
+    THEN("The events are written as a JSON array")
+    {
+      REQUIRE_FALSE(timeline.is_enabled());
+
+      const std::string contents = read_file(file());
+      REQUIRE(contents.front() == '[');
+      REQUIRE(contents.find(']') != std::string::npos);
+      REQUIRE(contents.find("\"name\": \"outer\"") != std::string::npos);
+      REQUIRE(contents.find("\"ph\": \"B\"") != std::string::npos);
+      REQUIRE(contents.find("\"ph\": \"E\"") != std::string::npos);
+      REQUIRE(contents.find("\"ph\": \"X\"") != std::string::npos);
+      REQUIRE(contents.find("\"dur\": 5") != std::string::npos);
+      REQUIRE(contents.find("\"ts\": 10") != std::string::npos);
+    }
+  }
+
+  GIVEN("The process-wide trace timeline")
+  {
+    trace_timeline().open(file());
+
+    {
+      trace_spant span("unit test");
+    }
+
+    trace_timeline().close();
+
+    THEN("Spans are recorded")
+    {
+      const std::string contents = read_file(file());
+      REQUIRE(contents.find("\"name\": \"unit test\"") != std::string::npos);
+      REQUIRE(contents.find("\"cat\": \"phase\"") != std::string::npos);
+    }
+  }
+}
@@ -0,0 +1,163 @@
+/*******************************************************************\
+
+Module: Unit tests for xml_streamt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <iostream>
+#include <sstream>
+
+#include <util/cmdline.h>
+#include <util/ui_message.h>
+#include <util/xml_stream.h>
+
+static std::string output(const xmlt &xml)
+{
+  std::ostringstream out;
+  xml.output(out);
+  return out.str();
+}
+
+SCENARIO("xml_stream", "[core][util][xml_stream]")
+{
+  std::ostringstream out;
+
+  GIVEN("A stream without children")
+  {
+    {
+      xml_streamt xml_stream(out, "empty", {{"a", "1"}});
+    }
+
+    THEN("It is printed as an empty-element tag")
+    {
+      REQUIRE(out.str() == output(xmlt("empty", {{"a", "1"}}, {})));
+    }
+  }
+
+  GIVEN("A stream with nested children")
+  {
+    xmlt expected("root", {{"b", "<\"&>"}, {"a", "x"}}, {});
+    xmlt &child = expected.new_element("child");
+    child.data = "text & more";
+    xmlt &nested = expected.new_element("nested");
+    nested.set_attribute("n", 1u);
+    nested.new_element("leaf").new_element("inner");
+    nested.new_element("empty");
+    expected.new_element("last").data = "1 < 2";
+
+    {
+      xml_streamt xml_stream(out, "root", expected.attributes);
+      xml_stream.new_element("child").data = "text & more";
+      xml_streamt &nested_stream =
+        xml_stream.push_back_stream("nested", {{"n", "1"}});
+      xml_streamt &leaf_stream = nested_stream.push_back_stream("leaf");
+      leaf_stream.push_back(xmlt("inner"));
+      nested_stream.push_back_stream("empty");
+      xml_stream.new_element("last").data = "1 < 2";
+    }
+
+    THEN("The output is the same as that of the complete tree")
+    {
+      REQUIRE(out.str() == output(expected));
+    }
+  }
+
+  GIVEN("An indented stream that is closed explicitly")
+  {
+    xml_streamt xml_stream(out, "indented", {}, 4);
+    xml_stream.push_back(xmlt("first"));
+    xml_stream.close();
+    const std::string closed_output = out.str();
+    xml_stream.close();
+
+    THEN("It is indented as by xmlt and closing it again has no effect")
+    {
+      xmlt expected("indented");
+      expected.new_element("first");
+      std::ostringstream expected_out;
+      expected.output(expected_out, 4);
+
+      REQUIRE(closed_output == expected_out.str());
+      REQUIRE(out.str() == closed_output);
+    }
+  }
+}
+
+/// Redirect std::cout, which ui_message_handlert writes to, for its lifetime
+class redirect_coutt
+{
+public:
+  explicit redirect_coutt(std::ostream &out)
+    : cout_buffer(std::cout.rdbuf(out.rdbuf()))
+  {
+  }
+
+  ~redirect_coutt()
+  {
+    std::cout.rdbuf(cout_buffer);
+  }
+
+private:
+  std::streambuf *const cout_buffer;
+};
+
+SCENARIO(
+  "ui_message_handlert::new_xml_stream",
+  "[core][util][xml_stream][ui_message]")
+{
+  std::ostringstream out;
+  const redirect_coutt redirect_cout(out);
+
+  {
+    const char *argv[] = {"test", "--xml-ui"};
+    cmdlinet cmdline;
+    REQUIRE(!cmdline.parse(2, argv, "(xml-ui)"));
+    ui_message_handlert ui_message_handler(cmdline, "test");
+    ui_message_handler.set_verbosity(messaget::M_STATUS);
+    messaget message(ui_message_handler);
+
+    GIVEN("A message printed while a stream is open")
+    {
+      xml_streamt &xml_stream =
+        ui_message_handler.new_xml_stream(messaget::M_RESULT, "result");
+      xml_stream.push_back(xmlt("first"));
+      message.status() << "progress" << messaget::eom;
+      xml_stream.push_back(xmlt("second"));
+      ui_message_handler.close_xml_stream();
+
+      THEN("The stream stays usable and the message follows the element")
+      {
+        const std::string output = out.str();
+        const auto second = output.find("<second/>");
+        const auto closing = output.find("</result>");
+        const auto progress = output.find("progress");
+        REQUIRE(second != std::string::npos);
+        REQUIRE(closing != std::string::npos);
+        REQUIRE(progress != std::string::npos);
+        REQUIRE(second < closing);
+        REQUIRE(closing < progress);
+      }
+    }
+
+    GIVEN("A stream whose level exceeds the verbosity")
+    {
+      xml_streamt &xml_stream =
+        ui_message_handler.new_xml_stream(messaget::M_DEBUG, "debug");
+      xml_stream.push_back(xmlt("hidden"));
+      message.status() << "progress" << messaget::eom;
+      ui_message_handler.close_xml_stream();
+
+      THEN("Only the message is printed")
+      {
+        const std::string output = out.str();
+        REQUIRE(output.find("debug") == std::string::npos);
+        REQUIRE(output.find("hidden") == std::string::npos);
+        REQUIRE(output.find("progress") != std::string::npos);
+      }
+    }
+  }
+}